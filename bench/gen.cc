@@ -0,0 +1,64 @@
+// Writes a deterministic synthetic data file for benchmarks and load tests.
+//
+//   bazel run -c opt //bench:gen -- --rows=10000000 --seed=7 --out="$PWD/data/bench.csv"
+//
+// The same --rows, --seed and --first_date always produce the same bytes. Use --out=NAME.lcol
+// for the columnar format or a directory with --partitioned for YYYY/MM.csv partitions.
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_format.h"
+#include "src/columnar.h"
+#include "src/dataset.h"
+#include "src/date.h"
+#include "src/partitions.h"
+#include "src/tracker.h"
+
+ABSL_FLAG(int64_t, rows, 1000, "Number of entries to generate");
+ABSL_FLAG(uint64_t, seed, 1, "Seed; each seed names one dataset");
+ABSL_FLAG(std::string, first_date, "2000-01-01", "Date of the earliest entry (YYYY-MM-DD)");
+ABSL_FLAG(std::string, out, "", "Where to write the data (required)");
+ABSL_FLAG(bool, partitioned, false, "Write --out as a partitioned data directory");
+
+int main(int argc, char* argv[]) {
+  absl::ParseCommandLine(argc, argv);
+  const std::string out = absl::GetFlag(FLAGS_out);
+  life_tracker::DatasetOptions options;
+  options.rows = absl::GetFlag(FLAGS_rows);
+  options.seed = absl::GetFlag(FLAGS_seed);
+  options.first_day = life_tracker::ParseIsoDate(absl::GetFlag(FLAGS_first_date));
+  if (out.empty() || options.first_day == life_tracker::kInvalidDay) {
+    std::cerr << "Usage: gen --out=PATH [--rows=N] [--seed=N] [--first_date=YYYY-MM-DD] "
+                 "[--partitioned]\n";
+    return 1;
+  }
+
+  try {
+    const bool convert = absl::GetFlag(FLAGS_partitioned) || life_tracker::IsColumnarPath(out);
+    // Other formats are converted from CSV, the one format the generator writes directly.
+    const std::string csv_path = convert ? out + ".gen.csv" : out;
+    life_tracker::WriteSyntheticCsvFile(csv_path, options);
+    if (convert) {
+      {
+        life_tracker::Tracker tracker(csv_path);
+        tracker.Load();
+        if (absl::GetFlag(FLAGS_partitioned)) {
+          life_tracker::WritePartitionedData(out, tracker.Views());
+        } else {
+          life_tracker::WriteDataFile(out, tracker.Views());
+        }
+      }
+      std::filesystem::remove(csv_path);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return 2;
+  }
+  std::cout << absl::StrFormat("Wrote %d entries (seed %d) to %s\n", options.rows, options.seed,
+                               out);
+  return 0;
+}
@@ -0,0 +1,72 @@
+// Measures Tracker::Load throughput on a synthetic CSV file for increasing thread counts.
+//
+//   bazel run -c opt //bench:load_bench -- --rows=5000000
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_format.h"
+#include "src/dataset.h"
+#include "src/parallel.h"
+#include "src/tracker.h"
+
+ABSL_FLAG(int, rows, 2000000, "Number of synthetic entries to load");
+ABSL_FLAG(int, max_threads, 0, "Largest thread count to measure (0 = hardware threads)");
+ABSL_FLAG(int, repetitions, 3, "Runs per configuration; the fastest is reported");
+ABSL_FLAG(bool, mmap, true, "Memory-map the data file");
+ABSL_FLAG(bool, detach, false, "Copy strings into the tracker's arena and release the file");
+ABSL_FLAG(bool, intern_notes, false, "With --detach, store each distinct note once");
+
+namespace life_tracker {
+namespace {
+
+std::string WriteBenchData(int rows) {
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "life_tracker_load_bench.csv").string();
+  DatasetOptions options;
+  options.rows = rows;
+  options.seed = 42;
+  WriteSyntheticCsvFile(path, options);
+  return path;
+}
+
+}  // namespace
+}  // namespace life_tracker
+
+int main(int argc, char* argv[]) {
+  absl::ParseCommandLine(argc, argv);
+  const std::string path = life_tracker::WriteBenchData(absl::GetFlag(FLAGS_rows));
+  const double megabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+  const int max_threads = life_tracker::ResolveThreadCount(absl::GetFlag(FLAGS_max_threads));
+
+  std::cout << absl::StrFormat("%d rows, %.1f MiB\n", absl::GetFlag(FLAGS_rows), megabytes);
+  std::cout << "threads  seconds   MiB/s  speedup\n";
+  double baseline = 0.0;
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    life_tracker::LoadOptions options;
+    options.use_mmap = absl::GetFlag(FLAGS_mmap);
+    options.threads = threads;
+    options.detach = absl::GetFlag(FLAGS_detach);
+    options.intern_notes = absl::GetFlag(FLAGS_intern_notes);
+    double best = 1e30;
+    for (int rep = 0; rep < absl::GetFlag(FLAGS_repetitions); ++rep) {
+      life_tracker::Tracker tracker(path);
+      const auto start = std::chrono::steady_clock::now();
+      tracker.Load(options);
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      best = std::min(best, elapsed.count());
+    }
+    if (threads == 1) baseline = best;
+    std::cout << absl::StrFormat("%7d  %7.3f  %6.0f  %6.2fx\n", threads, best, megabytes / best,
+                                 baseline / best);
+    if (threads < max_threads && threads * 2 > max_threads) threads = max_threads / 2;
+  }
+
+  std::filesystem::remove(path);
+  return 0;
+}
@@ -0,0 +1,187 @@
+// Times the main stages of the `life` commands on generated datasets and writes the results as
+// JSON, one record per (benchmark, dataset size), for tracking regressions between releases.
+//
+//   bazel run -c opt //bench:suite_bench -- --rows=1000,100000,1000000 --out="$PWD/bench.json"
+//
+// Datasets come from the same generator as //bench:gen, so a --seed reproduces a run's inputs.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "src/dataset.h"
+#include "src/date.h"
+#include "src/export_writer.h"
+#include "src/report.h"
+#include "src/stats.h"
+#include "src/tracker.h"
+#include "src/trend.h"
+
+ABSL_FLAG(std::string, rows, "1000,100000,1000000", "Comma-separated dataset sizes");
+ABSL_FLAG(uint64_t, seed, 1, "Dataset seed");
+ABSL_FLAG(int, repetitions, 5, "Runs per benchmark; min and mean are reported");
+ABSL_FLAG(int, max_parse_lines, 1000000, "Records timed by the from_csv_line benchmark");
+ABSL_FLAG(int, report_days, 365, "Window of the build_report_html benchmark");
+ABSL_FLAG(std::string, out, "", "Where to write the JSON results (default: stdout)");
+
+namespace life_tracker {
+namespace {
+
+struct Result {
+  std::string benchmark;
+  int64_t rows = 0;
+  int64_t items = 0;  // Work per run: entries, records or samples processed.
+  double min_seconds = 0.0;
+  double mean_seconds = 0.0;
+};
+
+// Keeps benchmarked results observable so the compiler cannot drop the work.
+volatile int64_t sink = 0;
+
+Result Time(const std::string& benchmark, int64_t rows, int64_t items,
+            const std::function<int64_t()>& run) {
+  const int repetitions = std::max(absl::GetFlag(FLAGS_repetitions), 1);
+  Result result{benchmark, rows, items, 1e30, 0.0};
+  for (int rep = 0; rep < repetitions; ++rep) {
+    const auto start = std::chrono::steady_clock::now();
+    sink = sink + run();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.min_seconds = std::min(result.min_seconds, elapsed.count());
+    result.mean_seconds += elapsed.count() / repetitions;
+  }
+  std::cerr << absl::StrFormat("%-18s %10d rows  %9.6f s\n", benchmark, rows, result.min_seconds);
+  return result;
+}
+
+void RunDataset(int64_t rows, const std::filesystem::path& dir, std::vector<Result>* results) {
+  const std::string data_path = (dir / absl::StrFormat("data_%d.csv", rows)).string();
+  DatasetOptions dataset;
+  dataset.rows = rows;
+  dataset.seed = absl::GetFlag(FLAGS_seed);
+  WriteSyntheticCsvFile(data_path, dataset);
+
+  results->push_back(Time("load", rows, rows, [&] {
+    Tracker tracker(data_path);
+    tracker.Load();
+    return static_cast<int64_t>(tracker.Views().size());
+  }));
+
+  Tracker tracker(data_path);
+  tracker.Load();
+  const std::vector<EntryView>& views = tracker.Views();
+  if (views.empty()) return;
+  const absl::CivilDay today = CivilDayFromDayNumber(views.back().day);
+
+  std::vector<std::string> lines;
+  const int max_parse_lines = std::max(absl::GetFlag(FLAGS_max_parse_lines), 1);
+  const size_t parse_lines = std::min(views.size(), static_cast<size_t>(max_parse_lines));
+  lines.reserve(parse_lines);
+  for (size_t i = 0; i < parse_lines; ++i) lines.push_back(views[i].ToCsv());
+  results->push_back(Time("from_csv_line", rows, static_cast<int64_t>(lines.size()), [&] {
+    int64_t total = 0;
+    for (const std::string& line : lines) total += Entry::FromCsvLine(line).mood;
+    return total;
+  }));
+
+  const int all_days = views.back().day - views.front().day + 1;
+  const std::vector<DayMood> samples = CollectRecentSamples(views, all_days, today);
+  results->push_back(Time("compute_summary", rows, static_cast<int64_t>(samples.size()), [&] {
+    return ComputeSummary(samples).count;
+  }));
+  results->push_back(Time("compute_streaks", rows, rows, [&] {
+    return static_cast<int64_t>(ComputeStreaks(views, today).longest_streak);
+  }));
+
+  const absl::Span<const EntryView> by_date = tracker.Query(views.front().day, views.back().day);
+  results->push_back(Time("compute_trend", rows, rows, [&] {
+    return static_cast<int64_t>(
+        TrendEntries(by_date, views.front().day, views.back().day).points.size());
+  }));
+
+  const int report_days = std::max(absl::GetFlag(FLAGS_report_days), 1);
+  const std::vector<DayMood> recent = CollectRecentSamples(views, report_days, today);
+  const SummaryStats recent_summary = ComputeSummary(recent);
+  results->push_back(Time("build_report_html", rows, static_cast<int64_t>(recent.size()), [&] {
+    return static_cast<int64_t>(BuildReportHtml(recent, recent_summary, report_days).size());
+  }));
+
+  const std::string export_path = (dir / "export").string();
+  const std::vector<WindowSummary> summaries = {
+      {7, ComputeSummary(CollectRecentSamples(views, 7, today))}};
+  const StreakStats streak = ComputeStreaks(views, today);
+  for (const ExportFormat format : {ExportFormat::kJson, ExportFormat::kNdjson,
+                                    ExportFormat::kCsv}) {
+    results->push_back(Time(absl::StrCat(ExportFormatName(format), "_export"), rows, rows, [&] {
+      WriteExportFile(export_path, format, views, summaries, streak);
+      return static_cast<int64_t>(std::filesystem::file_size(export_path));
+    }));
+  }
+  std::filesystem::remove(export_path);
+  std::filesystem::remove(data_path);
+}
+
+void WriteResultsJson(const std::vector<Result>& results, std::ostream& out) {
+  out << "{\n  \"meta\": {\"generated_at\":\"" << JsonEscape(absl::FormatTime(absl::Now()))
+      << "\", \"seed\":" << absl::GetFlag(FLAGS_seed)
+      << ", \"repetitions\":" << absl::GetFlag(FLAGS_repetitions)
+      << ", \"hardware_threads\":" << std::thread::hardware_concurrency() << "},\n";
+  out << "  \"results\": [\n";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    out << absl::StrFormat(
+        "    {\"benchmark\":\"%s\", \"rows\":%d, \"items\":%d, \"min_seconds\":%.9f, "
+        "\"mean_seconds\":%.9f, \"items_per_second\":%.1f}%s\n",
+        JsonEscape(r.benchmark), r.rows, r.items, r.min_seconds, r.mean_seconds,
+        r.min_seconds > 0 ? r.items / r.min_seconds : 0.0, i + 1 < results.size() ? "," : "");
+  }
+  out << "  ]\n}\n";
+}
+
+}  // namespace
+}  // namespace life_tracker
+
+int main(int argc, char* argv[]) {
+  absl::ParseCommandLine(argc, argv);
+  std::vector<int64_t> sizes;
+  for (absl::string_view size : absl::StrSplit(absl::GetFlag(FLAGS_rows), ',')) {
+    int64_t rows = 0;
+    if (!absl::SimpleAtoi(size, &rows) || rows <= 0) {
+      std::cerr << "Invalid --rows entry: " << size << "\n";
+      return 1;
+    }
+    sizes.push_back(rows);
+  }
+
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path() / "life_tracker_suite_bench";
+  std::filesystem::create_directories(dir);
+  std::vector<life_tracker::Result> results;
+  for (const int64_t rows : sizes) life_tracker::RunDataset(rows, dir, &results);
+  std::filesystem::remove_all(dir);
+
+  const std::string out_path = absl::GetFlag(FLAGS_out);
+  if (out_path.empty()) {
+    life_tracker::WriteResultsJson(results, std::cout);
+  } else {
+    std::ofstream out(out_path, std::ios::trunc);
+    life_tracker::WriteResultsJson(results, out);
+    std::cerr << "Results written to " << out_path << "\n";
+  }
+  return 0;
+}
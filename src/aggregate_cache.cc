@@ -0,0 +1,271 @@
+#include "src/aggregate_cache.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "src/binary_io.h"
+#include "src/date.h"
+#include "src/day_bitmap.h"
+#include "src/trace.h"
+
+namespace life_tracker {
+namespace {
+
+constexpr std::string_view kMagic = "LTAGGREG";
+constexpr uint32_t kVersion = 2;
+
+int32_t MonthKey(absl::CivilDay day) {
+  return static_cast<int32_t>(day.year() * 12 + (day.month() - 1));
+}
+
+bool BucketKeyLess(const AggregateBucket& bucket, int32_t key) { return bucket.key < key; }
+
+// Adds `mood` to the bucket for `key`, creating it if needed. Returns true if it was created.
+bool AddToBuckets(std::vector<AggregateBucket>* buckets, int32_t key, int mood) {
+  auto it = buckets->end();
+  if (!buckets->empty() && buckets->back().key >= key) {
+    it = std::lower_bound(buckets->begin(), buckets->end(), key, BucketKeyLess);
+  }
+  const bool created = it == buckets->end() || it->key != key;
+  if (created) {
+    it = buckets->insert(it, AggregateBucket{key, MoodAggregate()});
+  }
+  it->mood.Add(mood);
+  return created;
+}
+
+bool DayMoodLess(const DayMoodCount& a, const DayMoodCount& b) {
+  return a.day != b.day ? a.day < b.day : a.mood < b.mood;
+}
+
+void AddToDayMoods(std::vector<DayMoodCount>* day_moods, int32_t day, int mood) {
+  const DayMoodCount key{day, mood, 0};
+  auto it = day_moods->end();
+  if (!day_moods->empty() && !DayMoodLess(day_moods->back(), key)) {
+    it = std::lower_bound(day_moods->begin(), day_moods->end(), key, DayMoodLess);
+  }
+  if (it == day_moods->end() || it->day != day || it->mood != mood) {
+    it = day_moods->insert(it, key);
+  }
+  ++it->count;
+}
+
+void AppendBuckets(const std::vector<AggregateBucket>& buckets, std::string* out) {
+  AppendRaw<uint64_t>(out, buckets.size());
+  for (const AggregateBucket& bucket : buckets) {
+    AppendRaw<int32_t>(out, bucket.key);
+    AppendRaw<int32_t>(out, bucket.mood.min);
+    AppendRaw<int32_t>(out, bucket.mood.max);
+    AppendRaw<int64_t>(out, bucket.mood.count);
+    AppendRaw<int64_t>(out, bucket.mood.sum);
+    AppendRaw<int64_t>(out, bucket.mood.sum_squares);
+  }
+}
+
+bool ReadBuckets(ByteReader* reader, std::vector<AggregateBucket>* buckets) {
+  constexpr size_t kBucketSize = 3 * sizeof(int32_t) + 3 * sizeof(int64_t);
+  uint64_t count = 0;
+  if (!reader->Read(&count) || count > reader->remaining() / kBucketSize) return false;
+  buckets->resize(count);
+  for (AggregateBucket& bucket : *buckets) {
+    int32_t min = 0;
+    int32_t max = 0;
+    if (!reader->Read(&bucket.key) || !reader->Read(&min) || !reader->Read(&max) ||
+        !reader->Read(&bucket.mood.count) || !reader->Read(&bucket.mood.sum) ||
+        !reader->Read(&bucket.mood.sum_squares)) {
+      return false;
+    }
+    bucket.mood.min = min;
+    bucket.mood.max = max;
+  }
+  return true;
+}
+
+void AppendDayMoods(const std::vector<DayMoodCount>& day_moods, std::string* out) {
+  AppendRaw<uint64_t>(out, day_moods.size());
+  for (const DayMoodCount& day_mood : day_moods) {
+    AppendRaw<int32_t>(out, day_mood.day);
+    AppendRaw<int32_t>(out, day_mood.mood);
+    AppendRaw<int64_t>(out, day_mood.count);
+  }
+}
+
+bool ReadDayMoods(ByteReader* reader, std::vector<DayMoodCount>* day_moods) {
+  constexpr size_t kDayMoodSize = 2 * sizeof(int32_t) + sizeof(int64_t);
+  uint64_t count = 0;
+  if (!reader->Read(&count) || count > reader->remaining() / kDayMoodSize) return false;
+  day_moods->resize(count);
+  for (DayMoodCount& day_mood : *day_moods) {
+    if (!reader->Read(&day_mood.day) || !reader->Read(&day_mood.mood) ||
+        !reader->Read(&day_mood.count)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+void MoodAggregate::Add(int mood) {
+  if (count == 0 || mood < min) min = mood;
+  if (count == 0 || mood > max) max = mood;
+  ++count;
+  sum += mood;
+  sum_squares += static_cast<int64_t>(mood) * mood;
+}
+
+std::string AggregateCache::SidecarPath(const std::string& data_path) {
+  return data_path + ".agg";
+}
+
+AggregateCache AggregateCache::Build(const std::vector<EntryView>& entries) {
+  AggregateCache cache;
+  for (const EntryView& entry : entries) {
+    if (entry.day == kInvalidDay) {
+      throw std::runtime_error("Invalid date in data: " + std::string(entry.date));
+    }
+    cache.Add(entry.day, entry.mood);
+  }
+  return cache;
+}
+
+bool AggregateCache::ReadIfFresh(const std::string& data_path, AggregateCache* cache) {
+  std::string contents;
+  std::string_view payload;
+  if (!ReadFreshSidecar(data_path, SidecarPath(data_path), kMagic, kVersion, &contents,
+                        &payload)) {
+    return false;
+  }
+  ByteReader reader(payload);
+  AggregateCache loaded;
+  if (!reader.Read(&loaded.longest_streak_) || !reader.Read(&loaded.tail_streak_) ||
+      !ReadBuckets(&reader, &loaded.days_) || !ReadBuckets(&reader, &loaded.months_) ||
+      !ReadBuckets(&reader, &loaded.years_) || !ReadDayMoods(&reader, &loaded.day_moods_)) {
+    return false;
+  }
+  *cache = std::move(loaded);
+  return true;
+}
+
+bool AggregateCache::Save(const std::string& data_path, const DataFileStamp& stamp) const {
+  std::string out;
+  AppendRaw<int32_t>(&out, longest_streak_);
+  AppendRaw<int32_t>(&out, tail_streak_);
+  AppendBuckets(days_, &out);
+  AppendBuckets(months_, &out);
+  AppendBuckets(years_, &out);
+  AppendDayMoods(day_moods_, &out);
+  return WriteSidecar(SidecarPath(data_path), stamp, kMagic, kVersion, out);
+}
+
+void MoodAggregate::Merge(const MoodAggregate& other) {
+  if (other.count == 0) return;
+  min = count == 0 ? other.min : std::min(min, other.min);
+  max = count == 0 ? other.max : std::max(max, other.max);
+  count += other.count;
+  sum += other.sum;
+  sum_squares += other.sum_squares;
+}
+
+AggregateCache AggregateCache::Between(int32_t first_day, int32_t last_day) const {
+  AggregateCache cache;
+  if (first_day > last_day) return cache;
+  const auto first = std::lower_bound(days_.begin(), days_.end(), first_day, BucketKeyLess);
+  auto last = first;
+  while (last != days_.end() && last->key <= last_day) ++last;
+  cache.days_.assign(first, last);
+  // Days come in order, so each month and year bucket is opened at the back.
+  for (const AggregateBucket& day : cache.days_) {
+    const absl::CivilDay civil = CivilDayFromDayNumber(day.key);
+    const int32_t keys[] = {MonthKey(civil), static_cast<int32_t>(civil.year())};
+    std::vector<AggregateBucket>* buckets[] = {&cache.months_, &cache.years_};
+    for (int i = 0; i < 2; ++i) {
+      if (buckets[i]->empty() || buckets[i]->back().key != keys[i]) {
+        buckets[i]->push_back(AggregateBucket{keys[i], MoodAggregate()});
+      }
+      buckets[i]->back().mood.Merge(day.mood);
+    }
+  }
+  const auto mood_first =
+      std::lower_bound(day_moods_.begin(), day_moods_.end(),
+                       DayMoodCount{first_day, std::numeric_limits<int32_t>::min()}, DayMoodLess);
+  auto mood_last = mood_first;
+  while (mood_last != day_moods_.end() && mood_last->day <= last_day) ++mood_last;
+  cache.day_moods_.assign(mood_first, mood_last);
+  if (!cache.days_.empty()) cache.RecomputeStreaks();
+  return cache;
+}
+
+void AggregateCache::Add(int32_t day, int mood) {
+  const absl::CivilDay civil = CivilDayFromDayNumber(day);
+  const bool new_day = AddToBuckets(&days_, day, mood);
+  AddToBuckets(&months_, MonthKey(civil), mood);
+  AddToBuckets(&years_, static_cast<int32_t>(civil.year()), mood);
+  AddToDayMoods(&day_moods_, day, mood);
+  if (!new_day) return;
+
+  if (days_.back().key != day) {
+    // Back-filled a gap, which may join two runs.
+    RecomputeStreaks();
+    return;
+  }
+  const bool extends_run = days_.size() > 1 && days_[days_.size() - 2].key == day - 1;
+  tail_streak_ = extends_run ? tail_streak_ + 1 : 1;
+  longest_streak_ = std::max(longest_streak_, tail_streak_);
+}
+
+void AggregateCache::RecomputeStreaks() {
+  DayBitmap days;
+  for (const AggregateBucket& bucket : days_) days.Set(bucket.key);
+  longest_streak_ = days.LongestRun();
+  tail_streak_ = days.RunEndingAt(days.last_day());
+}
+
+SummaryStats AggregateCache::Summarize(int days, absl::CivilDay today) const {
+  if (days <= 0) {
+    throw std::runtime_error("--days must be positive.");
+  }
+  const int windows[] = {days};
+  return SummarizeWindows(windows, today)[0].summary;
+}
+
+std::vector<WindowSummary> AggregateCache::SummarizeWindows(absl::Span<const int> windows,
+                                                            absl::CivilDay today) const {
+  TraceSpan span("summarize_aggregates");
+  span.Counter("windows", static_cast<int64_t>(windows.size()));
+  WindowedSummaries summaries(windows, today);
+  const int32_t first_day = summaries.first_day();
+  for (auto it = std::lower_bound(days_.begin(), days_.end(), first_day, BucketKeyLess);
+       it != days_.end(); ++it) {
+    const MoodAggregate& mood = it->mood;
+    summaries.MergeMoments(it->key, SummaryAccumulator::FromMoments(
+                                        CivilDayFromDayNumber(it->key), mood.count, mood.sum,
+                                        mood.sum_squares, mood.min, mood.max));
+  }
+  for (auto it = std::lower_bound(day_moods_.begin(), day_moods_.end(),
+                                  DayMoodCount{first_day, std::numeric_limits<int32_t>::min()},
+                                  DayMoodLess);
+       it != day_moods_.end(); ++it) {
+    summaries.AddMoods(it->day, it->mood, it->count);
+  }
+  return summaries.Results();
+}
+
+StreakStats AggregateCache::Streaks(absl::CivilDay today) const {
+  TraceSpan span("streaks_from_aggregates");
+  StreakStats streaks;
+  if (days_.empty()) return streaks;
+
+  const int32_t latest = days_.back().key;
+  const int32_t today_number = DayNumberFromCivilDay(today);
+  if (latest == today_number || latest == today_number - 1) {
+    streaks.current_streak = tail_streak_;
+  }
+  streaks.longest_streak = longest_streak_;
+  return streaks;
+}
+
+}  // namespace life_tracker
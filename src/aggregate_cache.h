@@ -0,0 +1,94 @@
+#ifndef LIFE_TRACKER_AGGREGATE_CACHE_H_
+#define LIFE_TRACKER_AGGREGATE_CACHE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/time/civil_time.h"
+#include "absl/types/span.h"
+#include "src/entry.h"
+#include "src/sidecar.h"
+#include "src/stats.h"
+
+namespace life_tracker {
+
+// Running count, sum, sum of squares, min and max of the moods in one bucket.
+struct MoodAggregate {
+  int64_t count = 0;
+  int64_t sum = 0;
+  int64_t sum_squares = 0;
+  int min = 0;
+  int max = 0;
+
+  void Add(int mood);
+  void Merge(const MoodAggregate& other);
+};
+
+// Aggregate for one calendar bucket. `key` is a day number for days, year * 12 + (month - 1) for
+// months, and the year for years.
+struct AggregateBucket {
+  int32_t key = 0;
+  MoodAggregate mood;
+};
+
+// Number of entries with one mood on one day.
+struct DayMoodCount {
+  int32_t day = 0;
+  int32_t mood = 0;
+  int64_t count = 0;
+};
+
+// Per-day, per-month and per-year mood aggregates for a data file, plus streak state and the
+// count of each mood per day, which gives summaries their distribution. Persisted in a sidecar
+// next to the data file so summary and streak queries cost O(days in range) instead of a full
+// reload and rescan.
+class AggregateCache {
+ public:
+  static std::string SidecarPath(const std::string& data_path);
+
+  // Throws std::runtime_error if an entry has a malformed date.
+  static AggregateCache Build(const std::vector<EntryView>& entries);
+
+  // Reads the sidecar of `data_path` into `*cache` if it is fresh (see ReadFreshSidecar()).
+  static bool ReadIfFresh(const std::string& data_path, AggregateCache* cache);
+  // Writes the sidecar of `data_path`, stamped with `stamp`, the version of the data file this
+  // was built from (see WriteSidecar()).
+  bool Save(const std::string& data_path, const DataFileStamp& stamp) const;
+
+  void Add(int32_t day, int mood);
+
+  // The aggregates of the entries dated from `first_day` to `last_day` inclusive, as if the cache
+  // had been built from those alone. Costs O(days in range).
+  AggregateCache Between(int32_t first_day, int32_t last_day) const;
+
+  // Same results as ComputeSummary(CollectRecentSamples(entries, days, today)).
+  SummaryStats Summarize(int days, absl::CivilDay today) const;
+  // Same results as ComputeWindowSummaries(entries, windows, today), from one pass over the
+  // buckets of the largest window.
+  std::vector<WindowSummary> SummarizeWindows(absl::Span<const int> windows,
+                                              absl::CivilDay today) const;
+  // Same results as ComputeStreaks(entries, today).
+  StreakStats Streaks(absl::CivilDay today) const;
+
+  const std::vector<AggregateBucket>& days() const { return days_; }
+  const std::vector<AggregateBucket>& months() const { return months_; }
+  const std::vector<AggregateBucket>& years() const { return years_; }
+  // Sorted by day, then mood.
+  const std::vector<DayMoodCount>& day_moods() const { return day_moods_; }
+
+ private:
+  void RecomputeStreaks();
+
+  // Sorted by key.
+  std::vector<AggregateBucket> days_;
+  std::vector<AggregateBucket> months_;
+  std::vector<AggregateBucket> years_;
+  std::vector<DayMoodCount> day_moods_;
+  int32_t longest_streak_ = 0;
+  int32_t tail_streak_ = 0;  // Length of the run of days ending at days_.back().
+};
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_AGGREGATE_CACHE_H_
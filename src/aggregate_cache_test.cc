@@ -0,0 +1,202 @@
+#include "src/aggregate_cache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/date.h"
+#include "src/test_util.h"
+#include "src/tracker.h"
+
+namespace life_tracker {
+namespace {
+
+std::vector<Entry> RandomEntries(unsigned seed, int count) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> day_offset(0, 60);
+  std::uniform_int_distribution<int> mood(1, 100);
+  std::vector<Entry> entries;
+  char date[10];
+  for (int i = 0; i < count; ++i) {
+    FormatIsoDate(ParseIsoDate("2026-01-01") + day_offset(rng), date);
+    entries.push_back(Entry{std::string(date, sizeof(date)), mood(rng), ""});
+  }
+  return entries;
+}
+
+std::vector<EntryView> ViewsOf(const std::vector<Entry>& entries) {
+  std::vector<EntryView> views;
+  for (const Entry& e : entries) views.push_back({e.date, e.mood, e.note, ParseIsoDate(e.date)});
+  return views;
+}
+
+void ExpectSameSummary(const SummaryStats& actual, const SummaryStats& expected) {
+  EXPECT_EQ(actual.has_data, expected.has_data);
+  EXPECT_EQ(actual.count, expected.count);
+  EXPECT_NEAR(actual.average_mood, expected.average_mood, 1e-9);
+  EXPECT_NEAR(actual.stddev, expected.stddev, 1e-6);
+  if (!expected.has_data) return;
+  EXPECT_EQ(actual.best.day, expected.best.day);
+  EXPECT_EQ(actual.best.mood, expected.best.mood);
+  EXPECT_EQ(actual.worst.day, expected.worst.day);
+  EXPECT_EQ(actual.worst.mood, expected.worst.mood);
+  ASSERT_TRUE(actual.has_distribution);
+  EXPECT_EQ(actual.distribution.median, expected.distribution.median);
+  EXPECT_EQ(actual.distribution.p10, expected.distribution.p10);
+  EXPECT_EQ(actual.distribution.p90, expected.distribution.p90);
+  EXPECT_EQ(actual.distribution.iqr, expected.distribution.iqr);
+  EXPECT_EQ(actual.distribution.mode, expected.distribution.mode);
+}
+
+TEST(AggregateCacheTest, MatchesFullScanStats) {
+  const std::vector<Entry> entries = RandomEntries(3, 200);
+  const AggregateCache cache = AggregateCache::Build(ViewsOf(entries));
+
+  for (const absl::CivilDay today : {absl::CivilDay(2026, 1, 20), absl::CivilDay(2026, 3, 1),
+                                     absl::CivilDay(2026, 3, 2), absl::CivilDay(2026, 6, 1)}) {
+    for (const int days : {1, 7, 30, 365}) {
+      ExpectSameSummary(cache.Summarize(days, today),
+                        ComputeSummary(CollectRecentSamples(entries, days, today)));
+    }
+    const StreakStats expected = ComputeStreaks(entries, today);
+    EXPECT_EQ(cache.Streaks(today).current_streak, expected.current_streak);
+    EXPECT_EQ(cache.Streaks(today).longest_streak, expected.longest_streak);
+  }
+}
+
+TEST(AggregateCacheTest, SummarizesSeveralWindowsInOnePass) {
+  const std::vector<Entry> entries = RandomEntries(5, 300);
+  const std::vector<EntryView> views = ViewsOf(entries);
+  const AggregateCache cache = AggregateCache::Build(views);
+  const absl::CivilDay today(2026, 2, 15);
+  const std::vector<int> windows = {7, 0, 30, 1};
+
+  const std::vector<WindowSummary> actual = cache.SummarizeWindows(windows, today);
+  const std::vector<WindowSummary> expected = ComputeWindowSummaries(views, windows, today);
+  ASSERT_EQ(actual.size(), windows.size());
+  for (size_t i = 0; i < windows.size(); ++i) {
+    EXPECT_EQ(actual[i].days, windows[i]);
+    ExpectSameSummary(actual[i].summary, expected[i].summary);
+  }
+  EXPECT_EQ(actual[1].summary.count, 300);
+}
+
+TEST(AggregateCacheTest, BackfillJoinsStreaks) {
+  AggregateCache cache;
+  cache.Add(ParseIsoDate("2026-01-01"), 50);
+  cache.Add(ParseIsoDate("2026-01-02"), 50);
+  cache.Add(ParseIsoDate("2026-01-04"), 50);
+  EXPECT_EQ(cache.Streaks(absl::CivilDay(2026, 1, 4)).current_streak, 1);
+  EXPECT_EQ(cache.Streaks(absl::CivilDay(2026, 1, 4)).longest_streak, 2);
+
+  cache.Add(ParseIsoDate("2026-01-03"), 50);
+  EXPECT_EQ(cache.Streaks(absl::CivilDay(2026, 1, 4)).current_streak, 4);
+  EXPECT_EQ(cache.Streaks(absl::CivilDay(2026, 1, 4)).longest_streak, 4);
+}
+
+TEST(AggregateCacheTest, KeepsMonthAndYearBuckets) {
+  AggregateCache cache;
+  cache.Add(ParseIsoDate("2025-12-31"), 10);
+  cache.Add(ParseIsoDate("2026-01-01"), 20);
+  cache.Add(ParseIsoDate("2026-01-15"), 40);
+
+  ASSERT_EQ(cache.months().size(), 2u);
+  EXPECT_EQ(cache.months()[1].key, 2026 * 12);
+  EXPECT_EQ(cache.months()[1].mood.count, 2);
+  EXPECT_EQ(cache.months()[1].mood.sum, 60);
+  ASSERT_EQ(cache.years().size(), 2u);
+  EXPECT_EQ(cache.years()[0].mood.max, 10);
+  EXPECT_EQ(cache.years()[1].mood.min, 20);
+}
+
+TEST(AggregateCacheTest, BetweenMatchesACacheOfTheEntriesInRange) {
+  const std::vector<Entry> entries = RandomEntries(5, 200);
+  const AggregateCache cache = AggregateCache::Build(ViewsOf(entries));
+  const int32_t from = ParseIsoDate("2026-01-20");
+  const int32_t to = ParseIsoDate("2026-02-10");
+  std::vector<Entry> in_range;
+  for (const Entry& e : entries) {
+    if (ParseIsoDate(e.date) >= from && ParseIsoDate(e.date) <= to) in_range.push_back(e);
+  }
+  const AggregateCache expected = AggregateCache::Build(ViewsOf(in_range));
+  const AggregateCache actual = cache.Between(from, to);
+
+  ASSERT_EQ(actual.days().size(), expected.days().size());
+  ASSERT_EQ(actual.months().size(), expected.months().size());
+  EXPECT_EQ(actual.months()[0].mood.sum, expected.months()[0].mood.sum);
+  EXPECT_EQ(actual.years().size(), expected.years().size());
+  EXPECT_EQ(actual.day_moods().size(), expected.day_moods().size());
+  const absl::CivilDay last = CivilDayFromDayNumber(to);
+  ExpectSameSummary(actual.Summarize(to - from + 1, last),
+                    expected.Summarize(to - from + 1, last));
+  EXPECT_EQ(actual.Streaks(last).current_streak, expected.Streaks(last).current_streak);
+  EXPECT_EQ(actual.Streaks(last).longest_streak, expected.Streaks(last).longest_streak);
+  EXPECT_TRUE(cache.Between(to, from).days().empty());
+}
+
+class AggregateSidecarTest : public TempDirTest {
+ protected:
+  void SetUp() override {
+    TempDirTest::SetUp();
+    data_path_ = (dir_ / "entries.csv").string();
+  }
+
+  std::string data_path_;
+};
+
+TEST_F(AggregateSidecarTest, SavedCacheIsFreshUntilDataChanges) {
+  {
+    std::ofstream out(data_path_);
+    out << "2026-01-01,40,a\n";
+  }
+  AggregateCache cache;
+  cache.Add(ParseIsoDate("2026-01-01"), 40);
+  ASSERT_TRUE(cache.Save(data_path_, StampDataFile(data_path_)));
+
+  AggregateCache read;
+  ASSERT_TRUE(AggregateCache::ReadIfFresh(data_path_, &read));
+  EXPECT_EQ(read.days().size(), 1u);
+
+  {
+    std::ofstream out(data_path_, std::ios::app);
+    out << "2026-01-02,60,b\n";
+  }
+  EXPECT_FALSE(AggregateCache::ReadIfFresh(data_path_, &read));
+}
+
+TEST_F(AggregateSidecarTest, TrackerRebuildsStaleCacheAndUpdatesOnAdd) {
+  {
+    std::ofstream out(data_path_);
+    out << "2026-01-01,40,a\n";
+  }
+  {
+    Tracker tracker(data_path_);
+    EXPECT_EQ(tracker.Aggregates().Summarize(7, absl::CivilDay(2026, 1, 1)).count, 1);
+  }
+  ASSERT_TRUE(std::filesystem::exists(AggregateCache::SidecarPath(data_path_)));
+
+  {
+    Tracker tracker(data_path_);
+    tracker.Add(Entry{"2026-01-02", 60, "b"});
+  }
+  AggregateCache read;
+  ASSERT_TRUE(AggregateCache::ReadIfFresh(data_path_, &read));
+  const SummaryStats summary = read.Summarize(7, absl::CivilDay(2026, 1, 2));
+  EXPECT_EQ(summary.count, 2);
+  EXPECT_NEAR(summary.average_mood, 50.0, 1e-9);
+  EXPECT_EQ(read.Streaks(absl::CivilDay(2026, 1, 2)).current_streak, 2);
+
+  // An append behind the cache's back is detected and rebuilt transparently.
+  {
+    std::ofstream out(data_path_, std::ios::app);
+    out << "2026-01-03,90,c\n";
+  }
+  Tracker tracker(data_path_);
+  EXPECT_EQ(tracker.Aggregates().Summarize(7, absl::CivilDay(2026, 1, 3)).count, 3);
+}
+
+}  // namespace
+}  // namespace life_tracker
@@ -0,0 +1,224 @@
+#include "src/append_log.h"
+
+#include <cerrno>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace life_tracker {
+namespace {
+namespace fs = std::filesystem;
+
+#if defined(_WIN32)
+int OpenForSync(const std::string& path) { return _open(path.c_str(), _O_RDWR | _O_BINARY); }
+int OpenForAppend(const std::string& path) {
+  return _open(path.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, 0644);
+}
+long WriteSome(int fd, const char* data, size_t size) {
+  return _write(fd, data, static_cast<unsigned>(size));
+}
+bool SyncFd(int fd) { return _commit(fd) == 0; }
+void CloseFd(int fd) { _close(fd); }
+bool SyncDirectoryPath(const std::string& dir) {
+  (void)dir;
+  return true;
+}
+bool LockFd(int fd, bool exclusive) {
+  (void)fd;
+  (void)exclusive;
+  return true;
+}
+void UnlockFd(int fd) { (void)fd; }
+bool IsFileAt(int fd, const std::string& path) {
+  (void)fd;
+  (void)path;
+  return true;
+}
+#else
+int OpenForSync(const std::string& path) { return open(path.c_str(), O_RDONLY | O_CLOEXEC); }
+int OpenForAppend(const std::string& path) {
+  return open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+}
+long WriteSome(int fd, const char* data, size_t size) { return write(fd, data, size); }
+bool SyncFd(int fd) {
+#if defined(__linux__)
+  return fdatasync(fd) == 0;
+#else
+  return fsync(fd) == 0;
+#endif
+}
+void CloseFd(int fd) { close(fd); }
+bool SyncDirectoryPath(const std::string& dir) {
+  const int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0) return false;
+  const bool synced = fsync(fd) == 0;
+  close(fd);
+  return synced;
+}
+bool LockFd(int fd, bool exclusive) {
+  while (flock(fd, exclusive ? LOCK_EX : LOCK_SH) != 0) {
+    if (errno != EINTR) return false;
+  }
+  return true;
+}
+void UnlockFd(int fd) { flock(fd, LOCK_UN); }
+// True if `path` still names the file open on `fd`, i.e. it was not renamed over or removed.
+bool IsFileAt(int fd, const std::string& path) {
+  struct stat open_file;
+  struct stat named_file;
+  return fstat(fd, &open_file) == 0 && stat(path.c_str(), &named_file) == 0 &&
+         open_file.st_dev == named_file.st_dev && open_file.st_ino == named_file.st_ino;
+}
+#endif
+
+}  // namespace
+
+bool SyncFile(const std::string& path) {
+  const int fd = OpenForSync(path);
+  if (fd < 0) return false;
+  const bool synced = SyncFd(fd);
+  CloseFd(fd);
+  return synced;
+}
+
+bool SyncDirectory(const std::string& dir) { return SyncDirectoryPath(dir.empty() ? "." : dir); }
+
+DataFileLock::DataFileLock(const std::string& path, bool exclusive) {
+#if defined(_WIN32)
+  // An open handle would keep the file from being renamed over.
+  (void)path;
+  (void)exclusive;
+#else
+  for (;;) {
+    fd_ = OpenForSync(path);
+    if (fd_ < 0) throw std::runtime_error("Failed to open data file: " + path);
+    if (!LockFd(fd_, exclusive)) {
+      CloseFd(fd_);
+      fd_ = -1;
+      throw std::runtime_error("Failed to lock data file: " + path);
+    }
+    if (IsFileAt(fd_, path)) return;
+    CloseFd(fd_);  // Replaced while we waited; lock the file that is there now.
+  }
+#endif
+}
+
+DataFileLock::~DataFileLock() {
+  if (fd_ >= 0) CloseFd(fd_);  // Releases the lock.
+}
+
+SyncPolicy ParseSyncPolicy(std::string_view name) {
+  if (name == "none") return SyncPolicy::kNone;
+  if (name == "batch") return SyncPolicy::kBatch;
+  if (name == "interval") return SyncPolicy::kInterval;
+  throw std::runtime_error("Unknown sync policy: " + std::string(name) +
+                           " (expected none, batch or interval)");
+}
+
+AppendLog::~AppendLog() {
+  try {
+    Close();
+  } catch (const std::exception&) {
+    // Destructors must not throw; callers that care about the final sync call Close().
+  }
+}
+
+void AppendLog::Open(const std::string& path, const AppendOptions& options) {
+  Close();
+  fs::path p(path);
+  if (p.has_parent_path()) {
+    fs::create_directories(p.parent_path());
+  }
+  fd_ = OpenForAppend(path);
+  if (fd_ < 0) {
+    throw std::runtime_error("Failed to open data file for writing: " + path);
+  }
+  path_ = path;
+  options_ = options;
+  sync_pending_ = false;
+  last_sync_ = std::chrono::steady_clock::now();
+}
+
+void AppendLog::Close() {
+  if (fd_ < 0) return;
+  const int fd = fd_;
+  const bool owes_sync = sync_pending_;
+  fd_ = -1;
+  sync_pending_ = false;
+  if (owes_sync && !SyncFd(fd)) {
+    CloseFd(fd);
+    throw std::runtime_error("Failed to sync data file: " + path_);
+  }
+  CloseFd(fd);
+}
+
+void AppendLog::Append(std::string_view bytes) {
+  // Compaction may have renamed a rewritten file over the one this descriptor is open on; the
+  // batch must go to the file that is there now.
+  for (;;) {
+    if (!LockFd(fd_, /*exclusive=*/false)) {
+      throw std::runtime_error("Failed to lock data file: " + path_);
+    }
+    if (IsFileAt(fd_, path_)) break;
+    CloseFd(fd_);
+    fd_ = OpenForAppend(path_);
+    if (fd_ < 0) throw std::runtime_error("Failed to open data file for writing: " + path_);
+  }
+  // write(2) may be partial for large batches or interrupted by a signal; finish the batch.
+  while (!bytes.empty()) {
+    const long written = WriteSome(fd_, bytes.data(), bytes.size());
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      UnlockFd(fd_);
+      throw std::runtime_error("Failed to append to data file: " + path_);
+    }
+    bytes.remove_prefix(static_cast<size_t>(written));
+  }
+  UnlockFd(fd_);
+}
+
+void AppendLog::Commit() {
+  switch (options_.sync) {
+    case SyncPolicy::kNone:
+      return;
+    case SyncPolicy::kBatch:
+      Sync();
+      return;
+    case SyncPolicy::kInterval:
+      if (SyncDue()) {
+        Sync();
+      } else {
+        sync_pending_ = true;
+      }
+      return;
+  }
+}
+
+void AppendLog::SyncIfDue() {
+  if (fd_ >= 0 && sync_pending_ && SyncDue()) Sync();
+}
+
+bool AppendLog::SyncDue() const {
+  return std::chrono::steady_clock::now() - last_sync_ >=
+         std::chrono::milliseconds(options_.sync_interval_ms);
+}
+
+void AppendLog::Sync() {
+  if (!SyncFd(fd_)) {
+    throw std::runtime_error("Failed to sync data file: " + path_);
+  }
+  sync_pending_ = false;
+  last_sync_ = std::chrono::steady_clock::now();
+}
+
+}  // namespace life_tracker
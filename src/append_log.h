@@ -0,0 +1,95 @@
+#ifndef LIFE_TRACKER_APPEND_LOG_H_
+#define LIFE_TRACKER_APPEND_LOG_H_
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace life_tracker {
+
+// When appended data is forced to stable storage.
+enum class SyncPolicy {
+  kNone,      // Leave it to the OS; a crash may lose recent appends.
+  kBatch,     // fsync on every Commit().
+  kInterval,  // fsync at most every `sync_interval_ms`: on Commit() or SyncIfDue() once the
+              // interval has passed, and on Close().
+};
+
+struct AppendOptions {
+  SyncPolicy sync = SyncPolicy::kNone;
+  int sync_interval_ms = 1000;
+};
+
+// Parses "none", "batch" or "interval"; throws std::runtime_error otherwise.
+SyncPolicy ParseSyncPolicy(std::string_view name);
+
+// Forces the contents of the file at `path` to stable storage. Returns false if it cannot be
+// opened or synced.
+bool SyncFile(const std::string& path);
+// Makes the creation, removal or renaming of entries in directory `dir` durable. Returns false
+// if it cannot be synced; always succeeds where directories cannot be synced (Windows).
+bool SyncDirectory(const std::string& dir);
+
+// Advisory lock (flock) on the file at a data path, held until destruction. Appenders hold it
+// shared while they write; compaction holds it exclusively while it checks that the file is
+// unchanged and renames the rewritten file over it, so no append lands in between or goes to the
+// replaced file. Locking waits for the lock and then checks that the path still names the locked
+// file, starting over if it was replaced meanwhile. A no-op on Windows.
+class DataFileLock {
+ public:
+  // Opens the existing file at `path` and locks it. Throws std::runtime_error on failure.
+  DataFileLock(const std::string& path, bool exclusive);
+  ~DataFileLock();
+
+  DataFileLock(const DataFileLock&) = delete;
+  DataFileLock& operator=(const DataFileLock&) = delete;
+
+ private:
+  int fd_ = -1;
+};
+
+// Append-only handle on a data file that stays open across appends. Each Append() is a single
+// write(2) to an O_APPEND descriptor, so concurrent appenders never interleave within a record
+// batch; Commit() marks the end of a batch and applies the sync policy. Append() holds the
+// file's lock shared while it writes (see DataFileLock) and reopens the path if the file was
+// replaced.
+class AppendLog {
+ public:
+  AppendLog() = default;
+  ~AppendLog();
+
+  AppendLog(const AppendLog&) = delete;
+  AppendLog& operator=(const AppendLog&) = delete;
+
+  // Opens `path` for appending, creating it and its parent directories if needed. Throws
+  // std::runtime_error on failure.
+  void Open(const std::string& path, const AppendOptions& options);
+  // Syncs anything an interval policy still owes, then closes the file. Throws
+  // std::runtime_error if that sync fails; the destructor swallows the error instead.
+  void Close();
+  bool is_open() const { return fd_ >= 0; }
+
+  void Append(std::string_view bytes);
+  // Ends a batch. The data may also have been written through another handle on the same file.
+  void Commit();
+  // Syncs batches an interval policy has held back once the interval has passed. Long-lived
+  // owners call this periodically so the last batches before a quiet spell do not wait for the
+  // next Commit() or Close().
+  void SyncIfDue();
+  // Committed batches are waiting for an interval sync.
+  bool sync_pending() const { return sync_pending_; }
+
+ private:
+  void Sync();
+  bool SyncDue() const;
+
+  int fd_ = -1;
+  std::string path_;
+  AppendOptions options_;
+  bool sync_pending_ = false;
+  std::chrono::steady_clock::time_point last_sync_;
+};
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_APPEND_LOG_H_
@@ -0,0 +1,78 @@
+#include "src/append_log.h"
+
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "src/test_util.h"
+
+namespace life_tracker {
+namespace {
+
+class AppendLogTest : public TempDirTest {
+ protected:
+  void SetUp() override {
+    TempDirTest::SetUp();
+    path_ = (dir_ / "nested" / "log.csv").string();
+  }
+
+  std::string path_;
+};
+
+TEST(ParseSyncPolicyTest, ParsesKnownNames) {
+  EXPECT_EQ(ParseSyncPolicy("none"), SyncPolicy::kNone);
+  EXPECT_EQ(ParseSyncPolicy("batch"), SyncPolicy::kBatch);
+  EXPECT_EQ(ParseSyncPolicy("interval"), SyncPolicy::kInterval);
+  EXPECT_THROW(ParseSyncPolicy("always"), std::runtime_error);
+}
+
+TEST_F(AppendLogTest, CreatesParentsAndAppendsAcrossCommits) {
+  for (SyncPolicy sync : {SyncPolicy::kNone, SyncPolicy::kBatch, SyncPolicy::kInterval}) {
+    std::filesystem::remove_all(dir_);
+    AppendLog log;
+    log.Open(path_, AppendOptions{sync, /*sync_interval_ms=*/60000});
+    log.Append("a\n");
+    log.Commit();
+    log.Append("b\nc\n");
+    log.Commit();
+    log.Close();
+    EXPECT_FALSE(log.is_open());
+    EXPECT_EQ(ReadFile(path_), "a\nb\nc\n");
+  }
+}
+
+TEST_F(AppendLogTest, SyncIfDueFlushesHeldBackBatchesAfterTheInterval) {
+  AppendLog log;
+  log.Open(path_, AppendOptions{SyncPolicy::kInterval, /*sync_interval_ms=*/50});
+  log.Append("a\n");
+  log.Commit();
+  EXPECT_TRUE(log.sync_pending());
+  log.SyncIfDue();
+  EXPECT_TRUE(log.sync_pending());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  log.SyncIfDue();
+  EXPECT_FALSE(log.sync_pending());
+  EXPECT_EQ(ReadFile(path_), "a\n");
+}
+
+TEST_F(AppendLogTest, ReopenAppendsToExistingFile) {
+  {
+    AppendLog log;
+    log.Open(path_, AppendOptions());
+    log.Append("first\n");
+  }
+  AppendLog log;
+  log.Open(path_, AppendOptions{SyncPolicy::kBatch, 0});
+  log.Append(std::string(1 << 20, 'x'));
+  log.Commit();
+  const std::string contents = ReadFile(path_);
+  EXPECT_EQ(contents.size(), 6u + (1 << 20));
+  EXPECT_EQ(contents.substr(0, 6), "first\n");
+}
+
+}  // namespace
+}  // namespace life_tracker
@@ -0,0 +1,66 @@
+#ifndef LIFE_TRACKER_BINARY_IO_H_
+#define LIFE_TRACKER_BINARY_IO_H_
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace life_tracker {
+
+// Helpers for the native binary files (columnar data, sidecar caches). Values are stored in host
+// byte order, which is little-endian on every supported platform, and read with memcpy so
+// fields need no alignment.
+
+template <typename T>
+void AppendRaw(std::string* out, T value) {
+  static_assert(std::is_trivially_copyable<T>::value, "AppendRaw needs a trivially copyable type");
+  out->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T ReadRaw(const char* p) {
+  static_assert(std::is_trivially_copyable<T>::value, "ReadRaw needs a trivially copyable type");
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  return value;
+}
+
+// Bounds-checked sequential reader over a byte buffer.
+class ByteReader {
+ public:
+  explicit ByteReader(std::string_view data) : data_(data) {}
+
+  // Reads the next value into `*value`; returns false (and leaves `*value` alone) if the buffer
+  // is exhausted.
+  template <typename T>
+  bool Read(T* value) {
+    if (data_.size() - pos_ < sizeof(T)) return false;
+    *value = ReadRaw<T>(data_.data() + pos_);
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  // Points `*bytes` at the next `size` bytes and skips them; returns false (and leaves `*bytes`
+  // alone) if fewer remain.
+  bool ReadBytes(size_t size, std::string_view* bytes) {
+    if (data_.size() - pos_ < size) return false;
+    *bytes = data_.substr(pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  // Skips `size` bytes; requires size <= remaining().
+  void Skip(size_t size) { pos_ += size; }
+
+  size_t remaining() const { return data_.size() - pos_; }
+
+ private:
+  std::string_view data_;
+  size_t pos_ = 0;
+};
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_BINARY_IO_H_
@@ -0,0 +1,212 @@
+#include "src/columnar.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "src/append_log.h"
+#include "src/binary_io.h"
+#include "src/date.h"
+
+namespace life_tracker {
+namespace {
+namespace fs = std::filesystem;
+
+constexpr char kMagic[8] = {'L', 'T', 'C', 'O', 'L', 'U', 'M', 'N'};
+constexpr size_t kHeaderSize = 32;
+constexpr size_t kBlockHeaderSize = 8;
+constexpr size_t kRowsPerBlock = 64 * 1024;
+
+struct Header {
+  uint32_t version = kColumnarVersion;
+  uint64_t row_count = 0;
+  uint64_t data_end = kHeaderSize;
+};
+
+std::string EncodeHeader(const Header& header) {
+  std::string out(kMagic, sizeof(kMagic));
+  AppendRaw<uint32_t>(&out, header.version);
+  AppendRaw<uint32_t>(&out, 0);
+  AppendRaw<uint64_t>(&out, header.row_count);
+  AppendRaw<uint64_t>(&out, header.data_end);
+  return out;
+}
+
+Header DecodeHeader(std::string_view data, uint64_t file_size) {
+  if (data.size() < kHeaderSize || !IsColumnarData(data)) {
+    throw std::runtime_error("Not a columnar data file.");
+  }
+  Header header;
+  header.version = ReadRaw<uint32_t>(data.data() + 8);
+  header.row_count = ReadRaw<uint64_t>(data.data() + 16);
+  header.data_end = ReadRaw<uint64_t>(data.data() + 24);
+  if (header.version != kColumnarVersion) {
+    throw std::runtime_error("Unsupported columnar data version: " +
+                             std::to_string(header.version));
+  }
+  if (header.data_end < kHeaderSize || header.data_end > file_size) {
+    throw std::runtime_error("Corrupt columnar data: bad data_end.");
+  }
+  return header;
+}
+
+int32_t ToDayNumber(const EntryView& entry) {
+  const int32_t day = entry.day != kInvalidDay ? entry.day : ParseIsoDate(entry.date);
+  if (day == kInvalidDay) {
+    throw std::runtime_error("Invalid date in data: " + std::string(entry.date));
+  }
+  return day;
+}
+
+void EncodeBlock(const EntryView* entries, size_t count, std::string* out) {
+  const size_t start = out->size();
+  size_t notes_size = 0;
+  for (size_t i = 0; i < count; ++i) notes_size += entries[i].note.size();
+  if (notes_size > UINT32_MAX) throw std::runtime_error("Columnar block notes too large.");
+
+  AppendRaw<uint32_t>(out, static_cast<uint32_t>(count));
+  AppendRaw<uint32_t>(out, static_cast<uint32_t>(notes_size));
+  for (size_t i = 0; i < count; ++i) AppendRaw<int32_t>(out, ToDayNumber(entries[i]));
+  for (size_t i = 0; i < count; ++i) {
+    if (entries[i].mood < 0 || entries[i].mood > UINT8_MAX) {
+      throw std::runtime_error("Mood out of range for columnar data: " +
+                               std::to_string(entries[i].mood));
+    }
+    out->push_back(static_cast<char>(entries[i].mood));
+  }
+  uint32_t offset = 0;
+  for (size_t i = 0; i < count; ++i) {
+    AppendRaw<uint32_t>(out, offset);
+    offset += static_cast<uint32_t>(entries[i].note.size());
+  }
+  AppendRaw<uint32_t>(out, offset);
+  for (size_t i = 0; i < count; ++i) out->append(entries[i].note);
+  out->resize(start + (out->size() - start + 7) / 8 * 8, '\0');
+}
+
+void CreateParentDirectories(const std::string& path) {
+  fs::path p(path);
+  if (p.has_parent_path()) fs::create_directories(p.parent_path());
+}
+
+}  // namespace
+
+bool IsColumnarData(std::string_view data) {
+  return data.size() >= sizeof(kMagic) && std::memcmp(data.data(), kMagic, sizeof(kMagic)) == 0;
+}
+
+bool IsColumnarPath(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) return fs::path(path).extension() == kColumnarExtension;
+  char magic[sizeof(kMagic)] = {};
+  in.read(magic, sizeof(magic));
+  return IsColumnarData(std::string_view(magic, static_cast<size_t>(in.gcount())));
+}
+
+int32_t ColumnarBlock::Day(size_t i) const { return ReadRaw<int32_t>(days + i * sizeof(int32_t)); }
+
+std::string_view ColumnarBlock::Note(size_t i) const {
+  const uint32_t begin = ReadRaw<uint32_t>(note_offsets + i * sizeof(uint32_t));
+  const uint32_t end = ReadRaw<uint32_t>(note_offsets + (i + 1) * sizeof(uint32_t));
+  if (begin > end || end > notes.size()) {
+    throw std::runtime_error("Corrupt columnar data: bad note offsets.");
+  }
+  return notes.substr(begin, end - begin);
+}
+
+std::vector<ColumnarBlock> ReadColumnarBlocks(std::string_view data) {
+  const Header header = DecodeHeader(data, data.size());
+
+  std::vector<ColumnarBlock> blocks;
+  uint64_t rows = 0;
+  size_t pos = kHeaderSize;
+  while (pos < header.data_end) {
+    if (header.data_end - pos < kBlockHeaderSize) {
+      throw std::runtime_error("Corrupt columnar data: truncated block header.");
+    }
+    ColumnarBlock block;
+    block.row_count = ReadRaw<uint32_t>(data.data() + pos);
+    const uint32_t notes_size = ReadRaw<uint32_t>(data.data() + pos + 4);
+    const uint64_t body_size = uint64_t{block.row_count} * (sizeof(int32_t) + 1) +
+                               (uint64_t{block.row_count} + 1) * sizeof(uint32_t) + notes_size;
+    if (body_size > header.data_end - pos - kBlockHeaderSize) {
+      throw std::runtime_error("Corrupt columnar data: truncated block.");
+    }
+    const char* p = data.data() + pos + kBlockHeaderSize;
+    block.days = p;
+    p += block.row_count * sizeof(int32_t);
+    block.moods = reinterpret_cast<const uint8_t*>(p);
+    p += block.row_count;
+    block.note_offsets = p;
+    p += (block.row_count + 1) * sizeof(uint32_t);
+    block.notes = std::string_view(p, notes_size);
+
+    rows += block.row_count;
+    pos += (kBlockHeaderSize + body_size + 7) / 8 * 8;
+    blocks.push_back(block);
+  }
+  if (rows != header.row_count) {
+    throw std::runtime_error("Corrupt columnar data: row count mismatch.");
+  }
+  return blocks;
+}
+
+uint64_t WriteColumnarFile(const std::string& path, const std::vector<EntryView>& entries) {
+  std::string body;
+  for (size_t i = 0; i < entries.size(); i += kRowsPerBlock) {
+    EncodeBlock(entries.data() + i, std::min(kRowsPerBlock, entries.size() - i), &body);
+  }
+  Header header;
+  header.row_count = entries.size();
+  header.data_end = kHeaderSize + body.size();
+
+  CreateParentDirectories(path);
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error("Failed to open data file for writing: " + path);
+  }
+  out << EncodeHeader(header) << body;
+  if (!out) throw std::runtime_error("Failed to write data file: " + path);
+  return header.data_end;
+}
+
+uint64_t AppendColumnarBlock(const std::string& path, const std::vector<EntryView>& entries,
+                             const AppendOptions& options) {
+  if (!fs::exists(path)) return WriteColumnarFile(path, entries);
+
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open data file for writing: " + path);
+  }
+  std::string header_bytes(kHeaderSize, '\0');
+  file.read(header_bytes.data(), kHeaderSize);
+  header_bytes.resize(static_cast<size_t>(file.gcount()));
+  const uint64_t old_size = fs::file_size(path);
+  Header header = DecodeHeader(header_bytes, old_size);
+
+  std::string block;
+  EncodeBlock(entries.data(), entries.size(), &block);
+  file.seekp(static_cast<std::streamoff>(header.data_end));
+  file.write(block.data(), static_cast<std::streamsize>(block.size()));
+  file.flush();
+  // When appends are meant to be durable, the header must not reach the disk before the block it
+  // points past.
+  if (!file || (options.sync != SyncPolicy::kNone && !SyncFile(path))) {
+    throw std::runtime_error("Failed to append to data file: " + path);
+  }
+
+  header.row_count += entries.size();
+  header.data_end += block.size();
+  const std::string updated = EncodeHeader(header);
+  file.seekp(0);
+  file.write(updated.data(), static_cast<std::streamsize>(updated.size()));
+  if (!file) throw std::runtime_error("Failed to append to data file: " + path);
+  // The block overwrites whatever a torn append left past the old data_end.
+  return header.data_end > old_size ? header.data_end - old_size : 0;
+}
+
+}  // namespace life_tracker
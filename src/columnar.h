@@ -0,0 +1,73 @@
+#ifndef LIFE_TRACKER_COLUMNAR_H_
+#define LIFE_TRACKER_COLUMNAR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "src/append_log.h"
+#include "src/entry.h"
+
+namespace life_tracker {
+
+// Native binary storage for entries, laid out column by column so that date/mood scans never
+// touch note bytes. Integers are in host byte order (see binary_io.h).
+//
+//   Header (32 bytes):
+//     char     magic[8]    "LTCOLUMN"
+//     uint32   version     kColumnarVersion
+//     uint32   reserved    0
+//     uint64   row_count   rows in all committed blocks
+//     uint64   data_end    file offset just past the last committed block
+//   Blocks, each padded to a multiple of 8 bytes:
+//     uint32   row_count
+//     uint32   notes_size
+//     int32    days[row_count]              days since 1970-01-01
+//     uint8    moods[row_count]
+//     uint32   note_offsets[row_count + 1]  into notes
+//     char     notes[notes_size]
+//
+// Appends write a new block past data_end, sync it, and only then bump the header, so a torn
+// append is ignored by readers and overwritten by the next append.
+
+inline constexpr char kColumnarExtension[] = ".lcol";
+inline constexpr uint32_t kColumnarVersion = 1;
+
+// Returns true if `data` starts with the columnar magic bytes.
+bool IsColumnarData(std::string_view data);
+
+// True if `path` holds columnar data, or does not exist yet but has the columnar extension.
+bool IsColumnarPath(const std::string& path);
+
+// One block of a columnar file. Column pointers reference the file bytes and may be unaligned.
+struct ColumnarBlock {
+  uint32_t row_count = 0;
+  const char* days = nullptr;
+  const uint8_t* moods = nullptr;
+  const char* note_offsets = nullptr;
+  std::string_view notes;
+
+  int32_t Day(size_t i) const;
+  // Throws std::runtime_error if the offsets are corrupt.
+  std::string_view Note(size_t i) const;
+};
+
+// Validates the header and block framing of `data` and returns its committed blocks. Throws
+// std::runtime_error on malformed input or an unsupported version.
+std::vector<ColumnarBlock> ReadColumnarBlocks(std::string_view data);
+
+// Writes `entries` to `path` as a fresh columnar file, replacing any existing file. Returns the
+// size of the file written.
+uint64_t WriteColumnarFile(const std::string& path, const std::vector<EntryView>& entries);
+
+// Appends `entries` to `path` as one block, creating the file if needed. Returns how many bytes
+// the file grew by. Unless `options.sync` is kNone, the block is synced before the header that
+// commits it is rewritten; with kNone a crash may leave a header pointing past a lost block.
+uint64_t AppendColumnarBlock(const std::string& path, const std::vector<EntryView>& entries,
+                             const AppendOptions& options = AppendOptions());
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_COLUMNAR_H_
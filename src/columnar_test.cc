@@ -0,0 +1,128 @@
+#include "src/columnar.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/test_util.h"
+#include "src/tracker.h"
+
+namespace life_tracker {
+namespace {
+
+class ColumnarTest : public TempDirTest {
+ protected:
+  void SetUp() override {
+    TempDirTest::SetUp();
+    path_ = (dir_ / "entries.lcol").string();
+  }
+
+  std::string path_;
+};
+
+TEST_F(ColumnarTest, WriteThenReadRoundTrips) {
+  const std::vector<EntryView> entries = {
+      {"2026-01-01", 40, "plain"},
+      {"2026-01-02", 100, "with, \"quotes\"\nand newline"},
+      {"1999-12-31", 1, ""},
+  };
+  WriteColumnarFile(path_, entries);
+
+  const std::string data = ReadFile(path_);
+  ASSERT_TRUE(IsColumnarData(data));
+  const std::vector<ColumnarBlock> blocks = ReadColumnarBlocks(data);
+  ASSERT_EQ(blocks.size(), 1u);
+  ASSERT_EQ(blocks[0].row_count, 3u);
+  EXPECT_EQ(blocks[0].Day(0), 20454);
+  EXPECT_EQ(blocks[0].Day(2), 10956);
+  EXPECT_EQ(blocks[0].moods[1], 100);
+  EXPECT_EQ(blocks[0].Note(1), entries[1].note);
+  EXPECT_EQ(blocks[0].Note(2), "");
+}
+
+TEST_F(ColumnarTest, AppendAddsBlocksAndTrackerLoadsThem) {
+  Tracker tracker(path_);
+  tracker.Add(Entry{"2026-01-01", 40, "first"});
+  tracker.Add(Entry{"2026-01-02", 60, "second"});
+
+  EXPECT_EQ(ReadColumnarBlocks(ReadFile(path_)).size(), 2u);
+
+  Tracker reloaded(path_);
+  reloaded.Load();
+  const auto& views = reloaded.Views();
+  ASSERT_EQ(views.size(), 2u);
+  EXPECT_EQ(views[0].date, "2026-01-01");
+  EXPECT_EQ(views[1].date, "2026-01-02");
+  EXPECT_EQ(views[1].mood, 60);
+  EXPECT_EQ(views[1].note, "second");
+}
+
+TEST_F(ColumnarTest, LoadWithoutNotesSkipsNoteColumn) {
+  WriteColumnarFile(path_, {{"2026-01-01", 40, "note"}});
+
+  LoadOptions options;
+  options.use_mmap = true;
+  options.load_notes = false;
+  Tracker tracker(path_);
+  tracker.Load(options);
+  ASSERT_EQ(tracker.Views().size(), 1u);
+  EXPECT_EQ(tracker.Views()[0].mood, 40);
+  EXPECT_TRUE(tracker.Views()[0].note.empty());
+}
+
+TEST_F(ColumnarTest, ConvertsToCsvAndBack) {
+  WriteColumnarFile(path_, {{"2026-01-01", 40, "a,b"}, {"2026-01-02", 50, "c"}});
+  Tracker columnar(path_);
+  columnar.Load();
+
+  const std::string csv_path = (dir_ / "entries.csv").string();
+  WriteDataFile(csv_path, columnar.Views());
+  Tracker csv(csv_path);
+  csv.Load();
+  ASSERT_EQ(csv.Entries().size(), 2u);
+  EXPECT_EQ(csv.Entries()[0].note, "a,b");
+  EXPECT_EQ(csv.Entries()[1].date, "2026-01-02");
+}
+
+TEST_F(ColumnarTest, TailLoadWalksBackAcrossBlocks) {
+  WriteColumnarFile(path_, {{"2026-01-01", 10, "a"}, {"2026-01-02", 20, "b"}});
+  AppendColumnarBlock(path_, {{"2026-01-03", 30, "c"}});
+
+  LoadOptions options;
+  options.since_day = ParseIsoDate("2026-01-02");
+  Tracker tracker(path_);
+  tracker.Load(options);
+  ASSERT_EQ(tracker.Views().size(), 2u);
+  EXPECT_EQ(tracker.Views()[0].date, "2026-01-02");
+  EXPECT_EQ(tracker.Views()[1].note, "c");
+
+  options.since_day = kInvalidDay;
+  options.limit = 1;
+  tracker.Load(options);
+  ASSERT_EQ(tracker.Views().size(), 1u);
+  EXPECT_EQ(tracker.Views()[0].date, "2026-01-03");
+}
+
+TEST_F(ColumnarTest, RejectsUnsupportedVersion) {
+  WriteColumnarFile(path_, {{"2026-01-01", 40, "note"}});
+  std::string data = ReadFile(path_);
+  data[8] = 99;
+  EXPECT_THROW(ReadColumnarBlocks(data), std::runtime_error);
+}
+
+TEST_F(ColumnarTest, IgnoresTornAppend) {
+  WriteColumnarFile(path_, {{"2026-01-01", 40, "note"}});
+  {
+    std::ofstream out(path_, std::ios::binary | std::ios::app);
+    out << "partial block bytes";
+  }
+  const std::vector<ColumnarBlock> blocks = ReadColumnarBlocks(ReadFile(path_));
+  ASSERT_EQ(blocks.size(), 1u);
+  EXPECT_EQ(blocks[0].row_count, 1u);
+}
+
+}  // namespace
+}  // namespace life_tracker
@@ -0,0 +1,133 @@
+#include "src/command_output.h"
+
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/time.h"
+
+namespace life_tracker {
+
+void PrintAdded(const Entry& entry, std::ostream& out) {
+  out << "Added: " << entry.date << " mood=" << entry.mood << " note=\"" << entry.note << "\"\n";
+}
+
+void PrintAddedCount(size_t count, std::ostream& out) {
+  out << "Added " << count << " entr" << (count == 1 ? "y" : "ies") << ".\n";
+}
+
+void PrintEntryList(absl::Span<const EntryView> entries, std::ostream& out) {
+  if (entries.empty()) {
+    out << "No entries yet.\n";
+    return;
+  }
+
+  // Newest last in file; print newest-first.
+  for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+    out << it->date << "  mood=" << it->mood << "  " << it->note << "\n";
+  }
+}
+
+void PrintSearchResults(const std::vector<Entry>& matches, std::ostream& out) {
+  if (matches.empty()) {
+    out << "No matching entries.\n";
+    return;
+  }
+  for (const Entry& entry : matches) {
+    out << entry.date << "  mood=" << entry.mood << "  " << entry.note << "\n";
+  }
+}
+
+void PrintSummary(const SummaryStats& summary, int days, std::ostream& out) {
+  if (!summary.has_data) {
+    if (days == 0) {
+      out << "No entries yet.\n";
+      return;
+    }
+    out << "No entries in the last " << days << " day";
+    if (days != 1) out << "s";
+    out << ".\n";
+    return;
+  }
+
+  out << "Entries: " << summary.count << "\n";
+  out << "Average mood: " << absl::StrFormat("%.1f", summary.average_mood) << "\n";
+  out << "Best day: " << absl::FormatCivilTime(summary.best.day) << " (" << summary.best.mood
+      << ")\n";
+  out << "Worst day: " << absl::FormatCivilTime(summary.worst.day) << " (" << summary.worst.mood
+      << ")\n";
+  out << "Mood volatility (std dev): " << absl::StrFormat("%.1f", summary.stddev) << "\n";
+  if (!summary.has_distribution) return;
+  const MoodDistribution& distribution = summary.distribution;
+  out << "Median mood: " << absl::StrFormat("%.1f", distribution.median) << "\n";
+  out << absl::StrFormat("Percentiles: p10=%d p25=%d p75=%d p90=%d (IQR %d)\n", distribution.p10,
+                         distribution.p25, distribution.p75, distribution.p90, distribution.iqr);
+  out << "Most common mood: " << distribution.mode << "\n";
+}
+
+void PrintWindowSummaries(absl::Span<const WindowSummary> summaries, std::ostream& out) {
+  if (summaries.size() == 1) {
+    PrintSummary(summaries[0].summary, summaries[0].days, out);
+    return;
+  }
+  out << absl::StrFormat("%-10s %8s %8s %8s %8s %4s %4s\n", "Window", "Entries", "Average",
+                         "Std dev", "Median", "Min", "Max");
+  for (const WindowSummary& window : summaries) {
+    const std::string label = window.days == 0
+                                  ? "all time"
+                                  : absl::StrCat(window.days, window.days == 1 ? " day" : " days");
+    const SummaryStats& summary = window.summary;
+    if (!summary.has_data) {
+      out << absl::StrFormat("%-10s %8d %8s %8s %8s %4s %4s\n", label, 0, "-", "-", "-", "-", "-");
+      continue;
+    }
+    const std::string median =
+        summary.has_distribution ? absl::StrFormat("%.1f", summary.distribution.median) : "-";
+    out << absl::StrFormat("%-10s %8d %8.1f %8.1f %8s %4d %4d\n", label, summary.count,
+                           summary.average_mood, summary.stddev, median, summary.worst.mood,
+                           summary.best.mood);
+  }
+}
+
+void PrintStreaks(const StreakStats& streaks, std::ostream& out) {
+  out << "Current streak: " << streaks.current_streak << " day";
+  if (streaks.current_streak != 1) out << "s";
+  out << "\n";
+  out << "Longest streak: " << streaks.longest_streak << " day";
+  if (streaks.longest_streak != 1) out << "s";
+  out << "\n";
+}
+
+void PrintRollup(const Rollup& rollup, std::ostream& out) {
+  if (rollup.buckets.empty()) {
+    out << "No entries to roll up.\n";
+    return;
+  }
+  std::string header = RollupPeriodName(rollup.period);
+  header[0] = static_cast<char>(header[0] - 'a' + 'A');
+  out << absl::StrFormat("%-10s %8s %8s %8s %4s %4s  %s\n", header, "Entries", "Average",
+                         "Std dev", "Min", "Max", "Days logged");
+  for (const RollupBucket& bucket : rollup.buckets) {
+    const SummaryStats& summary = bucket.summary;
+    out << absl::StrFormat("%-10s %8d %8.1f %8.1f %4d %4d  %d/%d\n",
+                           RollupBucketLabel(rollup.period, bucket), summary.count,
+                           summary.average_mood, summary.stddev, summary.worst.mood,
+                           summary.best.mood, bucket.days_with_entries, bucket.days_in_range);
+  }
+}
+
+void PrintDashboardWritten(const DashboardWriteStats& stats, std::ostream& out) {
+  out << "Wrote " << stats.written << " of " << stats.shards << " monthly shard"
+      << (stats.shards == 1 ? "" : "s");
+  if (stats.removed > 0) out << " (removed " << stats.removed << " stale)";
+  out << ".\n";
+}
+
+void PrintCompacted(const CompactionStats& stats, MergePolicy policy, std::ostream& out) {
+  out << "Compacted " << stats.entries_before << " entr"
+      << (stats.entries_before == 1 ? "y" : "ies") << " (" << stats.out_of_order
+      << " out of date order) into " << stats.entries_after << " with --merge="
+      << MergePolicyName(policy) << ".\n";
+}
+
+}  // namespace life_tracker
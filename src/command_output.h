@@ -0,0 +1,38 @@
+#ifndef LIFE_TRACKER_COMMAND_OUTPUT_H_
+#define LIFE_TRACKER_COMMAND_OUTPUT_H_
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "src/compaction.h"
+#include "src/dashboard_data.h"
+#include "src/entry.h"
+#include "src/rollup.h"
+#include "src/stats.h"
+
+namespace life_tracker {
+
+// Text the `life` commands print. Shared by the CLI and `life serve` so forwarded commands print
+// exactly what local ones do.
+
+void PrintAdded(const Entry& entry, std::ostream& out);
+void PrintAddedCount(size_t count, std::ostream& out);
+// Prints `entries` (oldest first) newest first.
+void PrintEntryList(absl::Span<const EntryView> entries, std::ostream& out);
+// Prints search matches in the order given, or a line saying there are none.
+void PrintSearchResults(const std::vector<Entry>& matches, std::ostream& out);
+// Prints the summary of the last `days` days (0 = all time).
+void PrintSummary(const SummaryStats& summary, int days, std::ostream& out);
+// Prints a lone window as PrintSummary() does, and several as one aligned row each.
+void PrintWindowSummaries(absl::Span<const WindowSummary> summaries, std::ostream& out);
+void PrintStreaks(const StreakStats& streaks, std::ostream& out);
+// Prints one aligned row per bucket, oldest first.
+void PrintRollup(const Rollup& rollup, std::ostream& out);
+void PrintDashboardWritten(const DashboardWriteStats& stats, std::ostream& out);
+void PrintCompacted(const CompactionStats& stats, MergePolicy policy, std::ostream& out);
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_COMMAND_OUTPUT_H_
@@ -0,0 +1,157 @@
+#include "src/compaction.h"
+
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "src/binary_io.h"
+#include "src/date.h"
+#include "src/sidecar.h"
+#include "src/trace.h"
+
+namespace life_tracker {
+namespace {
+
+constexpr std::string_view kMagic = "LTORDER1";
+constexpr uint32_t kVersion = 1;
+
+// Appends `day`, the entries of one date, to `*out` as `policy` asks.
+void CompactDay(absl::Span<const EntryView> day, MergePolicy policy, StringArena* arena,
+                std::vector<EntryView>* out) {
+  switch (policy) {
+    case MergePolicy::kKeep:
+      out->insert(out->end(), day.begin(), day.end());
+      return;
+    case MergePolicy::kDedupe: {
+      std::set<std::pair<int, std::string_view>> seen;
+      for (const EntryView& entry : day) {
+        if (seen.emplace(entry.mood, entry.note).second) out->push_back(entry);
+      }
+      return;
+    }
+    case MergePolicy::kFirst:
+      out->push_back(day.front());
+      return;
+    case MergePolicy::kLast:
+      out->push_back(day.back());
+      return;
+    case MergePolicy::kMean: {
+      int64_t sum = 0;
+      std::string notes;
+      for (const EntryView& entry : day) {
+        sum += entry.mood;
+        if (entry.note.empty()) continue;
+        if (!notes.empty()) notes += "; ";
+        notes += entry.note;
+      }
+      EntryView merged = day.front();
+      const int64_t count = static_cast<int64_t>(day.size());
+      // Rounds halves up; moods are positive.
+      merged.mood = static_cast<int>((2 * sum + count) / (2 * count));
+      merged.note = arena->Store(notes);
+      out->push_back(merged);
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+MergePolicy ParseMergePolicy(std::string_view name) {
+  if (name == "keep") return MergePolicy::kKeep;
+  if (name == "dedupe") return MergePolicy::kDedupe;
+  if (name == "first") return MergePolicy::kFirst;
+  if (name == "last") return MergePolicy::kLast;
+  if (name == "mean") return MergePolicy::kMean;
+  throw std::runtime_error("Unsupported merge policy: " + std::string(name) +
+                           " (expected keep, dedupe, first, last or mean)");
+}
+
+const char* MergePolicyName(MergePolicy policy) {
+  switch (policy) {
+    case MergePolicy::kKeep:
+      return "keep";
+    case MergePolicy::kDedupe:
+      return "dedupe";
+    case MergePolicy::kFirst:
+      return "first";
+    case MergePolicy::kLast:
+      return "last";
+    case MergePolicy::kMean:
+      return "mean";
+  }
+  return "keep";
+}
+
+std::vector<EntryView> CompactEntries(absl::Span<const EntryView> entries, MergePolicy policy,
+                                      StringArena* arena) {
+  TraceSpan span("compact_entries");
+  std::vector<EntryView> out;
+  out.reserve(entries.size());
+  size_t first = 0;
+  while (first < entries.size()) {
+    const int32_t day = entries[first].day;
+    if (day == kInvalidDay) {
+      throw std::runtime_error("Invalid date in data: " + std::string(entries[first].date));
+    }
+    size_t last = first + 1;
+    while (last < entries.size() && entries[last].day == day) ++last;
+    if (last < entries.size() && entries[last].day < day) {
+      throw std::runtime_error("Compaction input is not in date order.");
+    }
+    CompactDay(entries.subspan(first, last - first), policy, arena, &out);
+    first = last;
+  }
+  span.Counter("entries_in", static_cast<int64_t>(entries.size()));
+  span.Counter("entries_out", static_cast<int64_t>(out.size()));
+  return out;
+}
+
+std::string DataOrder::SidecarPath(const std::string& data_path) { return data_path + ".order"; }
+
+bool DataOrder::ReadIfFresh(const std::string& data_path, DataOrder* order) {
+  std::string contents;
+  std::string_view payload;
+  if (!ReadFreshSidecar(data_path, SidecarPath(data_path), kMagic, kVersion, &contents,
+                        &payload)) {
+    return false;
+  }
+  ByteReader reader(payload);
+  uint8_t has_entries = 0;
+  DataOrder loaded;
+  if (!reader.Read(&has_entries) || !reader.Read(&loaded.last_day_) ||
+      !reader.Read(&loaded.out_of_order_) || reader.remaining() != 0) {
+    return false;
+  }
+  loaded.has_entries_ = has_entries != 0;
+  *order = loaded;
+  return true;
+}
+
+bool DataOrder::Save(const std::string& data_path, const DataFileStamp& stamp) const {
+  std::string out;
+  AppendRaw<uint8_t>(&out, has_entries_ ? 1 : 0);
+  AppendRaw<int32_t>(&out, last_day_);
+  AppendRaw<uint64_t>(&out, out_of_order_);
+  return WriteSidecar(SidecarPath(data_path), stamp, kMagic, kVersion, out);
+}
+
+DataOrder DataOrder::Build(absl::Span<const EntryView> entries) {
+  DataOrder order;
+  for (const EntryView& entry : entries) order.Add(entry.day);
+  return order;
+}
+
+void DataOrder::Add(int32_t day) {
+  if (has_entries_ && day < last_day_) {
+    ++out_of_order_;
+    return;
+  }
+  has_entries_ = true;
+  last_day_ = day;
+}
+
+}  // namespace life_tracker
@@ -0,0 +1,74 @@
+#ifndef LIFE_TRACKER_COMPACTION_H_
+#define LIFE_TRACKER_COMPACTION_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "src/entry.h"
+#include "src/sidecar.h"
+#include "src/string_arena.h"
+
+namespace life_tracker {
+
+// What compaction does with the entries of one day.
+enum class MergePolicy {
+  kKeep,    // Keep every entry.
+  kDedupe,  // Drop entries whose mood and note repeat an earlier entry of the day.
+  kFirst,   // Keep the day's first entry in file order.
+  kLast,    // Keep the day's last entry in file order.
+  kMean,    // One entry: the rounded mean mood and the day's non-empty notes joined by "; ".
+};
+
+// Parses "keep", "dedupe", "first", "last" or "mean". Throws std::runtime_error for anything
+// else.
+MergePolicy ParseMergePolicy(std::string_view name);
+// The name ParseMergePolicy() accepts for `policy`.
+const char* MergePolicyName(MergePolicy policy);
+
+// Applies `policy` to `entries`, which must be in date order (as Tracker::Query() returns them).
+// Returns views into `entries` and, for merged notes, into `*arena`. Throws std::runtime_error if
+// an entry has a malformed date or the entries are out of order.
+std::vector<EntryView> CompactEntries(absl::Span<const EntryView> entries, MergePolicy policy,
+                                      StringArena* arena);
+
+// Whether a data file is in date order, persisted in a sidecar next to it. Appending a
+// back-dated entry makes the file unsorted; `life compact` sorts it again. Commands read the
+// sidecar to take the tail-loading paths that --assume_sorted enables by hand.
+class DataOrder {
+ public:
+  static std::string SidecarPath(const std::string& data_path);
+
+  // Reads the sidecar of `data_path` into `*order` if it is fresh (see ReadFreshSidecar()).
+  static bool ReadIfFresh(const std::string& data_path, DataOrder* order);
+  // Writes the sidecar of `data_path`, stamped with `stamp`, the version of the data file this
+  // was built from (see WriteSidecar()).
+  bool Save(const std::string& data_path, const DataFileStamp& stamp) const;
+
+  // The order of `entries`, given in file order.
+  static DataOrder Build(absl::Span<const EntryView> entries);
+
+  // Records the next entry in file order.
+  void Add(int32_t day);
+
+  bool sorted() const { return out_of_order_ == 0; }
+  // Entries dated before an entry that precedes them in the file.
+  uint64_t out_of_order() const { return out_of_order_; }
+
+ private:
+  bool has_entries_ = false;
+  int32_t last_day_ = 0;  // Latest day in the file so far.
+  uint64_t out_of_order_ = 0;
+};
+
+struct CompactionStats {
+  uint64_t entries_before = 0;
+  uint64_t entries_after = 0;
+  uint64_t out_of_order = 0;  // Out-of-order entries the file held before compaction.
+};
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_COMPACTION_H_
@@ -0,0 +1,191 @@
+#include "src/compaction.h"
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/aggregate_cache.h"
+#include "src/date.h"
+#include "src/note_index.h"
+#include "src/tracker.h"
+
+namespace life_tracker {
+namespace {
+
+EntryView View(std::string_view date, int mood, std::string_view note) {
+  return EntryView{date, mood, note, ParseIsoDate(date)};
+}
+
+// "date mood note" for each entry, for compact comparisons.
+std::vector<std::string> Describe(const std::vector<EntryView>& entries) {
+  std::vector<std::string> out;
+  for (const EntryView& entry : entries) {
+    out.push_back(std::string(entry.date) + " " + std::to_string(entry.mood) + " " +
+                  std::string(entry.note));
+  }
+  return out;
+}
+
+std::vector<std::string> Compact(const std::vector<EntryView>& entries, MergePolicy policy) {
+  StringArena arena;
+  return Describe(CompactEntries(entries, policy, &arena));
+}
+
+TEST(MergePolicyTest, ParsesKnownNames) {
+  for (const MergePolicy policy : {MergePolicy::kKeep, MergePolicy::kDedupe, MergePolicy::kFirst,
+                                   MergePolicy::kLast, MergePolicy::kMean}) {
+    EXPECT_EQ(ParseMergePolicy(MergePolicyName(policy)), policy);
+  }
+  EXPECT_THROW(ParseMergePolicy("sum"), std::runtime_error);
+}
+
+TEST(CompactEntriesTest, AppliesThePolicyToEachDay) {
+  const std::vector<EntryView> entries = {
+      View("2026-01-01", 10, "gym"), View("2026-01-01", 10, "gym"), View("2026-01-01", 21, ""),
+      View("2026-01-01", 10, "run"), View("2026-01-03", 50, "solo")};
+  EXPECT_EQ(Compact(entries, MergePolicy::kKeep).size(), entries.size());
+  EXPECT_EQ(Compact(entries, MergePolicy::kDedupe),
+            (std::vector<std::string>{"2026-01-01 10 gym", "2026-01-01 21 ",
+                                      "2026-01-01 10 run", "2026-01-03 50 solo"}));
+  EXPECT_EQ(Compact(entries, MergePolicy::kFirst),
+            (std::vector<std::string>{"2026-01-01 10 gym", "2026-01-03 50 solo"}));
+  EXPECT_EQ(Compact(entries, MergePolicy::kLast),
+            (std::vector<std::string>{"2026-01-01 10 run", "2026-01-03 50 solo"}));
+  // (10 + 10 + 21 + 10) / 4 = 12.75.
+  EXPECT_EQ(Compact(entries, MergePolicy::kMean),
+            (std::vector<std::string>{"2026-01-01 13 gym; gym; run", "2026-01-03 50 solo"}));
+  EXPECT_TRUE(Compact({}, MergePolicy::kMean).empty());
+}
+
+TEST(CompactEntriesTest, RejectsUnsortedEntries) {
+  StringArena arena;
+  EXPECT_THROW(CompactEntries({View("2026-01-02", 10, ""), View("2026-01-01", 20, "")},
+                              MergePolicy::kKeep, &arena),
+               std::runtime_error);
+}
+
+TEST(DataOrderTest, CountsEntriesBeforeTheLatestDay) {
+  DataOrder order = DataOrder::Build(
+      {View("2026-01-01", 1, ""), View("2026-01-03", 1, ""), View("2026-01-03", 1, "")});
+  EXPECT_TRUE(order.sorted());
+  order.Add(ParseIsoDate("2026-01-02"));
+  order.Add(ParseIsoDate("2026-01-01"));
+  order.Add(ParseIsoDate("2026-01-04"));
+  EXPECT_FALSE(order.sorted());
+  EXPECT_EQ(order.out_of_order(), 2u);
+}
+
+class CompactionTest : public ::testing::TestWithParam<const char*> {
+ protected:
+  void SetUp() override {
+    dir_ = std::filesystem::path(::testing::TempDir()) /
+           ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+    data_path_ = (dir_ / (std::string("entries") + GetParam())).string();
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir_); }
+
+  void AddAll(const std::vector<EntryView>& entries) {
+    Tracker tracker(data_path_);
+    std::vector<Entry> batch;
+    for (const EntryView& entry : entries) batch.push_back(entry.ToEntry());
+    tracker.AddBatch(batch);
+  }
+
+  std::vector<std::string> LoadAll() {
+    Tracker tracker(data_path_);
+    tracker.Load();
+    return Describe(tracker.Views());
+  }
+
+  std::filesystem::path dir_;
+  std::string data_path_;
+};
+
+TEST_P(CompactionTest, RewritesTheFileInDateOrder) {
+  AddAll({View("2026-01-03", 30, "c"), View("2026-01-01", 10, "a, \"quoted\""),
+          View("2026-01-03", 30, "c"), View("2026-01-02", 20, "")});
+  {
+    Tracker tracker(data_path_);
+    EXPECT_EQ(tracker.Order().out_of_order(), 2u);
+    tracker.Notes();  // Leaves an index sidecar behind for compaction to drop.
+
+    const CompactionStats stats = tracker.Compact(MergePolicy::kDedupe);
+    EXPECT_EQ(stats.entries_before, 4u);
+    EXPECT_EQ(stats.entries_after, 3u);
+    EXPECT_EQ(stats.out_of_order, 2u);
+    // The tracker reloads the compacted file.
+    EXPECT_EQ(tracker.Views().size(), 3u);
+  }
+  EXPECT_EQ(LoadAll(), (std::vector<std::string>{"2026-01-01 10 a, \"quoted\"", "2026-01-02 20 ",
+                                                 "2026-01-03 30 c"}));
+  EXPECT_FALSE(std::filesystem::exists(NoteIndex::SidecarPath(data_path_)));
+  AggregateCache aggregates;
+  ASSERT_TRUE(AggregateCache::ReadIfFresh(data_path_, &aggregates));
+  EXPECT_EQ(aggregates.days().size(), 3u);
+  DataOrder order;
+  ASSERT_TRUE(DataOrder::ReadIfFresh(data_path_, &order));
+  EXPECT_TRUE(order.sorted());
+  for (const auto& file : std::filesystem::directory_iterator(dir_)) {
+    EXPECT_EQ(file.path().string().find(".compact"), std::string::npos) << file.path();
+  }
+
+  // Appends keep the fresh sidecar current.
+  AddAll({View("2026-01-04", 40, "")});
+  ASSERT_TRUE(DataOrder::ReadIfFresh(data_path_, &order));
+  EXPECT_TRUE(order.sorted());
+  AddAll({View("2026-01-02", 25, "late")});
+  ASSERT_TRUE(DataOrder::ReadIfFresh(data_path_, &order));
+  EXPECT_EQ(order.out_of_order(), 1u);
+}
+
+TEST_P(CompactionTest, CompactsOnceTheThresholdIsReached) {
+  AddAll({View("2026-01-05", 50, ""), View("2026-01-01", 10, "")});
+  Tracker tracker(data_path_);
+  EXPECT_FALSE(tracker.CompactIfOutOfOrder(0, MergePolicy::kKeep));
+  EXPECT_FALSE(tracker.CompactIfOutOfOrder(2, MergePolicy::kKeep));
+  tracker.Add({"2026-01-02", 20, ""});
+  const std::optional<CompactionStats> stats = tracker.CompactIfOutOfOrder(2, MergePolicy::kKeep);
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->entries_after, 3u);
+  EXPECT_EQ(LoadAll(), (std::vector<std::string>{"2026-01-01 10 ", "2026-01-02 20 ",
+                                                 "2026-01-05 50 "}));
+  // Appends after compaction go to the new file.
+  tracker.Add({"2026-01-06", 60, ""});
+  EXPECT_EQ(LoadAll().size(), 4u);
+  EXPECT_TRUE(tracker.Order().sorted());
+}
+
+TEST_P(CompactionTest, AppendersOpenedBeforeCompactionWriteToTheNewFile) {
+  AddAll({View("2026-01-03", 30, ""), View("2026-01-01", 10, "")});
+  Tracker appender(data_path_);
+  appender.Add({"2026-01-04", 40, ""});  // Opens its log on the file about to be replaced.
+  {
+    Tracker compactor(data_path_);
+    compactor.Compact(MergePolicy::kKeep);
+  }
+  appender.Add({"2026-01-05", 50, ""});
+  EXPECT_EQ(LoadAll(), (std::vector<std::string>{"2026-01-01 10 ", "2026-01-03 30 ",
+                                                 "2026-01-04 40 ", "2026-01-05 50 "}));
+}
+
+INSTANTIATE_TEST_SUITE_P(Formats, CompactionTest, ::testing::Values(".csv", ".lcol"));
+
+TEST(CompactionPartitionTest, RejectsPartitionedData) {
+  const std::string dir = (std::filesystem::path(::testing::TempDir()) / "compact_parts").string();
+  std::filesystem::remove_all(dir);
+  WritePartitionedData(dir, {View("2026-01-01", 10, "")});
+  Tracker tracker(dir);
+  EXPECT_THROW(tracker.Compact(MergePolicy::kKeep), std::runtime_error);
+  EXPECT_FALSE(tracker.CompactIfOutOfOrder(1, MergePolicy::kKeep));
+  std::filesystem::remove_all(dir);
+}
+
+}  // namespace
+}  // namespace life_tracker
@@ -0,0 +1,218 @@
+#include "src/csv_scanner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace life_tracker {
+namespace {
+
+// Blocks start small so that parsing a single line stays cheap, then grow to amortize the
+// per-block overhead on whole files.
+constexpr size_t kMinBlockSize = 256;
+constexpr size_t kMaxBlockSize = 64 * 1024;
+constexpr int kFieldCount = 3;  // date, mood, note
+
+bool IsStructural(char c) { return c == ',' || c == '"' || c == '\n'; }
+
+template <typename Mask>
+void AppendMaskOffsets(Mask mask, size_t base, std::vector<size_t>* index) {
+  while (mask != 0) {
+    index->push_back(base + static_cast<size_t>(__builtin_ctz(mask)));
+    mask &= mask - 1;
+  }
+}
+
+void UnescapeQuotes(std::string_view field, std::string* out) {
+  out->clear();
+  out->reserve(field.size());
+  for (size_t i = 0; i < field.size(); ++i) {
+    out->push_back(field[i]);
+    if (field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"') ++i;
+  }
+}
+
+}  // namespace
+
+void AppendStructuralIndexScalar(std::string_view data, size_t begin, size_t end,
+                                 std::vector<size_t>* index) {
+  for (size_t i = begin; i < end; ++i) {
+    if (IsStructural(data[i])) index->push_back(i);
+  }
+}
+
+void AppendStructuralIndex(std::string_view data, size_t begin, size_t end,
+                           std::vector<size_t>* index) {
+  const char* bytes = data.data();
+  size_t i = begin;
+#if defined(__AVX2__)
+  const __m256i comma32 = _mm256_set1_epi8(',');
+  const __m256i quote32 = _mm256_set1_epi8('"');
+  const __m256i newline32 = _mm256_set1_epi8('\n');
+  for (; i + 32 <= end; i += 32) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+    const __m256i hits = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, comma32), _mm256_cmpeq_epi8(chunk, quote32)),
+        _mm256_cmpeq_epi8(chunk, newline32));
+    AppendMaskOffsets(static_cast<uint32_t>(_mm256_movemask_epi8(hits)), i, index);
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i comma16 = _mm_set1_epi8(',');
+  const __m128i quote16 = _mm_set1_epi8('"');
+  const __m128i newline16 = _mm_set1_epi8('\n');
+  for (; i + 16 <= end; i += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+    const __m128i hits =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, comma16), _mm_cmpeq_epi8(chunk, quote16)),
+                     _mm_cmpeq_epi8(chunk, newline16));
+    AppendMaskOffsets(static_cast<uint32_t>(_mm_movemask_epi8(hits)), i, index);
+  }
+#endif
+  AppendStructuralIndexScalar(data, i, end, index);
+}
+
+size_t CountQuotes(std::string_view data) {
+  return static_cast<size_t>(std::count(data.begin(), data.end(), '"'));
+}
+
+size_t FindRecordStart(std::string_view data, size_t from, bool in_quotes) {
+  if (from == 0) return 0;
+  if (from <= data.size() && data[from - 1] == '\n' && !in_quotes) return from;
+  for (size_t i = from; i < data.size(); ++i) {
+    if (data[i] == '"') {
+      in_quotes = !in_quotes;
+    } else if (data[i] == '\n' && !in_quotes) {
+      return i + 1;
+    }
+  }
+  return data.size();
+}
+
+CsvScanner::CsvScanner(std::string_view data) : data_(data), block_size_(kMinBlockSize) {}
+
+size_t CsvScanner::NextStructural(size_t from) {
+  while (true) {
+    while (cursor_ < index_.size() && index_[cursor_] < from) ++cursor_;
+    if (cursor_ < index_.size()) return index_[cursor_];
+    if (indexed_end_ >= data_.size()) return data_.size();
+
+    // Everything indexed so far is behind us; index the next block that reaches past `from`.
+    index_.clear();
+    cursor_ = 0;
+    if (indexed_end_ < from) indexed_end_ = from;
+    const size_t block_end = std::min(data_.size(), indexed_end_ + block_size_);
+    AppendStructuralIndex(data_, indexed_end_, block_end, &index_);
+    indexed_end_ = block_end;
+    block_size_ = std::min(block_size_ * 2, kMaxBlockSize);
+  }
+}
+
+std::string_view CsvScanner::ReadField(size_t* i, bool* escaped) {
+  *escaped = false;
+
+  if (*i < data_.size() && data_[*i] == '"') {
+    const size_t start = ++(*i);
+    size_t close = NextStructural(start);
+    while (close < data_.size()) {
+      if (data_[close] == '"') {
+        if (close + 1 < data_.size() && data_[close + 1] == '"') {
+          *escaped = true;
+          close = NextStructural(close + 2);
+          continue;
+        }
+        break;
+      }
+      close = NextStructural(close + 1);  // ',' or '\n' inside the quotes.
+    }
+    const std::string_view field = data_.substr(start, close - start);
+    *i = close < data_.size() ? close + 1 : close;
+    // Anything between the closing quote and the next delimiter is ignored.
+    while (*i < data_.size()) {
+      *i = NextStructural(*i);
+      if (*i == data_.size() || data_[*i] != '"') break;
+      ++(*i);
+    }
+    return field;
+  }
+
+  const size_t start = *i;
+  *i = NextStructural(start);
+  while (*i < data_.size() && data_[*i] == '"') *i = NextStructural(*i + 1);
+  std::string_view field = data_.substr(start, *i - start);
+  if ((*i == data_.size() || data_[*i] == '\n') && !field.empty() && field.back() == '\r') {
+    field.remove_suffix(1);
+  }
+  return field;
+}
+
+bool CsvScanner::Next(EntryView* view, std::string* unescaped_note) {
+  while (pos_ < data_.size() && (data_[pos_] == '\n' || data_[pos_] == '\r')) ++pos_;
+  if (pos_ >= data_.size()) return false;
+
+  size_t i = pos_;
+  std::string_view fields[kFieldCount];
+  bool escaped[kFieldCount] = {};
+  for (int f = 0; f < kFieldCount; ++f) {
+    if (f > 0) {
+      if (i >= data_.size() || data_[i] != ',') break;
+      ++i;
+    }
+    fields[f] = ReadField(&i, &escaped[f]);
+  }
+  bool ignored_escape = false;
+  while (i < data_.size() && data_[i] == ',') {
+    ++i;
+    ReadField(&i, &ignored_escape);
+  }
+  if (i < data_.size()) ++i;  // '\n'
+  pos_ = i;
+
+  view->date = fields[0];
+  view->day = ParseIsoDate(view->date);
+  if (!absl::SimpleAtoi(absl::string_view(fields[1].data(), fields[1].size()), &view->mood)) {
+    throw std::runtime_error("Invalid mood in CSV: " + std::string(fields[1]));
+  }
+  if (escaped[2]) {
+    UnescapeQuotes(fields[2], unescaped_note);
+    view->note = *unescaped_note;
+  } else {
+    view->note = fields[2];
+  }
+  return true;
+}
+
+ReverseCsvScanner::ReverseCsvScanner(std::string_view data) : data_(data), end_(data.size()) {}
+
+bool ReverseCsvScanner::Prev(EntryView* view, std::string* unescaped_note) {
+  while (end_ > 0 && (data_[end_ - 1] == '\n' || data_[end_ - 1] == '\r')) --end_;
+  if (end_ == 0) return false;
+
+  // Walk back line by line. An odd-quote line closes a multi-line note; keep going until the
+  // matching odd-quote line that opened it.
+  size_t line_end = end_;
+  size_t start = 0;
+  bool in_quotes = false;
+  while (true) {
+    const size_t newline = line_end == 0 ? std::string_view::npos : data_.rfind('\n', line_end - 1);
+    start = newline == std::string_view::npos ? 0 : newline + 1;
+    if (CountQuotes(data_.substr(start, line_end - start)) % 2 == 1) in_quotes = !in_quotes;
+    if (!in_quotes || start == 0) break;
+    line_end = start - 1;  // The '\n' that ended the line before.
+  }
+
+  CsvScanner scanner(data_.substr(start, end_ - start));
+  end_ = start;
+  return scanner.Next(view, unescaped_note);
+}
+
+}  // namespace life_tracker
@@ -0,0 +1,80 @@
+#ifndef LIFE_TRACKER_CSV_SCANNER_H_
+#define LIFE_TRACKER_CSV_SCANNER_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "src/entry.h"
+
+namespace life_tracker {
+
+// Appends the offsets of every '"', ',' and '\n' byte in data[begin, end) to `*index`, in
+// increasing order. Uses AVX2 or SSE2 when the build targets them and a scalar loop otherwise.
+void AppendStructuralIndex(std::string_view data, size_t begin, size_t end,
+                           std::vector<size_t>* index);
+
+// Portable reference implementation of AppendStructuralIndex.
+void AppendStructuralIndexScalar(std::string_view data, size_t begin, size_t end,
+                                 std::vector<size_t>* index);
+
+// Number of '"' bytes in `data`.
+size_t CountQuotes(std::string_view data);
+
+// Returns the offset of the first record starting at or after `from`, or data.size() if there is
+// none. `in_quotes` says whether data[0, from) holds an odd number of quotes, i.e. whether `from`
+// lies inside a quoted field. This relies on quotes appearing only in quoted fields, never bare in
+// unquoted ones, which holds for everything Entry::ToCsv() writes.
+size_t FindRecordStart(std::string_view data, size_t from, bool in_quotes);
+
+// Parses a CSV buffer record by record. Instead of inspecting every byte, the scanner indexes
+// structural characters a block at a time and jumps between them, so plain note text is skipped
+// at vector speed. Backs ParseCsvRecord() and Tracker::Load().
+class CsvScanner {
+ public:
+  explicit CsvScanner(std::string_view data);
+
+  // Same contract as ParseCsvRecord(): fields point into the buffer unless the note needed
+  // unescaping, in which case it is written to `*unescaped_note`.
+  bool Next(EntryView* view, std::string* unescaped_note);
+
+  // Offset of the first byte not yet consumed.
+  size_t position() const { return pos_; }
+
+ private:
+  // Returns the offset of the first structural character at or after `from`, or data_.size().
+  size_t NextStructural(size_t from);
+  std::string_view ReadField(size_t* i, bool* escaped);
+
+  std::string_view data_;
+  size_t pos_ = 0;
+  size_t indexed_end_ = 0;  // data_[0, indexed_end_) has been indexed.
+  size_t block_size_;
+  std::vector<size_t> index_;
+  size_t cursor_ = 0;  // First entry of index_ not yet passed.
+};
+
+// Parses a CSV buffer backwards, from the last record to the first, touching only the bytes of
+// the records it returns. Quoted notes that span lines are reassembled by quote parity: inside a
+// quoted field quotes come in "" pairs, so a line with an odd number of quotes opens or closes a
+// multi-line field. Like FindRecordStart(), this relies on quotes never appearing bare in unquoted
+// fields.
+class ReverseCsvScanner {
+ public:
+  explicit ReverseCsvScanner(std::string_view data);
+
+  // Same contract as CsvScanner::Next(), but yields the record before the previous one returned.
+  bool Prev(EntryView* view, std::string* unescaped_note);
+
+  // Offset in the buffer of the record last returned by Prev().
+  size_t offset() const { return end_; }
+
+ private:
+  std::string_view data_;
+  size_t end_;  // Records at or after this offset have been returned.
+};
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_CSV_SCANNER_H_
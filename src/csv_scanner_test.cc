@@ -0,0 +1,180 @@
+#include "src/csv_scanner.h"
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace life_tracker {
+namespace {
+
+// The byte-at-a-time parser CsvScanner replaced, kept as the reference for one-line records.
+std::string ReferenceReadField(const std::string& line, size_t* i) {
+  std::string out;
+  if (*i >= line.size()) return out;
+
+  if (line[*i] == '"') {
+    ++(*i);
+    while (*i < line.size()) {
+      if (line[*i] == '"') {
+        if (*i + 1 < line.size() && line[*i + 1] == '"') {
+          out.push_back('"');
+          *i += 2;
+        } else {
+          ++(*i);
+          break;
+        }
+      } else {
+        out.push_back(line[*i]);
+        ++(*i);
+      }
+    }
+    if (*i < line.size() && line[*i] == ',') ++(*i);
+    return out;
+  }
+
+  while (*i < line.size() && line[*i] != ',') {
+    out.push_back(line[*i]);
+    ++(*i);
+  }
+  if (*i < line.size() && line[*i] == ',') ++(*i);
+  return out;
+}
+
+Entry ReferenceParseLine(std::string line) {
+  if (!line.empty() && line.back() == '\r') line.pop_back();
+  size_t i = 0;
+  Entry e;
+  e.date = ReferenceReadField(line, &i);
+  e.mood = std::stoi(ReferenceReadField(line, &i));
+  e.note = ReferenceReadField(line, &i);
+  return e;
+}
+
+std::string RandomNote(std::mt19937* rng, bool allow_newlines) {
+  static constexpr char kAlphabet[] = "abc xyz,\"\r\n";
+  const size_t alphabet_size = allow_newlines ? sizeof(kAlphabet) - 1 : sizeof(kAlphabet) - 3;
+  std::uniform_int_distribution<size_t> length(0, 80);
+  std::uniform_int_distribution<size_t> pick(0, alphabet_size - 1);
+  std::string note(length(*rng), ' ');
+  for (char& c : note) c = kAlphabet[pick(*rng)];
+  return note;
+}
+
+std::vector<Entry> RandomEntries(std::mt19937* rng, size_t count, bool allow_newlines) {
+  std::uniform_int_distribution<int> mood(1, 100);
+  std::vector<Entry> entries;
+  for (size_t i = 0; i < count; ++i) {
+    Entry e;
+    e.date = "2026-01-" + std::to_string(10 + i % 20);
+    e.mood = mood(*rng);
+    e.note = RandomNote(rng, allow_newlines);
+    entries.push_back(e);
+  }
+  return entries;
+}
+
+std::vector<Entry> ScanAll(const std::string& data) {
+  CsvScanner scanner(data);
+  std::vector<Entry> out;
+  EntryView view;
+  std::string unescaped;
+  while (scanner.Next(&view, &unescaped)) out.push_back(view.ToEntry());
+  return out;
+}
+
+TEST(StructuralIndexTest, MatchesScalarAtEveryAlignment) {
+  std::mt19937 rng(7);
+  std::string data = RandomNote(&rng, true);
+  while (data.size() < 300) data += RandomNote(&rng, true);
+
+  for (size_t begin = 0; begin < 40; ++begin) {
+    for (size_t end = begin; end <= data.size(); end += 13) {
+      std::vector<size_t> simd;
+      std::vector<size_t> scalar;
+      AppendStructuralIndex(data, begin, end, &simd);
+      AppendStructuralIndexScalar(data, begin, end, &scalar);
+      ASSERT_EQ(simd, scalar) << "begin=" << begin << " end=" << end;
+    }
+  }
+}
+
+TEST(CsvScannerTest, MatchesReferenceParserLineByLine) {
+  std::mt19937 rng(11);
+  const std::vector<Entry> entries = RandomEntries(&rng, 2000, /*allow_newlines=*/false);
+
+  std::string data;
+  std::vector<std::string> lines;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    lines.push_back(entries[i].ToCsv() + (i % 3 == 0 ? "\r" : ""));
+    data += lines.back() + "\n";
+  }
+
+  const std::vector<Entry> scanned = ScanAll(data);
+  ASSERT_EQ(scanned.size(), lines.size());
+  for (size_t i = 0; i < lines.size(); ++i) {
+    const Entry expected = ReferenceParseLine(lines[i]);
+    EXPECT_EQ(scanned[i].date, expected.date) << i;
+    EXPECT_EQ(scanned[i].mood, expected.mood) << i;
+    EXPECT_EQ(scanned[i].note, expected.note) << i;
+  }
+}
+
+TEST(CsvScannerTest, RoundTripsEscapedNotesAcrossBlocks) {
+  std::mt19937 rng(13);
+  const std::vector<Entry> entries = RandomEntries(&rng, 5000, /*allow_newlines=*/true);
+
+  std::string data;
+  for (const Entry& e : entries) data += e.ToCsv() + "\n";
+  ASSERT_GT(data.size(), 64u * 1024u);
+
+  const std::vector<Entry> scanned = ScanAll(data);
+  ASSERT_EQ(scanned.size(), entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    EXPECT_EQ(scanned[i].date, entries[i].date) << i;
+    EXPECT_EQ(scanned[i].mood, entries[i].mood) << i;
+    EXPECT_EQ(scanned[i].note, entries[i].note) << i;
+  }
+}
+
+TEST(CsvScannerTest, HandlesMissingTrailingNewlineAndUnterminatedQuote) {
+  EXPECT_EQ(ScanAll("2026-01-01,5,last").back().note, "last");
+  EXPECT_EQ(ScanAll("2026-01-01,5,\"open, never closed").back().note, "open, never closed");
+}
+
+TEST(ReverseCsvScannerTest, YieldsForwardRecordsInReverse) {
+  std::mt19937 rng(17);
+  const std::vector<Entry> entries = RandomEntries(&rng, 3000, /*allow_newlines=*/true);
+  std::string data = "\n";
+  for (const Entry& e : entries) data += e.ToCsv() + "\r\n\n";
+
+  ReverseCsvScanner scanner(data);
+  EntryView view;
+  std::string unescaped;
+  for (size_t i = entries.size(); i-- > 0;) {
+    ASSERT_TRUE(scanner.Prev(&view, &unescaped)) << i;
+    EXPECT_EQ(view.date, entries[i].date) << i;
+    EXPECT_EQ(view.mood, entries[i].mood) << i;
+    EXPECT_EQ(view.note, entries[i].note) << i;
+  }
+  EXPECT_FALSE(scanner.Prev(&view, &unescaped));
+}
+
+TEST(FindRecordStartTest, SkipsNewlinesInsideQuotes) {
+  const std::string data = "2026-01-01,1,\"a\nb\"\n2026-01-02,2,c\n";
+  const size_t second = data.find("2026-01-02");
+  EXPECT_EQ(FindRecordStart(data, 0, false), 0u);
+  EXPECT_EQ(FindRecordStart(data, 5, false), second);
+  EXPECT_EQ(FindRecordStart(data, data.find('b'), true), second);
+  EXPECT_EQ(FindRecordStart(data, second, false), second);
+  EXPECT_EQ(FindRecordStart(data, second + 1, false), data.size());
+}
+
+TEST(CsvScannerTest, RejectsNonNumericMood) {
+  EXPECT_THROW(ScanAll("2026-01-01,great,note\n"), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace life_tracker
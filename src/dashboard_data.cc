@@ -0,0 +1,134 @@
+#include "src/dashboard_data.h"
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "src/date.h"
+#include "src/export_writer.h"
+#include "src/trace.h"
+
+namespace life_tracker {
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr char kShardDir[] = "shards";
+
+void WriteFileAtomically(const fs::path& path, std::string_view contents) {
+  const fs::path tmp_path = fs::path(path.string() + ".tmp");
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      throw std::runtime_error("Failed to open file for writing: " + tmp_path.string());
+    }
+    out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    if (!out) throw std::runtime_error("Failed to write " + tmp_path.string());
+  }
+  std::error_code ec;
+  fs::rename(tmp_path, path, ec);
+  if (ec) throw std::runtime_error("Failed to replace " + path.string() + ": " + ec.message());
+}
+
+}  // namespace
+
+uint64_t Fnv1a64(std::string_view data) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (const char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+DashboardWriteStats WriteDashboardData(const std::string& dir,
+                                       absl::Span<const EntryView> entries,
+                                       absl::Span<const WindowSummary> summaries,
+                                       const StreakStats& streak, const Trend& trend) {
+  TraceSpan span("write_dashboard");
+  const fs::path root(dir);
+  const fs::path shard_dir = root / kShardDir;
+  fs::create_directories(shard_dir);
+
+  DashboardWriteStats stats;
+  std::set<std::string> listed;
+  std::string manifest = "{\n";
+  AppendJsonStatsMembers(&manifest, summaries, streak);
+  manifest += "  \"shards\": [";
+
+  std::string shard;  // Reused for every month.
+  size_t point = 0;   // First trend point not yet written.
+  char point_date[10];
+  for (size_t begin = 0; begin < entries.size();) {
+    const std::string_view month = entries[begin].date.substr(0, 7);
+    size_t end = begin;
+    shard.clear();
+    absl::StrAppend(&shard, "{\"month\":\"");
+    AppendJsonEscaped(&shard, month);
+    shard += "\",\"entries\":[";
+    for (; end < entries.size() && entries[end].date.substr(0, 7) == month; ++end) {
+      shard += end > begin ? ",\n" : "\n";
+      AppendJsonEntry(&shard, entries[end]);
+    }
+    shard += "\n],\"trend\":[";
+    for (size_t first = point; point < trend.points.size(); ++point) {
+      FormatIsoDate(trend.points[point].day, point_date);
+      const std::string_view point_month(point_date, 7);
+      if (point_month > month) break;
+      if (point_month < month) {
+        first = point + 1;
+        continue;
+      }
+      shard += point > first ? ",\n" : "\n";
+      AppendJsonTrendPoint(&shard, trend.points[point]);
+    }
+    shard += "\n]}\n";
+
+    const uint64_t checksum = Fnv1a64(shard);
+    const std::string name =
+        absl::StrCat(std::string(month), ".", absl::Hex(checksum, absl::kZeroPad16), ".json");
+    const fs::path path = shard_dir / name;
+    std::error_code ec;
+    if (!fs::exists(path, ec) || fs::file_size(path, ec) != shard.size()) {
+      WriteFileAtomically(path, shard);
+      ++stats.written;
+      stats.bytes_written += shard.size();
+    }
+    listed.insert(name);
+
+    manifest += stats.shards > 0 ? ",\n    " : "\n    ";
+    manifest += "{\"month\":\"";
+    AppendJsonEscaped(&manifest, month);
+    manifest += "\",\"path\":\"";
+    AppendJsonEscaped(&manifest, absl::StrCat(kShardDir, "/", name));
+    absl::StrAppend(&manifest, "\",\"count\":", end - begin, ",\"first\":\"");
+    AppendJsonEscaped(&manifest, entries[begin].date);
+    manifest += "\",\"last\":\"";
+    AppendJsonEscaped(&manifest, entries[end - 1].date);
+    absl::StrAppend(&manifest, "\",\"bytes\":", shard.size(), ",\"checksum\":\"",
+                    absl::Hex(checksum, absl::kZeroPad16), "\"}");
+    ++stats.shards;
+    begin = end;
+  }
+  manifest += stats.shards > 0 ? "\n  ]\n}\n" : "  ]\n}\n";
+  WriteFileAtomically(root / "manifest.json", manifest);
+  stats.bytes_written += manifest.size();
+
+  for (const fs::directory_entry& file : fs::directory_iterator(shard_dir)) {
+    const std::string name = file.path().filename().string();
+    if (file.is_regular_file() && listed.count(name) == 0) {
+      std::error_code ec;
+      if (fs::remove(file.path(), ec)) ++stats.removed;
+    }
+  }
+
+  span.Counter("shards", static_cast<int64_t>(stats.shards));
+  span.Counter("written", static_cast<int64_t>(stats.written));
+  span.Counter("bytes", static_cast<int64_t>(stats.bytes_written));
+  return stats;
+}
+
+}  // namespace life_tracker
@@ -0,0 +1,49 @@
+#ifndef LIFE_TRACKER_DASHBOARD_DATA_H_
+#define LIFE_TRACKER_DASHBOARD_DATA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "absl/types/span.h"
+#include "src/entry.h"
+#include "src/stats.h"
+#include "src/trend.h"
+
+namespace life_tracker {
+
+// `life dashboard` writes the web page's data as a directory the page fetches from lazily:
+//   manifest.json                     the JSON export's meta, summary, windows and streak
+//                                     members (see AppendJsonStatsMembers()), plus
+//                                     "shards": one {"month","path","count","first","last",
+//                                     "bytes","checksum"} record per month, oldest first
+//   shards/YYYY-MM.<checksum>.json    {"month","entries","trend"} with that month's entries in
+//                                     date order and its days' moving averages (see
+//                                     AppendJsonTrendPoint())
+// A shard's file name carries the checksum of its contents, so a month whose entries and moving
+// averages did not change keeps its file and is not rewritten, and browsers may cache shards
+// forever.
+
+struct DashboardWriteStats {
+  size_t shards = 0;     // Months in the manifest.
+  size_t written = 0;    // Shard files that did not exist yet.
+  size_t removed = 0;    // Shard files of an earlier export that are no longer listed.
+  uint64_t bytes_written = 0;
+};
+
+// 64-bit FNV-1a of `data`.
+uint64_t Fnv1a64(std::string_view data);
+
+// Writes the dashboard data for `entries`, which must be in date order, to `dir`, taking each
+// month's moving averages from the points of `trend` in that month. The manifest
+// is replaced atomically once the new shards exist, and only then are shards it no longer lists
+// removed. Throws std::runtime_error on failure.
+DashboardWriteStats WriteDashboardData(const std::string& dir,
+                                       absl::Span<const EntryView> entries,
+                                       absl::Span<const WindowSummary> summaries,
+                                       const StreakStats& streak, const Trend& trend);
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_DASHBOARD_DATA_H_
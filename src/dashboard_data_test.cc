@@ -0,0 +1,137 @@
+#include "src/dashboard_data.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/date.h"
+#include "src/test_util.h"
+
+namespace life_tracker {
+namespace {
+
+class DashboardDataTest : public TempDirTest {
+ protected:
+  void AddEntry(std::string date, int mood, std::string note) {
+    dates_.push_back(std::move(date));
+    notes_.push_back(std::move(note));
+    moods_.push_back(mood);
+  }
+
+  DashboardWriteStats Write() {
+    std::vector<EntryView> views;
+    for (size_t i = 0; i < dates_.size(); ++i) {
+      EntryView view;
+      view.date = dates_[i];
+      view.mood = moods_[i];
+      view.note = notes_[i];
+      view.day = ParseIsoDate(view.date);
+      views.push_back(view);
+    }
+    return WriteDashboardData(dir_.string(), views, {{7, SummaryStats()}}, StreakStats(),
+                              TrendEntries(views, std::numeric_limits<int32_t>::min(),
+                                           std::numeric_limits<int32_t>::max()));
+  }
+
+  std::vector<std::string> ShardNames() const {
+    std::vector<std::string> names;
+    for (const auto& file : std::filesystem::directory_iterator(dir_ / "shards")) {
+      names.push_back(file.path().filename().string());
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+  }
+
+  std::vector<std::string> dates_;
+  std::vector<std::string> notes_;
+  std::vector<int> moods_;
+};
+
+TEST(Fnv1a64Test, MatchesReferenceValues) {
+  EXPECT_EQ(Fnv1a64(""), 0xcbf29ce484222325ull);
+  EXPECT_EQ(Fnv1a64("a"), 0xaf63dc4c8601ec8cull);
+  EXPECT_EQ(Fnv1a64("foobar"), 0x85944171f73967e8ull);
+}
+
+TEST_F(DashboardDataTest, WritesOneShardPerMonthAndAManifest) {
+  AddEntry("2026-01-30", 10, "a");
+  AddEntry("2026-01-31", 20, "say \"hi\"");
+  AddEntry("2026-03-01", 30, "");
+
+  const DashboardWriteStats stats = Write();
+  EXPECT_EQ(stats.shards, 2u);
+  EXPECT_EQ(stats.written, 2u);
+  EXPECT_EQ(stats.removed, 0u);
+
+  const std::vector<std::string> names = ShardNames();
+  ASSERT_EQ(names.size(), 2u);
+  EXPECT_EQ(names[0].rfind("2026-01.", 0), 0u);
+  EXPECT_EQ(names[1].rfind("2026-03.", 0), 0u);
+
+  const std::string january = ReadFile(dir_ / "shards" / names[0]);
+  EXPECT_EQ(january,
+            "{\"month\":\"2026-01\",\"entries\":[\n"
+            "{\"date\":\"2026-01-30\",\"mood\":10,\"note\":\"a\"},\n"
+            "{\"date\":\"2026-01-31\",\"mood\":20,\"note\":\"say \\\"hi\\\"\"}\n"
+            "],\"trend\":[\n"
+            "{\"date\":\"2026-01-30\",\"count\":1,\"average\":10.00,\"ma7\":10.00,\"sd7\":0.00,"
+            "\"ma30\":10.00,\"sd30\":0.00},\n"
+            "{\"date\":\"2026-01-31\",\"count\":1,\"average\":20.00,\"ma7\":15.00,\"sd7\":5.00,"
+            "\"ma30\":15.00,\"sd30\":5.00}\n"
+            "]}\n");
+  // The long window of March 1 reaches back into January.
+  EXPECT_NE(ReadFile(dir_ / "shards" / names[1])
+                .find("\"ma7\":30.00,\"sd7\":0.00,\"ma30\":25.00,\"sd30\":5.00}\n]}\n"),
+            std::string::npos);
+
+  const std::string manifest = ReadFile(dir_ / "manifest.json");
+  EXPECT_NE(manifest.find("\"streak\": {\"current\":0, \"longest\":0},\n"), std::string::npos);
+  EXPECT_NE(manifest.find("{\"month\":\"2026-01\",\"path\":\"shards/" + names[0] +
+                          "\",\"count\":2,\"first\":\"2026-01-30\",\"last\":\"2026-01-31\","
+                          "\"bytes\":" + std::to_string(january.size())),
+            std::string::npos);
+  EXPECT_NE(manifest.find("\"count\":1,\"first\":\"2026-03-01\""), std::string::npos);
+}
+
+TEST_F(DashboardDataTest, RewritesOnlyChangedMonths) {
+  AddEntry("2026-01-01", 10, "a");
+  AddEntry("2026-02-01", 20, "b");
+  Write();
+  const std::vector<std::string> before = ShardNames();
+
+  AddEntry("2026-02-02", 30, "c");
+  const DashboardWriteStats stats = Write();
+  EXPECT_EQ(stats.shards, 2u);
+  EXPECT_EQ(stats.written, 1u);
+  EXPECT_EQ(stats.removed, 1u);
+
+  const std::vector<std::string> after = ShardNames();
+  ASSERT_EQ(after.size(), 2u);
+  EXPECT_EQ(after[0], before[0]);
+  EXPECT_NE(after[1], before[1]);
+  EXPECT_EQ(after[1].rfind("2026-02.", 0), 0u);
+
+  const DashboardWriteStats unchanged = Write();
+  EXPECT_EQ(unchanged.written, 0u);
+  EXPECT_EQ(unchanged.removed, 0u);
+}
+
+TEST_F(DashboardDataTest, EmptyDataWritesAnEmptyManifest) {
+  AddEntry("2026-01-01", 10, "a");
+  Write();
+  dates_.clear();
+  notes_.clear();
+  moods_.clear();
+
+  const DashboardWriteStats stats = Write();
+  EXPECT_EQ(stats.shards, 0u);
+  EXPECT_EQ(stats.removed, 1u);
+  EXPECT_TRUE(ShardNames().empty());
+  EXPECT_NE(ReadFile(dir_ / "manifest.json").find("\"shards\": [  ]\n}\n"), std::string::npos);
+}
+
+}  // namespace
+}  // namespace life_tracker
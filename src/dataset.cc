@@ -0,0 +1,110 @@
+#include "src/dataset.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "src/date.h"
+#include "src/entry.h"
+
+namespace life_tracker {
+namespace {
+
+constexpr int64_t kMaxSpanDays = 50 * 365;
+constexpr size_t kFlushBytes = 1 << 20;
+
+constexpr const char* kWords[] = {
+    "slept", "well", "badly", "gym", "run", "walk", "work", "meeting", "deadline", "coffee",
+    "friends", "family", "dinner", "read", "tired", "focused", "rain", "sunny", "headache", "calm",
+    "anxious", "happy", "bored", "travel", "cooked", "movie", "call", "late", "early", "park",
+    "music", "project", "shipped", "review", "sick", "better", "weekend", "quiet", "busy",
+    "garden"};
+constexpr uint64_t kWordCount = sizeof(kWords) / sizeof(kWords[0]);
+
+// SplitMix64: tiny, fast and fully specified, unlike the <random> distributions, whose output
+// differs between standard libraries.
+uint64_t Mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+class Random {
+ public:
+  explicit Random(uint64_t seed) : state_(seed) {}
+
+  uint64_t Next() { return Mix(state_++); }
+  // Uniform in [0, n); the modulo bias is irrelevant at these sizes.
+  int Below(int n) { return static_cast<int>(Next() % static_cast<uint64_t>(n)); }
+
+ private:
+  uint64_t state_;
+};
+
+// Whether the journal has entries on `day`. Depends only on the seed and the day, so every row
+// that lands on a skipped day moves to the same next active one.
+bool DayIsActive(uint64_t seed, int64_t day) {
+  const uint64_t key = Mix(seed);
+  if (Mix(key ^ ~static_cast<uint64_t>(day / 14)) % 100 < 4) return false;  // A two-week break.
+  return Mix(key ^ static_cast<uint64_t>(day)) % 100 >= 12;
+}
+
+std::string SyntheticNote(Random* random) {
+  if (random->Below(100) < 20) return "";
+  const int words = random->Below(100) < 15 ? 8 + random->Below(40) : 1 + random->Below(4);
+  auto word = [&] { return kWords[random->Next() % kWordCount]; };
+  std::string note;
+  for (int i = 0; i < words; ++i) {
+    if (i > 0) note += ' ';
+    note += word();
+  }
+  if (random->Below(100) < 6) absl::StrAppend(&note, ", ", word());
+  if (random->Below(100) < 2) absl::StrAppend(&note, " \"", word(), "\"");
+  if (random->Below(1000) < 5) note += "\nsecond line";
+  return note;
+}
+
+}  // namespace
+
+void WriteSyntheticCsv(const DatasetOptions& options, std::ostream& out) {
+  const int64_t rows = std::max<int64_t>(options.rows, 0);
+  const int64_t span = std::clamp<int64_t>(rows + rows / 4, 1, kMaxSpanDays);
+  Random random(options.seed);
+  int level = 60;  // Mood drifts around this.
+  int64_t day = 0;
+  std::string buffer;
+  buffer.reserve(kFlushBytes + 4096);
+  for (int64_t i = 0; i < rows; ++i) {
+    day = std::max(day, i * span / rows);
+    while (!DayIsActive(options.seed, day)) ++day;
+
+    level = std::clamp(level + random.Below(7) - 3, 20, 90);
+    const int mood = std::clamp(level + random.Below(21) - 10, 1, 100);
+
+    char date[10];
+    FormatIsoDate(options.first_day + static_cast<int32_t>(day), date);
+    buffer.append(date, sizeof(date));
+    absl::StrAppend(&buffer, ",", mood, ",", EscapeCsvField(SyntheticNote(&random)), "\n");
+    if (buffer.size() >= kFlushBytes) {
+      out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      buffer.clear();
+    }
+  }
+  out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+void WriteSyntheticCsvFile(const std::string& path, const DatasetOptions& options) {
+  const std::filesystem::path fs_path(path);
+  if (fs_path.has_parent_path()) std::filesystem::create_directories(fs_path.parent_path());
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) throw std::runtime_error("Failed to open dataset file for writing: " + path);
+  WriteSyntheticCsv(options, out);
+  out.close();
+  if (!out) throw std::runtime_error("Failed to write dataset file: " + path);
+}
+
+}  // namespace life_tracker
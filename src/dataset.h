@@ -0,0 +1,29 @@
+#ifndef LIFE_TRACKER_DATASET_H_
+#define LIFE_TRACKER_DATASET_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace life_tracker {
+
+// Synthetic data files for benchmarks and load testing.
+struct DatasetOptions {
+  int64_t rows = 1000;
+  uint64_t seed = 1;
+  int32_t first_day = 10957;  // Day number of the earliest entry (2000-01-01).
+};
+
+// Writes `options.rows` entries in date order, in the data file's CSV format. The bytes depend
+// only on the options, on every platform, so a seed names a dataset. The data imitates a real
+// journal: most days have an entry, some have several, single days and two-week stretches are
+// skipped, moods drift rather than jump, and notes range from empty to a paragraph, with the
+// occasional comma, quote or line break that forces quoting. However many rows are asked for,
+// dates stay within 50 years of `first_day`; larger datasets get more entries per day.
+void WriteSyntheticCsv(const DatasetOptions& options, std::ostream& out);
+// Same, to `path`, creating parent directories. Throws std::runtime_error on I/O failure.
+void WriteSyntheticCsvFile(const std::string& path, const DatasetOptions& options);
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_DATASET_H_
@@ -0,0 +1,74 @@
+#include "src/dataset.h"
+
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "src/csv_scanner.h"
+#include "src/date.h"
+#include "src/entry.h"
+
+namespace life_tracker {
+namespace {
+
+std::string Generate(int64_t rows, uint64_t seed) {
+  DatasetOptions options;
+  options.rows = rows;
+  options.seed = seed;
+  std::ostringstream out;
+  WriteSyntheticCsv(options, out);
+  return out.str();
+}
+
+TEST(DatasetTest, SameSeedSameBytes) {
+  EXPECT_EQ(Generate(5000, 3), Generate(5000, 3));
+  EXPECT_NE(Generate(5000, 3), Generate(5000, 4));
+  EXPECT_EQ(Generate(0, 3), "");
+}
+
+TEST(DatasetTest, ParsesAsDateOrderedEntriesWithGapsAndQuoting) {
+  const std::string data = Generate(20000, 1);
+  CsvScanner scanner(data);
+  EntryView view;
+  std::string unescaped;
+  int64_t rows = 0;
+  int32_t previous = kInvalidDay;
+  int same_day = 0;
+  int gaps = 0;
+  int quoted = 0;
+  int multiline = 0;
+  while (scanner.Next(&view, &unescaped)) {
+    ++rows;
+    ASSERT_NE(view.day, kInvalidDay);
+    ASSERT_GE(view.mood, 1);
+    ASSERT_LE(view.mood, 100);
+    if (previous != kInvalidDay) {
+      ASSERT_GE(view.day, previous);
+      if (view.day == previous) ++same_day;
+      if (view.day > previous + 1) ++gaps;
+    }
+    previous = view.day;
+    if (view.note.find_first_of(",\"\n") != std::string_view::npos) ++quoted;
+    if (view.note.find('\n') != std::string_view::npos) ++multiline;
+  }
+  EXPECT_EQ(rows, 20000);
+  EXPECT_GT(same_day, 0);
+  EXPECT_GT(gaps, 0);
+  EXPECT_GT(quoted, 0);
+  EXPECT_GT(multiline, 0);
+}
+
+TEST(DatasetTest, LargeDatasetsStayWithinFourDigitYears) {
+  DatasetOptions options;
+  options.rows = 200000;
+  std::ostringstream out;
+  WriteSyntheticCsv(options, out);
+  const std::string data = out.str();
+  const size_t last_record = data.rfind('\n', data.size() - 2) + 1;
+  const int32_t last_day = ParseIsoDate(std::string_view(data).substr(last_record, 10));
+  ASSERT_NE(last_day, kInvalidDay);
+  EXPECT_LE(last_day - options.first_day, 50 * 365 + 31);
+}
+
+}  // namespace
+}  // namespace life_tracker
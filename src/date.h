@@ -0,0 +1,88 @@
+#ifndef LIFE_TRACKER_DATE_H_
+#define LIFE_TRACKER_DATE_H_
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include "absl/time/civil_time.h"
+
+namespace life_tracker {
+
+// Dates are handled internally as day numbers: days since 1970-01-01 in the proleptic Gregorian
+// calendar. kInvalidDay marks a date string that did not parse.
+inline constexpr int32_t kInvalidDay = std::numeric_limits<int32_t>::min();
+
+constexpr bool IsLeapYear(int year) {
+  return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+constexpr int DaysInMonth(int year, int month) {
+  constexpr int kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return month == 2 && IsLeapYear(year) ? 29 : kDays[month - 1];
+}
+
+// Converts a valid civil date to its day number (H. Hinnant's days_from_civil).
+constexpr int32_t DayNumberFromCivil(int year, int month, int day) {
+  const int y = year - (month <= 2 ? 1 : 0);
+  const int era = (y >= 0 ? y : y - 399) / 400;
+  const int yoe = y - era * 400;
+  const int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+// Parses exactly "YYYY-MM-DD" and returns its day number, or kInvalidDay if the string has the
+// wrong shape or names a day that does not exist (month 13, February 30, ...).
+constexpr int32_t ParseIsoDate(std::string_view s) {
+  if (s.size() != 10 || s[4] != '-' || s[7] != '-') return kInvalidDay;
+  int digits[8] = {};
+  constexpr int kDigitPositions[8] = {0, 1, 2, 3, 5, 6, 8, 9};
+  for (int i = 0; i < 8; ++i) {
+    const char c = s[kDigitPositions[i]];
+    if (c < '0' || c > '9') return kInvalidDay;
+    digits[i] = c - '0';
+  }
+  const int year = digits[0] * 1000 + digits[1] * 100 + digits[2] * 10 + digits[3];
+  const int month = digits[4] * 10 + digits[5];
+  const int day = digits[6] * 10 + digits[7];
+  if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month)) return kInvalidDay;
+  return DayNumberFromCivil(year, month, day);
+}
+
+// Writes the YYYY-MM-DD form of `day_number` to out[0..9]. Years outside 0..9999 are not
+// representable and produce garbage.
+constexpr void FormatIsoDate(int32_t day_number, char* out) {
+  const int z = day_number + 719468;
+  const int era = (z >= 0 ? z : z - 146096) / 146097;
+  const int doe = z - era * 146097;
+  const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const int mp = (5 * doy + 2) / 153;
+  const int day = doy - (153 * mp + 2) / 5 + 1;
+  const int month = mp < 10 ? mp + 3 : mp - 9;
+  const int year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+
+  out[0] = static_cast<char>('0' + year / 1000 % 10);
+  out[1] = static_cast<char>('0' + year / 100 % 10);
+  out[2] = static_cast<char>('0' + year / 10 % 10);
+  out[3] = static_cast<char>('0' + year % 10);
+  out[4] = '-';
+  out[5] = static_cast<char>('0' + month / 10);
+  out[6] = static_cast<char>('0' + month % 10);
+  out[7] = '-';
+  out[8] = static_cast<char>('0' + day / 10);
+  out[9] = static_cast<char>('0' + day % 10);
+}
+
+inline absl::CivilDay CivilDayFromDayNumber(int32_t day_number) {
+  return absl::CivilDay(1970, 1, 1) + day_number;
+}
+
+inline int32_t DayNumberFromCivilDay(absl::CivilDay day) {
+  return static_cast<int32_t>(day - absl::CivilDay(1970, 1, 1));
+}
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_DATE_H_
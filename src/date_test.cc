@@ -0,0 +1,42 @@
+#include "src/date.h"
+
+#include <string>
+
+#include "absl/time/civil_time.h"
+#include "gtest/gtest.h"
+
+namespace life_tracker {
+namespace {
+
+static_assert(ParseIsoDate("1970-01-01") == 0);
+static_assert(ParseIsoDate("2026-01-01") == 20454);
+static_assert(ParseIsoDate("1969-12-31") == -1);
+static_assert(ParseIsoDate("2024-02-29") == ParseIsoDate("2024-02-28") + 1);
+static_assert(ParseIsoDate("2023-02-29") == kInvalidDay);
+static_assert(ParseIsoDate("1900-02-29") == kInvalidDay);
+static_assert(ParseIsoDate("2000-02-29") != kInvalidDay);
+
+TEST(ParseIsoDateTest, RejectsMalformedStrings) {
+  for (const char* bad : {"", "2026-1-01", "2026-01-1", "2026/01/01", "2026-13-01", "2026-00-10",
+                          "2026-04-31", "2026-01-00", "2026-01-01 ", "20a6-01-01", "+026-01-01"}) {
+    EXPECT_EQ(ParseIsoDate(bad), kInvalidDay) << bad;
+  }
+}
+
+TEST(ParseIsoDateTest, MatchesAbseilAcrossFourCenturies) {
+  const absl::CivilDay start(1900, 1, 1);
+  const absl::CivilDay end(2300, 1, 1);
+  char buf[10];
+  for (absl::CivilDay day = start; day < end; ++day) {
+    const int32_t expected = DayNumberFromCivilDay(day);
+    const std::string text = absl::FormatCivilTime(day);
+    ASSERT_EQ(ParseIsoDate(text), expected) << text;
+
+    FormatIsoDate(expected, buf);
+    ASSERT_EQ(std::string(buf, sizeof(buf)), text);
+    ASSERT_EQ(CivilDayFromDayNumber(expected), day);
+  }
+}
+
+}  // namespace
+}  // namespace life_tracker
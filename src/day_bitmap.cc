@@ -0,0 +1,123 @@
+#include "src/day_bitmap.h"
+
+#include <algorithm>
+
+namespace life_tracker {
+namespace {
+
+constexpr int32_t kWordBits = 64;
+constexpr uint64_t kAllSet = ~uint64_t{0};
+
+// Both require x != 0.
+int CountTrailingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#else
+  int n = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+int CountLeadingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_clzll(x);
+#else
+  int n = 0;
+  while ((x & (uint64_t{1} << 63)) == 0) {
+    x <<= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+// Start of the 64-day word holding `day`, rounding toward negative infinity.
+int32_t WordStart(int32_t day) { return day - (((day % kWordBits) + kWordBits) % kWordBits); }
+
+}  // namespace
+
+void DayBitmap::Set(int32_t day) {
+  const int32_t start = WordStart(day);
+  if (words_.empty()) {
+    base_ = start;
+    words_.assign(1, 0);
+    first_set_ = last_set_ = day;
+  } else if (start < base_) {
+    words_.insert(words_.begin(), static_cast<size_t>((base_ - start) / kWordBits), 0);
+    base_ = start;
+  } else if (const size_t index = static_cast<size_t>((start - base_) / kWordBits);
+             index >= words_.size()) {
+    words_.resize(index + 1, 0);
+  }
+  const int32_t offset = day - base_;
+  words_[static_cast<size_t>(offset / kWordBits)] |= uint64_t{1} << (offset % kWordBits);
+  first_set_ = std::min(first_set_, day);
+  last_set_ = std::max(last_set_, day);
+}
+
+bool DayBitmap::Test(int32_t day) const {
+  if (words_.empty() || day < first_set_ || day > last_set_) return false;
+  const int32_t offset = day - base_;
+  return (words_[static_cast<size_t>(offset / kWordBits)] >> (offset % kWordBits)) & 1;
+}
+
+int32_t DayBitmap::LongestRun() const {
+  int32_t longest = 0;
+  int32_t carry = 0;  // Length of the run that reached the top of the previous word.
+  for (const uint64_t word : words_) {
+    if (word == kAllSet) {
+      carry += kWordBits;
+      continue;
+    }
+    // The run starting at bit 0 continues the carried one; ~word != 0 here.
+    const int low = CountTrailingZeros(~word);
+    longest = std::max(longest, carry + low);
+    carry = 0;
+
+    // Remaining runs, one ctz pair each. Bit `pos` of `word` is clear, so the shifted-in zeros
+    // keep ~rest non-zero.
+    int pos = low;
+    uint64_t rest = word >> pos;
+    while (rest != 0) {
+      const int gap = CountTrailingZeros(rest);
+      pos += gap;
+      rest >>= gap;
+      const int ones = CountTrailingZeros(~rest);
+      if (pos + ones == kWordBits) {
+        carry = ones;
+        break;
+      }
+      longest = std::max(longest, ones);
+      pos += ones;
+      rest >>= ones;
+    }
+  }
+  return std::max(longest, carry);
+}
+
+int32_t DayBitmap::RunEndingAt(int32_t day) const {
+  if (!Test(day)) return 0;
+  const int32_t offset = day - base_;
+  size_t index = static_cast<size_t>(offset / kWordBits);
+  const int bit = offset % kWordBits;
+
+  // Align `day` with the top bit and count the set bits below it.
+  const uint64_t aligned = words_[index] << (kWordBits - 1 - bit);
+  if (~aligned != 0) {
+    const int run = CountLeadingZeros(~aligned);
+    if (run <= bit) return run;
+  }
+  int32_t run = bit + 1;
+  while (index > 0) {
+    const uint64_t word = words_[--index];
+    if (word != kAllSet) return run + CountLeadingZeros(~word);
+    run += kWordBits;
+  }
+  return run;
+}
+
+}  // namespace life_tracker
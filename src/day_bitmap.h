@@ -0,0 +1,37 @@
+#ifndef LIFE_TRACKER_DAY_BITMAP_H_
+#define LIFE_TRACKER_DAY_BITMAP_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace life_tracker {
+
+// Set of day numbers (see date.h) stored as one bit per day over the range spanned so far. Runs
+// of consecutive days are measured a 64-day word at a time, so streak queries cost time linear in
+// the number of days spanned rather than in the number of entries.
+class DayBitmap {
+ public:
+  // Adds `day`, growing the covered range in either direction as needed.
+  void Set(int32_t day);
+  bool Test(int32_t day) const;
+
+  bool empty() const { return words_.empty(); }
+  // Earliest and latest days set. Only meaningful when !empty().
+  int32_t first_day() const { return first_set_; }
+  int32_t last_day() const { return last_set_; }
+
+  // Length of the longest run of consecutive set days.
+  int32_t LongestRun() const;
+  // Length of the run of consecutive set days ending at `day`; 0 if `day` is not set.
+  int32_t RunEndingAt(int32_t day) const;
+
+ private:
+  int32_t base_ = 0;  // Day of bit 0 of words_[0]; a multiple of 64.
+  int32_t first_set_ = 0;
+  int32_t last_set_ = 0;
+  std::vector<uint64_t> words_;
+};
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_DAY_BITMAP_H_
@@ -0,0 +1,80 @@
+#include "src/day_bitmap.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+#include "gtest/gtest.h"
+
+namespace life_tracker {
+namespace {
+
+int32_t ReferenceLongestRun(const std::set<int32_t>& days) {
+  int32_t longest = 0;
+  int32_t run = 0;
+  int32_t prev = 0;
+  for (const int32_t day : days) {
+    run = run > 0 && day == prev + 1 ? run + 1 : 1;
+    longest = std::max(longest, run);
+    prev = day;
+  }
+  return longest;
+}
+
+int32_t ReferenceRunEndingAt(const std::set<int32_t>& days, int32_t day) {
+  int32_t run = 0;
+  while (days.count(day - run)) ++run;
+  return run;
+}
+
+TEST(DayBitmapTest, EmptyHasNoRuns) {
+  DayBitmap days;
+  EXPECT_TRUE(days.empty());
+  EXPECT_FALSE(days.Test(0));
+  EXPECT_EQ(days.LongestRun(), 0);
+  EXPECT_EQ(days.RunEndingAt(0), 0);
+}
+
+TEST(DayBitmapTest, RunsCrossWordBoundariesInBothDirections) {
+  DayBitmap days;
+  for (int32_t day = 60; day < 200; ++day) days.Set(day);  // Spans three words.
+  for (int32_t day = -70; day < -1; ++day) days.Set(day);  // Grows the range downwards.
+  EXPECT_EQ(days.first_day(), -70);
+  EXPECT_EQ(days.last_day(), 199);
+  EXPECT_EQ(days.LongestRun(), 140);
+  EXPECT_EQ(days.RunEndingAt(199), 140);
+  EXPECT_EQ(days.RunEndingAt(127), 68);
+  EXPECT_EQ(days.RunEndingAt(-2), 69);
+  EXPECT_EQ(days.RunEndingAt(-1), 0);
+
+  days.Set(-1);
+  days.Set(0);
+  EXPECT_EQ(days.RunEndingAt(0), 71);
+  for (int32_t day = 1; day < 60; ++day) days.Set(day);
+  EXPECT_EQ(days.LongestRun(), 270);
+  EXPECT_EQ(days.RunEndingAt(199), 270);
+}
+
+TEST(DayBitmapTest, MatchesReferenceOnRandomSets) {
+  std::mt19937 rng(5);
+  for (int trial = 0; trial < 200; ++trial) {
+    const int32_t origin = std::uniform_int_distribution<int32_t>(-20000, 20000)(rng);
+    const int32_t span = std::uniform_int_distribution<int32_t>(1, 1000)(rng);
+    std::bernoulli_distribution present(trial % 4 == 0 ? 0.97 : 0.6);
+    std::set<int32_t> expected;
+    DayBitmap days;
+    for (int32_t day = origin; day < origin + span; ++day) {
+      if (!present(rng)) continue;
+      expected.insert(day);
+      days.Set(day);
+    }
+    ASSERT_EQ(days.LongestRun(), ReferenceLongestRun(expected)) << trial;
+    for (int32_t day = origin - 1; day <= origin + span; ++day) {
+      ASSERT_EQ(days.Test(day), expected.count(day) == 1) << trial << " " << day;
+      ASSERT_EQ(days.RunEndingAt(day), ReferenceRunEndingAt(expected, day)) << trial << " " << day;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace life_tracker
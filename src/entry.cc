@@ -1,101 +1,75 @@
 #include "src/entry.h"
 
-#include <cctype>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+
+#include "src/csv_scanner.h"
 
 namespace life_tracker {
-namespace {
 
-std::string TrimTrailingCarriageReturn(const std::string& s) {
-  if (!s.empty() && s.back() == '\r') return s.substr(0, s.size() - 1);
-  return s;
+std::string EscapeCsvField(std::string_view s) {
+  std::string out;
+  EscapeCsvField(s, &out);
+  return out;
 }
 
-std::string EscapeCsvField(const std::string& s) {
-  bool needs_quotes = false;
-  for (char c : s) {
-    if (c == ',' || c == '"' || c == '\n' || c == '\r') {
-      needs_quotes = true;
-      break;
-    }
+void EscapeCsvField(std::string_view s, std::string* out) {
+  if (s.find_first_of(",\"\n\r") == std::string_view::npos) {
+    out->append(s);
+    return;
   }
-  if (!needs_quotes) return s;
-
-  std::string out;
-  out.reserve(s.size() + 2);
-  out.push_back('"');
-  for (char c : s) {
-    if (c == '"') {
-      out += "\"\"";
-    } else {
-      out.push_back(c);
+  out->push_back('"');
+  for (size_t start = 0;;) {
+    const size_t quote = s.find('"', start);
+    if (quote == std::string_view::npos) {
+      out->append(s.substr(start));
+      break;
     }
+    // Through the quote, then a second one to escape it.
+    out->append(s.substr(start, quote + 1 - start));
+    out->push_back('"');
+    start = quote + 1;
   }
-  out.push_back('"');
-  return out;
+  out->push_back('"');
 }
 
-std::string ReadCsvField(const std::string& line, size_t* i) {
-  std::string out;
-  if (*i >= line.size()) return out;
+std::string Entry::ToCsv() const { return EntryView{date, mood, note}.ToCsv(); }
 
-  if (line[*i] == '"') {
-    ++(*i);
-    while (*i < line.size()) {
-      if (line[*i] == '"') {
-        if (*i + 1 < line.size() && line[*i + 1] == '"') {
-          out.push_back('"');
-          *i += 2;
-        } else {
-          ++(*i);
-          break;
-        }
-      } else {
-        out.push_back(line[*i]);
-        ++(*i);
-      }
-    }
-    if (*i < line.size() && line[*i] == ',') ++(*i);
-    return out;
+Entry Entry::FromCsvLine(const std::string& line) {
+  size_t pos = 0;
+  EntryView view;
+  std::string unescaped_note;
+  if (!ParseCsvRecord(line, &pos, &view, &unescaped_note)) {
+    throw std::runtime_error("Malformed CSV line: " + line);
   }
-
-  while (*i < line.size() && line[*i] != ',') {
-    out.push_back(line[*i]);
-    ++(*i);
-  }
-  if (*i < line.size() && line[*i] == ',') ++(*i);
-  return out;
+  return view.ToEntry();
 }
 
-}  // namespace
-
-std::string Entry::ToCsv() const {
+std::string EntryView::ToCsv() const {
   std::ostringstream oss;
   oss << date << "," << mood << "," << EscapeCsvField(note);
   return oss.str();
 }
 
-Entry Entry::FromCsvLine(const std::string& line_in) {
-  const std::string line = TrimTrailingCarriageReturn(line_in);
-
-  size_t i = 0;
-  const std::string date = ReadCsvField(line, &i);
-  const std::string mood_str = ReadCsvField(line, &i);
-  const std::string note = ReadCsvField(line, &i);
-
+Entry EntryView::ToEntry() const {
   Entry e;
-  e.date = date;
+  e.date = std::string(date);
+  e.mood = mood;
+  e.note = std::string(note);
+  return e;
+}
 
-  try {
-    e.mood = std::stoi(mood_str);
-  } catch (...) {
-    throw std::runtime_error("Invalid mood in CSV: " + mood_str);
+bool ParseCsvRecord(std::string_view data, size_t* pos, EntryView* view,
+                    std::string* unescaped_note) {
+  CsvScanner scanner(data.substr(*pos));
+  if (!scanner.Next(view, unescaped_note)) {
+    *pos = data.size();
+    return false;
   }
-
-  e.note = note;
-  return e;
+  *pos += scanner.position();
+  return true;
 }
 
 }  // namespace life_tracker
@@ -1,7 +1,13 @@
 #ifndef LIFE_TRACKER_ENTRY_H_
 #define LIFE_TRACKER_ENTRY_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "src/date.h"
 
 namespace life_tracker {
 
@@ -11,9 +17,38 @@ struct Entry {
   std::string note;
 
   std::string ToCsv() const;
+  // Throws std::runtime_error if `line` holds no record or its mood is not an integer.
   static Entry FromCsvLine(const std::string& line);
 };
 
+// A parsed entry whose fields point into storage owned by someone else, typically the loaded or
+// memory-mapped data file. Cheap to copy; never outlives that storage.
+struct EntryView {
+  std::string_view date;  // YYYY-MM-DD
+  int mood = 0;
+  std::string_view note;
+  int32_t day = kInvalidDay;  // `date` as a day number, parsed once when the view is built.
+
+  std::string ToCsv() const;
+  Entry ToEntry() const;
+};
+static_assert(std::is_trivially_copyable_v<EntryView>, "EntryView must stay a plain record");
+
+// Quotes `s` for a CSV field if it contains a comma, quote or line break, doubling any quotes.
+std::string EscapeCsvField(std::string_view s);
+// Appends the escaped field to `*out` instead, for writers that build records in a buffer.
+void EscapeCsvField(std::string_view s, std::string* out);
+
+// Parses the CSV record starting at `*pos` in `data` and advances `*pos` past its line terminator.
+// Quoted fields may span lines. Blank lines are skipped. Returns false once `data` is exhausted.
+// `view->day` is set from the date, or to kInvalidDay if the date is malformed.
+//
+// The fields of `*view` point into `data`, except for a quoted note containing escaped quotes:
+// that note is unescaped into `*unescaped_note` and `view->note` points there instead.
+// Throws std::runtime_error if the mood is not an integer.
+bool ParseCsvRecord(std::string_view data, size_t* pos, EntryView* view,
+                    std::string* unescaped_note);
+
 }  // namespace life_tracker
 
 #endif  // LIFE_TRACKER_ENTRY_H_
@@ -1,5 +1,8 @@
 #include "src/entry.h"
 
+#include <stdexcept>
+#include <string>
+
 #include "gtest/gtest.h"
 
 namespace life_tracker {
@@ -18,4 +21,70 @@ TEST(EntryTest, CsvRoundTripWithCommaAndQuotes) {
   EXPECT_EQ(parsed.note, e.note);
 }
 
+TEST(EscapeCsvFieldTest, QuotesOnlyWhenNeededAndAppends) {
+  EXPECT_EQ(EscapeCsvField("plain"), "plain");
+  EXPECT_EQ(EscapeCsvField("a,b"), "\"a,b\"");
+  EXPECT_EQ(EscapeCsvField("say \"hi\""), "\"say \"\"hi\"\"\"");
+
+  std::string out = "1,";
+  EscapeCsvField("x\ny", &out);
+  EXPECT_EQ(out, "1,\"x\ny\"");
+}
+
+TEST(EntryTest, FromCsvLineRejectsBlankLine) {
+  try {
+    Entry::FromCsvLine("");
+    FAIL() << "expected std::runtime_error";
+  } catch (const std::runtime_error& e) {
+    EXPECT_NE(std::string(e.what()).find("Malformed CSV line"), std::string::npos);
+  }
+}
+
+TEST(ParseCsvRecordTest, ParsesBufferWithoutCopyingPlainFields) {
+  const std::string data = "2026-01-01,40,plain\r\n\n2026-01-02,50,\"a,b\"\n";
+
+  size_t pos = 0;
+  EntryView view;
+  std::string unescaped;
+  ASSERT_TRUE(ParseCsvRecord(data, &pos, &view, &unescaped));
+  EXPECT_EQ(view.date, "2026-01-01");
+  EXPECT_EQ(view.mood, 40);
+  EXPECT_EQ(view.note, "plain");
+  EXPECT_EQ(view.note.data(), data.data() + data.find("plain"));
+
+  ASSERT_TRUE(ParseCsvRecord(data, &pos, &view, &unescaped));
+  EXPECT_EQ(view.date, "2026-01-02");
+  EXPECT_EQ(view.note, "a,b");
+  EXPECT_TRUE(unescaped.empty());
+
+  EXPECT_FALSE(ParseCsvRecord(data, &pos, &view, &unescaped));
+}
+
+TEST(ParseCsvRecordTest, UnescapesQuotesAndKeepsEmbeddedNewlines) {
+  Entry e;
+  e.date = "2026-01-03";
+  e.mood = 7;
+  e.note = "line one\nsaid \"hi\"";
+  const std::string data = e.ToCsv() + "\n2026-01-04,8,next\n";
+
+  size_t pos = 0;
+  EntryView view;
+  std::string unescaped;
+  ASSERT_TRUE(ParseCsvRecord(data, &pos, &view, &unescaped));
+  EXPECT_EQ(view.note, e.note);
+  EXPECT_EQ(view.note.data(), unescaped.data());
+
+  ASSERT_TRUE(ParseCsvRecord(data, &pos, &view, &unescaped));
+  EXPECT_EQ(view.date, "2026-01-04");
+  EXPECT_EQ(view.note, "next");
+}
+
+TEST(ParseCsvRecordTest, RejectsNonNumericMood) {
+  const std::string data = "2026-01-01,great,note\n";
+  size_t pos = 0;
+  EntryView view;
+  std::string unescaped;
+  EXPECT_THROW(ParseCsvRecord(data, &pos, &view, &unescaped), std::runtime_error);
+}
+
 }  // namespace life_tracker
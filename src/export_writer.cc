@@ -0,0 +1,327 @@
+#include "src/export_writer.h"
+
+#include <filesystem>
+#include <stdexcept>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "src/date.h"
+#include "src/trace.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace life_tracker {
+namespace {
+
+// Large enough that the stream sees few, big writes; small enough to stay in cache.
+constexpr size_t kBufferSize = 1 << 20;
+
+bool NeedsJsonEscape(char c) {
+  return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+void AppendDayMood(std::string* out, bool has_data, const DayMood& day) {
+  if (!has_data) {
+    out->append("null");
+    return;
+  }
+  absl::StrAppend(out, "{\"date\":\"", absl::FormatCivilTime(day.day), "\",\"mood\":", day.mood,
+                  "}");
+}
+
+// Appends a window's number of days, or null for all time.
+void AppendWindowDays(std::string* out, int days) {
+  if (days == 0) {
+    out->append("null");
+  } else {
+    absl::StrAppend(out, days);
+  }
+}
+
+// Appends `summary` as a JSON object whose members are separated by `separator`: ",\n    " lays
+// it out one member per line at the indentation of a top-level member, "," keeps it on one line.
+void AppendJsonSummary(std::string* out, const SummaryStats& summary, const char* separator) {
+  const bool multiline = separator[1] != '\0';
+  out->append(multiline ? "{\n    " : "{");
+  absl::StrAppend(out, "\"has_data\":", summary.has_data ? "true" : "false", separator,
+                  "\"count\":", summary.count, separator);
+  absl::StrAppendFormat(out, "\"average_mood\":%.1f%s\"stddev\":%.1f%s", summary.average_mood,
+                        separator, summary.stddev, separator);
+  out->append("\"distribution\":");
+  if (summary.has_distribution) {
+    const MoodDistribution& distribution = summary.distribution;
+    absl::StrAppendFormat(out,
+                          "{\"median\":%.1f,\"p10\":%d,\"p25\":%d,\"p75\":%d,\"p90\":%d,"
+                          "\"iqr\":%d,\"mode\":%d}",
+                          distribution.median, distribution.p10, distribution.p25,
+                          distribution.p75, distribution.p90, distribution.iqr, distribution.mode);
+  } else {
+    out->append("null");
+  }
+  out->append(separator);
+  out->append("\"best\":");
+  AppendDayMood(out, summary.has_data, summary.best);
+  out->append(separator);
+  out->append("\"worst\":");
+  AppendDayMood(out, summary.has_data, summary.worst);
+  out->append(multiline ? "\n  }" : "}");
+}
+
+}  // namespace
+
+ExportFormat ParseExportFormat(std::string_view name) {
+  if (name == "json") return ExportFormat::kJson;
+  if (name == "ndjson") return ExportFormat::kNdjson;
+  if (name == "csv") return ExportFormat::kCsv;
+  throw std::runtime_error("Unsupported export format: " + std::string(name));
+}
+
+const char* ExportFormatName(ExportFormat format) {
+  switch (format) {
+    case ExportFormat::kJson:
+      return "json";
+    case ExportFormat::kNdjson:
+      return "ndjson";
+    case ExportFormat::kCsv:
+      return "csv";
+  }
+  return "json";
+}
+
+size_t FindJsonEscapeScalar(std::string_view s, size_t from) {
+  for (size_t i = from; i < s.size(); ++i) {
+    if (NeedsJsonEscape(s[i])) return i;
+  }
+  return s.size();
+}
+
+size_t FindJsonEscape(std::string_view s, size_t from) {
+  const char* bytes = s.data();
+  size_t i = from;
+  // A byte is a control character exactly when min(byte, 0x1f) == byte, compared unsigned.
+#if defined(__AVX2__)
+  const __m256i quote32 = _mm256_set1_epi8('"');
+  const __m256i backslash32 = _mm256_set1_epi8('\\');
+  const __m256i control32 = _mm256_set1_epi8(0x1f);
+  for (; i + 32 <= s.size(); i += 32) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+    const __m256i hits = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote32), _mm256_cmpeq_epi8(chunk, backslash32)),
+        _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control32), chunk));
+    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+    if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i quote16 = _mm_set1_epi8('"');
+  const __m128i backslash16 = _mm_set1_epi8('\\');
+  const __m128i control16 = _mm_set1_epi8(0x1f);
+  for (; i + 16 <= s.size(); i += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+    const __m128i hits = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote16), _mm_cmpeq_epi8(chunk, backslash16)),
+        _mm_cmpeq_epi8(_mm_min_epu8(chunk, control16), chunk));
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+    if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+  }
+#endif
+  return FindJsonEscapeScalar(s, i);
+}
+
+void AppendJsonEscaped(std::string* out, std::string_view s) {
+  size_t start = 0;
+  while (true) {
+    const size_t special = FindJsonEscape(s, start);
+    out->append(s.data() + start, special - start);
+    if (special == s.size()) return;
+    const char c = s[special];
+    switch (c) {
+      case '"':
+        out->append("\\\"");
+        break;
+      case '\\':
+        out->append("\\\\");
+        break;
+      case '\b':
+        out->append("\\b");
+        break;
+      case '\f':
+        out->append("\\f");
+        break;
+      case '\n':
+        out->append("\\n");
+        break;
+      case '\r':
+        out->append("\\r");
+        break;
+      case '\t':
+        out->append("\\t");
+        break;
+      default:
+        absl::StrAppendFormat(out, "\\u%04x", static_cast<int>(static_cast<unsigned char>(c)));
+    }
+    start = special + 1;
+  }
+}
+
+std::string JsonEscape(std::string_view s) {
+  std::string out;
+  out.reserve(s.size() + 8);
+  AppendJsonEscaped(&out, s);
+  return out;
+}
+
+void AppendJsonEntry(std::string* out, const EntryView& entry) {
+  out->append("{\"date\":\"");
+  AppendJsonEscaped(out, entry.date);
+  absl::StrAppend(out, "\",\"mood\":", entry.mood, ",\"note\":\"");
+  AppendJsonEscaped(out, entry.note);
+  out->append("\"}");
+}
+
+void AppendJsonStatsMembers(std::string* out, absl::Span<const WindowSummary> summaries,
+                            const StreakStats& streak) {
+  const WindowSummary& first = summaries.front();
+  absl::StrAppend(out, "  \"meta\": {\"generated_at\":\"",
+                  JsonEscape(absl::FormatTime(absl::Now(), absl::UTCTimeZone())), "\", \"days\":");
+  AppendWindowDays(out, first.days);
+  out->append("},\n  \"summary\": ");
+  AppendJsonSummary(out, first.summary, ",\n    ");
+  out->append(",\n");
+  if (summaries.size() > 1) {
+    out->append("  \"windows\": [");
+    for (size_t i = 0; i < summaries.size(); ++i) {
+      out->append(i > 0 ? ",\n    {\"days\":" : "\n    {\"days\":");
+      AppendWindowDays(out, summaries[i].days);
+      out->append(",\"summary\":");
+      AppendJsonSummary(out, summaries[i].summary, ",");
+      out->push_back('}');
+    }
+    out->append("\n  ],\n");
+  }
+  absl::StrAppend(out, "  \"streak\": {\"current\":", streak.current_streak,
+                  ", \"longest\":", streak.longest_streak, "},\n");
+}
+
+void AppendJsonRollupMember(std::string* out, const Rollup& rollup) {
+  absl::StrAppend(out, "  \"rollup\": {\"by\":\"", RollupPeriodName(rollup.period),
+                  "\", \"buckets\": [");
+  for (size_t i = 0; i < rollup.buckets.size(); ++i) {
+    const RollupBucket& bucket = rollup.buckets[i];
+    const SummaryStats& summary = bucket.summary;
+    absl::StrAppendFormat(
+        out,
+        "%s{\"label\":\"%s\",\"first\":\"%s\",\"last\":\"%s\",\"count\":%d,"
+        "\"average_mood\":%.1f,\"stddev\":%.1f,\"min\":%d,\"max\":%d,"
+        "\"days_with_entries\":%d,\"days_in_range\":%d}",
+        i > 0 ? ",\n    " : "\n    ", RollupBucketLabel(rollup.period, bucket),
+        absl::FormatCivilTime(bucket.first_day), absl::FormatCivilTime(bucket.last_day),
+        summary.count, summary.average_mood, summary.stddev, summary.worst.mood,
+        summary.best.mood, bucket.days_with_entries, bucket.days_in_range);
+  }
+  out->append(rollup.buckets.empty() ? "]},\n" : "\n  ]},\n");
+}
+
+void AppendJsonTrendPoint(std::string* out, const TrendPoint& point) {
+  char date[10];
+  FormatIsoDate(point.day, date);
+  absl::StrAppendFormat(out,
+                        "{\"date\":\"%s\",\"count\":%d,\"average\":%.2f,\"ma7\":%.2f,\"sd7\":%.2f,"
+                        "\"ma30\":%.2f,\"sd30\":%.2f}",
+                        absl::string_view(date, sizeof(date)), point.count, point.average,
+                        point.average7, point.stddev7, point.average30, point.stddev30);
+}
+
+ExportWriter::ExportWriter(ExportFormat format, std::ostream* out)
+    : format_(format), out_(out) {
+  buffer_.reserve(kBufferSize + 4096);
+}
+
+void ExportWriter::Begin(absl::Span<const WindowSummary> summaries, const StreakStats& streak,
+                         const Rollup* rollup, const Trend* trend) {
+  if (format_ != ExportFormat::kJson) return;
+  buffer_ += "{\n";
+  AppendJsonStatsMembers(&buffer_, summaries, streak);
+  if (rollup != nullptr) AppendJsonRollupMember(&buffer_, *rollup);
+  if (trend != nullptr) {
+    buffer_ += "  \"trend\": {\"slope_per_day\":";
+    if (trend->has_slope) {
+      absl::StrAppendFormat(&buffer_, "%.4f", trend->slope);
+    } else {
+      buffer_ += "null";
+    }
+    buffer_ += ", \"days\": [";
+    // A day per point, so like the entries they are flushed as the buffer fills.
+    for (size_t i = 0; i < trend->points.size(); ++i) {
+      buffer_ += i > 0 ? ",\n    " : "\n    ";
+      AppendJsonTrendPoint(&buffer_, trend->points[i]);
+      FlushIfFull();
+    }
+    buffer_ += trend->points.empty() ? "]},\n" : "\n  ]},\n";
+  }
+  buffer_ += "  \"entries\": [";
+}
+
+void ExportWriter::Add(const EntryView& entry) {
+  switch (format_) {
+    case ExportFormat::kJson:
+    case ExportFormat::kNdjson:
+      if (format_ == ExportFormat::kJson) buffer_ += entries_ > 0 ? ",\n    " : "\n    ";
+      AppendJsonEntry(&buffer_, entry);
+      if (format_ == ExportFormat::kNdjson) buffer_ += '\n';
+      break;
+    case ExportFormat::kCsv:
+      buffer_.append(entry.date);
+      absl::StrAppend(&buffer_, ",", entry.mood, ",");
+      EscapeCsvField(entry.note, &buffer_);
+      buffer_ += '\n';
+      break;
+  }
+  ++entries_;
+  FlushIfFull();
+}
+
+void ExportWriter::Finish() {
+  if (format_ == ExportFormat::kJson) buffer_ += entries_ > 0 ? "\n  ]\n}\n" : "  ]\n}\n";
+  Flush();
+  out_->flush();
+  if (!*out_) throw std::runtime_error("Failed to write export.");
+}
+
+void ExportWriter::FlushIfFull() {
+  if (buffer_.size() >= kBufferSize) Flush();
+}
+
+void ExportWriter::Flush() {
+  out_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  bytes_written_ += buffer_.size();
+  buffer_.clear();
+}
+
+std::ofstream OpenExportFile(const std::string& path) {
+  const std::filesystem::path fs_path(path);
+  if (fs_path.has_parent_path()) std::filesystem::create_directories(fs_path.parent_path());
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) throw std::runtime_error("Failed to open export file for writing: " + path);
+  return out;
+}
+
+void WriteExportFile(const std::string& path, ExportFormat format,
+                     absl::Span<const EntryView> entries,
+                     absl::Span<const WindowSummary> summaries, const StreakStats& streak,
+                     const Rollup* rollup, const Trend* trend) {
+  TraceSpan span("write_export");
+  std::ofstream out = OpenExportFile(path);
+  ExportWriter writer(format, &out);
+  writer.Begin(summaries, streak, rollup, trend);
+  for (const EntryView& entry : entries) writer.Add(entry);
+  writer.Finish();
+  span.Counter("entries", static_cast<int64_t>(entries.size()));
+  span.Counter("bytes", static_cast<int64_t>(writer.bytes_written()));
+}
+
+}  // namespace life_tracker
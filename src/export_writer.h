@@ -0,0 +1,97 @@
+#ifndef LIFE_TRACKER_EXPORT_WRITER_H_
+#define LIFE_TRACKER_EXPORT_WRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "absl/types/span.h"
+#include "src/entry.h"
+#include "src/rollup.h"
+#include "src/stats.h"
+#include "src/trend.h"
+
+namespace life_tracker {
+
+enum class ExportFormat {
+  kJson,    // One document: metadata, summary, streaks and an "entries" array.
+  kNdjson,  // One {"date","mood","note"} object per line.
+  kCsv,     // The data file's own date,mood,note format.
+};
+
+// Parses "json", "ndjson" or "csv". Throws std::runtime_error for anything else.
+ExportFormat ParseExportFormat(std::string_view name);
+// The name ParseExportFormat() accepts for `format`.
+const char* ExportFormatName(ExportFormat format);
+
+// Offset of the first byte at or after `from` in `s` that JSON strings must escape (a quote, a
+// backslash or a control character), or s.size(). Uses AVX2 or SSE2 when the build targets them.
+size_t FindJsonEscape(std::string_view s, size_t from);
+// Portable reference implementation of FindJsonEscape.
+size_t FindJsonEscapeScalar(std::string_view s, size_t from);
+
+// Appends `s` to `*out` with JSON string escaping, copying runs of safe bytes in bulk.
+void AppendJsonEscaped(std::string* out, std::string_view s);
+std::string JsonEscape(std::string_view s);
+
+// Appends `entry` as a {"date","mood","note"} JSON object.
+void AppendJsonEntry(std::string* out, const EntryView& entry);
+// Appends the "meta", "summary" and "streak" members of the JSON export, each on its own lines
+// and followed by a comma, for documents that share its header. "meta" and "summary" describe
+// the first of `summaries`, which must not be empty; with more than one, a "windows" member
+// lists them all as {"days", "summary"} objects, days being null for all time.
+void AppendJsonStatsMembers(std::string* out, absl::Span<const WindowSummary> summaries,
+                            const StreakStats& streak);
+// Appends the "rollup" member, {"by": period, "buckets": [...]}, followed by a comma.
+void AppendJsonRollupMember(std::string* out, const Rollup& rollup);
+// Appends `point` as a {"date","count","average","ma7","sd7","ma30","sd30"} JSON object.
+void AppendJsonTrendPoint(std::string* out, const TrendPoint& point);
+
+// Streams an export through one reusable buffer that is handed to `out` in large writes, so the
+// cost per entry is a few appends and memory does not grow with the number of entries. Call
+// Begin(), then Add() per entry, then Finish().
+class ExportWriter {
+ public:
+  // `out` must outlive the writer.
+  ExportWriter(ExportFormat format, std::ostream* out);
+  ExportWriter(const ExportWriter&) = delete;
+  ExportWriter& operator=(const ExportWriter&) = delete;
+
+  // Writes what precedes the entries. The summaries (see AppendJsonStatsMembers()), streaks,
+  // `rollup` and `trend`, if any, only appear in JSON. The trend is a "trend" member,
+  // {"slope_per_day", "days"}, with one AppendJsonTrendPoint() object per day.
+  void Begin(absl::Span<const WindowSummary> summaries, const StreakStats& streak,
+             const Rollup* rollup = nullptr, const Trend* trend = nullptr);
+  void Add(const EntryView& entry);
+  // Writes what follows the entries and flushes. Throws std::runtime_error if `out` failed.
+  void Finish();
+
+  // Bytes handed to `out` so far.
+  uint64_t bytes_written() const { return bytes_written_; }
+
+ private:
+  void FlushIfFull();
+  void Flush();
+
+  ExportFormat format_;
+  std::ostream* out_;
+  std::string buffer_;
+  uint64_t bytes_written_ = 0;
+  size_t entries_ = 0;
+};
+
+// Opens `path` for writing, creating parent directories. Throws std::runtime_error on failure.
+std::ofstream OpenExportFile(const std::string& path);
+
+// Writes a whole export of `entries` to `path` in `format`.
+void WriteExportFile(const std::string& path, ExportFormat format,
+                     absl::Span<const EntryView> entries,
+                     absl::Span<const WindowSummary> summaries, const StreakStats& streak,
+                     const Rollup* rollup = nullptr, const Trend* trend = nullptr);
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_EXPORT_WRITER_H_
@@ -0,0 +1,246 @@
+#include "src/export_writer.h"
+
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/csv_scanner.h"
+#include "src/date.h"
+
+namespace life_tracker {
+namespace {
+
+EntryView View(std::string_view date, int mood, std::string_view note) {
+  EntryView view;
+  view.date = date;
+  view.mood = mood;
+  view.note = note;
+  view.day = ParseIsoDate(date);
+  return view;
+}
+
+std::string Export(ExportFormat format, const std::vector<EntryView>& entries) {
+  std::ostringstream out;
+  ExportWriter writer(format, &out);
+  writer.Begin({{7, SummaryStats()}}, StreakStats());
+  for (const EntryView& entry : entries) writer.Add(entry);
+  writer.Finish();
+  EXPECT_EQ(writer.bytes_written(), out.str().size());
+  return out.str();
+}
+
+TEST(ExportFormatTest, ParsesKnownNames) {
+  for (const ExportFormat format : {ExportFormat::kJson, ExportFormat::kNdjson,
+                                    ExportFormat::kCsv}) {
+    EXPECT_EQ(ParseExportFormat(ExportFormatName(format)), format);
+  }
+  EXPECT_THROW(ParseExportFormat("xml"), std::runtime_error);
+}
+
+TEST(FindJsonEscapeTest, MatchesScalarAtEveryOffset) {
+  std::mt19937 rng(5);
+  // Mostly safe bytes so the vector loops run several blocks between hits.
+  std::string data(300, 'a');
+  for (char& c : data) {
+    const int roll = static_cast<int>(rng() % 40);
+    if (roll == 0) c = '"';
+    if (roll == 1) c = '\\';
+    if (roll == 2) c = static_cast<char>(rng() % 0x20);
+    if (roll == 3) c = static_cast<char>(0x80 + rng() % 0x80);
+    if (roll == 4) c = 0x7f;
+  }
+  for (size_t from = 0; from <= data.size(); ++from) {
+    ASSERT_EQ(FindJsonEscape(data, from), FindJsonEscapeScalar(data, from)) << from;
+  }
+}
+
+TEST(JsonEscapeTest, EscapesQuotesBackslashesAndControlCharacters) {
+  EXPECT_EQ(JsonEscape("plain text, long enough to cross a vector block"),
+            "plain text, long enough to cross a vector block");
+  EXPECT_EQ(JsonEscape("say \"hi\"\\\n\t\x01"), "say \\\"hi\\\"\\\\\\n\\t\\u0001");
+  EXPECT_EQ(JsonEscape("caf\xc3\xa9"), "caf\xc3\xa9");
+}
+
+TEST(ExportWriterTest, WritesJsonDocument) {
+  const std::string json = Export(
+      ExportFormat::kJson, {View("2026-01-01", 10, "a \"quote\""), View("2026-01-02", 20, "")});
+  EXPECT_EQ(json.rfind("{\n  \"meta\": {\"generated_at\":\"", 0), 0u);
+  EXPECT_NE(json.find("\"days\":7}"), std::string::npos);
+  EXPECT_NE(json.find("\"distribution\":null,\n    \"best\":null,\n    \"worst\":null\n  },\n"),
+            std::string::npos);
+  EXPECT_NE(json.find("  \"entries\": [\n"
+                      "    {\"date\":\"2026-01-01\",\"mood\":10,\"note\":\"a \\\"quote\\\"\"},\n"
+                      "    {\"date\":\"2026-01-02\",\"mood\":20,\"note\":\"\"}\n"
+                      "  ]\n}\n"),
+            std::string::npos);
+
+  EXPECT_NE(Export(ExportFormat::kJson, {}).find("\"entries\": [  ]\n}\n"), std::string::npos);
+}
+
+TEST(ExportWriterTest, IncludesDistributionInJsonSummary) {
+  SummaryAccumulator acc;
+  for (const int mood : {10, 20, 20, 90}) acc.Push({absl::CivilDay(2026, 1, 1), mood});
+  std::ostringstream out;
+  ExportWriter writer(ExportFormat::kJson, &out);
+  writer.Begin({{7, acc.Result()}}, StreakStats());
+  writer.Finish();
+  EXPECT_NE(out.str().find("    \"distribution\":{\"median\":20.0,\"p10\":10,\"p25\":10,"
+                           "\"p75\":20,\"p90\":90,\"iqr\":10,\"mode\":20},\n"),
+            std::string::npos)
+      << out.str();
+}
+
+TEST(ExportWriterTest, ListsEveryWindowInJson) {
+  SummaryAccumulator acc;
+  acc.Push({absl::CivilDay(2026, 1, 1), 40});
+  std::ostringstream out;
+  ExportWriter writer(ExportFormat::kJson, &out);
+  writer.Begin({{7, SummaryStats()}, {0, acc.Result()}}, StreakStats());
+  writer.Finish();
+  EXPECT_NE(out.str().find("\"days\":7}"), std::string::npos);
+  EXPECT_NE(out.str().find("  \"windows\": [\n"
+                           "    {\"days\":7,\"summary\":{\"has_data\":false,\"count\":0,"),
+            std::string::npos)
+      << out.str();
+  EXPECT_NE(out.str().find("    {\"days\":null,\"summary\":{\"has_data\":true,\"count\":1,"
+                           "\"average_mood\":40.0,"),
+            std::string::npos);
+
+  std::ostringstream single;
+  ExportWriter single_writer(ExportFormat::kJson, &single);
+  single_writer.Begin({{0, SummaryStats()}}, StreakStats());
+  single_writer.Finish();
+  EXPECT_NE(single.str().find("\"days\":null}"), std::string::npos);
+  EXPECT_EQ(single.str().find("\"windows\""), std::string::npos);
+}
+
+TEST(ExportWriterTest, IncludesRollupInJson) {
+  Rollup rollup;
+  rollup.period = RollupPeriod::kMonth;
+  RollupBucket bucket;
+  bucket.first_day = absl::CivilDay(2026, 1, 1);
+  bucket.last_day = absl::CivilDay(2026, 1, 31);
+  bucket.summary.count = 2;
+  bucket.summary.average_mood = 15;
+  bucket.summary.best.mood = 20;
+  bucket.summary.worst.mood = 10;
+  bucket.days_with_entries = 2;
+  bucket.days_in_range = 31;
+  rollup.buckets.push_back(bucket);
+
+  std::ostringstream out;
+  ExportWriter writer(ExportFormat::kJson, &out);
+  writer.Begin({{7, SummaryStats()}}, StreakStats(), &rollup);
+  writer.Finish();
+  EXPECT_NE(out.str().find("  \"rollup\": {\"by\":\"month\", \"buckets\": [\n"
+                           "    {\"label\":\"2026-01\",\"first\":\"2026-01-01\","
+                           "\"last\":\"2026-01-31\",\"count\":2,\"average_mood\":15.0,"
+                           "\"stddev\":0.0,\"min\":10,\"max\":20,\"days_with_entries\":2,"
+                           "\"days_in_range\":31}\n  ]},\n  \"entries\": ["),
+            std::string::npos);
+}
+
+TEST(ExportWriterTest, IncludesTrendInJson) {
+  const std::vector<EntryView> entries = {View("2026-01-01", 10, ""), View("2026-01-02", 30, "")};
+  const Trend trend = TrendEntries(entries, entries.front().day, entries.back().day);
+  std::ostringstream out;
+  ExportWriter writer(ExportFormat::kJson, &out);
+  writer.Begin({{7, SummaryStats()}}, StreakStats(), nullptr, &trend);
+  writer.Finish();
+  EXPECT_NE(out.str().find("  \"trend\": {\"slope_per_day\":20.0000, \"days\": [\n"
+                           "    {\"date\":\"2026-01-01\",\"count\":1,\"average\":10.00,"
+                           "\"ma7\":10.00,\"sd7\":0.00,\"ma30\":10.00,\"sd30\":0.00},\n"
+                           "    {\"date\":\"2026-01-02\",\"count\":1,\"average\":30.00,"
+                           "\"ma7\":20.00,\"sd7\":10.00,\"ma30\":20.00,\"sd30\":10.00}\n"
+                           "  ]},\n  \"entries\": ["),
+            std::string::npos)
+      << out.str();
+
+  std::ostringstream empty;
+  ExportWriter empty_writer(ExportFormat::kJson, &empty);
+  const Trend no_trend;
+  empty_writer.Begin({{7, SummaryStats()}}, StreakStats(), nullptr, &no_trend);
+  empty_writer.Finish();
+  EXPECT_NE(empty.str().find("  \"trend\": {\"slope_per_day\":null, \"days\": []},\n"),
+            std::string::npos);
+}
+
+TEST(ExportWriterTest, WritesOneJsonObjectPerLine) {
+  EXPECT_EQ(Export(ExportFormat::kNdjson, {View("2026-01-01", 10, "line\nbreak"),
+                                           View("2026-01-02", 20, "x")}),
+            "{\"date\":\"2026-01-01\",\"mood\":10,\"note\":\"line\\nbreak\"}\n"
+            "{\"date\":\"2026-01-02\",\"mood\":20,\"note\":\"x\"}\n");
+  EXPECT_EQ(Export(ExportFormat::kNdjson, {}), "");
+}
+
+TEST(ExportWriterTest, CsvRoundTripsThroughTheScanner) {
+  const std::vector<std::string> notes = {"",           "plain", "a, b", "say \"hi\"",
+                                          "two\nlines", "\"",    ",\r"};
+  std::vector<EntryView> entries;
+  for (size_t i = 0; i < notes.size(); ++i) {
+    entries.push_back(View("2026-01-01", static_cast<int>(i + 1), notes[i]));
+  }
+  const std::string csv = Export(ExportFormat::kCsv, entries);
+
+  CsvScanner scanner(csv);
+  EntryView view;
+  std::string unescaped;
+  size_t i = 0;
+  while (scanner.Next(&view, &unescaped)) {
+    ASSERT_LT(i, notes.size());
+    EXPECT_EQ(view.date, "2026-01-01");
+    EXPECT_EQ(view.mood, static_cast<int>(i + 1));
+    EXPECT_EQ(view.note, notes[i]);
+    ++i;
+  }
+  EXPECT_EQ(i, notes.size());
+}
+
+// Records the size of each write the stream receives.
+class WriteSizes : public std::streambuf {
+ public:
+  std::vector<std::streamsize> sizes;
+
+ protected:
+  std::streamsize xsputn(const char* data, std::streamsize size) override {
+    (void)data;
+    sizes.push_back(size);
+    return size;
+  }
+};
+
+TEST(ExportWriterTest, WritesLargeExportsInBoundedPieces) {
+  const std::string note(1000, 'n');
+  WriteSizes sizes;
+  std::ostream out(&sizes);
+  ExportWriter writer(ExportFormat::kNdjson, &out);
+  writer.Begin({{7, SummaryStats()}}, StreakStats());
+  for (int i = 0; i < 5000; ++i) writer.Add(View("2026-01-01", 50, note));
+  writer.Finish();
+
+  std::streamsize total = 0;
+  for (const std::streamsize size : sizes.sizes) {
+    EXPECT_LE(size, (1 << 20) + 2048);
+    total += size;
+  }
+  EXPECT_GE(sizes.sizes.size(), 4u);
+  EXPECT_EQ(static_cast<uint64_t>(total), writer.bytes_written());
+  EXPECT_EQ(writer.bytes_written(),
+            5000u * Export(ExportFormat::kNdjson, {View("2026-01-01", 50, note)}).size());
+}
+
+TEST(ExportWriterTest, ReportsStreamFailure) {
+  std::ostringstream out;
+  out.setstate(std::ios::badbit);
+  ExportWriter writer(ExportFormat::kCsv, &out);
+  writer.Begin({{7, SummaryStats()}}, StreakStats());
+  writer.Add(View("2026-01-01", 10, ""));
+  EXPECT_THROW(writer.Finish(), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace life_tracker
@@ -1,156 +1,85 @@
 #include <algorithm>
-#include <cmath>
+#include <csignal>
 #include <cstdlib>
 #include <ctime>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
-#include "absl/strings/str_format.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "src/command_output.h"
+#include "src/compaction.h"
+#include "src/csv_scanner.h"
+#include "src/dashboard_data.h"
+#include "src/date.h"
+#include "src/export_writer.h"
+#include "src/note_index.h"
+#include "src/partitions.h"
 #include "src/path_utils.h"
+#include "src/report.h"
+#include "src/rollup.h"
+#include "src/serve.h"
 #include "src/stats.h"
+#include "src/trace.h"
 #include "src/tracker.h"
+#include "src/trend.h"
 
 ABSL_FLAG(int, mood, 0, "Mood rating 1..100");
 ABSL_FLAG(std::string, note, "", "Free-form note");
 ABSL_FLAG(std::string, date, "", "Date in YYYY-MM-DD (default: today)");
 ABSL_FLAG(std::string, data_path, "data/entries.csv", "Path to entries CSV");
-ABSL_FLAG(int, days, 7, "Number of days to include in reports");
+ABSL_FLAG(std::string, days, "",
+          "Number of days to include in reports (default 7; search covers all history unless it "
+          "is given); summary/export/dashboard also take a list such as 7,30,all (all = all time)");
 ABSL_FLAG(std::string, out, "report.html",
           "Where to write generated reports/exports/dashboard data");
-ABSL_FLAG(std::string, format, "json", "Export format (currently: json)");
+ABSL_FLAG(std::string, format, "json", "Export format: json, ndjson or csv");
+ABSL_FLAG(std::string, from, "",
+          "report/export: first day of the date window, YYYY-MM-DD (default: --days before --to)");
+ABSL_FLAG(std::string, to, "", "report/export: last day of the date window (default: today)");
+ABSL_FLAG(int, max_points, 0,
+          "report: most points to chart; longer ranges are downsampled keeping peaks and troughs "
+          "(0 = one per pixel column of the chart)");
+ABSL_FLAG(std::string, by, "",
+          "rollup: calendar bucket, week, month or year (default: month); report/export: also "
+          "include a rollup by this bucket");
 ABSL_FLAG(bool, open, true, "Whether to open the dashboard URL after export");
 ABSL_FLAG(std::string, url, "http://localhost:3000", "Dashboard URL to open when --open=true");
+ABSL_FLAG(bool, mmap, true, "Memory-map the data file instead of reading it into memory");
+ABSL_FLAG(int, limit, 0,
+          "Maximum number of entries to list or search results to print (0 = all)");
+ABSL_FLAG(bool, assume_sorted, false,
+          "The data file is in date order, so summary/report read only its recent tail");
+ABSL_FLAG(std::string, merge, "keep",
+          "compact: what to do with several entries on one day: keep, dedupe, first, last or "
+          "mean");
+ABSL_FLAG(int, compact_threshold, 0,
+          "add: compact the data file once this many entries are out of date order (0 = never)");
+ABSL_FLAG(bool, stdin, false, "add: read date,mood,note CSV records from stdin as one batch");
+ABSL_FLAG(std::string, sync, "batch",
+          "When appends reach stable storage: none, batch (fsync per add) or interval");
+ABSL_FLAG(int, sync_interval_ms, 1000, "Minimum time between fsyncs with --sync=interval");
+ABSL_FLAG(int, threads, 0, "Threads used to parse the data file (0 = one per hardware thread)");
+ABSL_FLAG(std::string, socket, "",
+          "Unix socket of the `life serve` daemon (default: --data_path plus \".sock\")");
+ABSL_FLAG(std::string, trace, "",
+          "Write Chrome trace-event JSON timing each phase of the command to this path");
+ABSL_FLAG(bool, forward, true,
+          "Send add/list/summary/streak/export/compact to a running `life serve` daemon when there "
+          "is one");
 
 namespace life_tracker {
 namespace {
 
-std::string RenderSvg(const std::vector<DayMood>& samples) {
-  if (samples.empty()) {
-    return "<div class=\"empty\">No data to chart.</div>";
-  }
-
-  const int min_mood = 1;
-  const int max_mood = 100;
-  const double mood_range = static_cast<double>(max_mood - min_mood);
-
-  const int width = 720;
-  const int height = 360;
-  const int padding = 48;
-  const int plot_width = width - 2 * padding;
-  const int plot_height = height - 2 * padding;
-
-  const double x_step =
-      samples.size() > 1 ? static_cast<double>(plot_width) / (samples.size() - 1) : 0.0;
-
-  auto MoodToY = [&](int mood) {
-    const double clamped = std::min(std::max(mood, min_mood), max_mood);
-    const double normalized = (max_mood - clamped) / mood_range;  // 0 at max, 1 at min.
-    return padding + normalized * plot_height;
-  };
-
-  std::ostringstream points;
-  for (size_t i = 0; i < samples.size(); ++i) {
-    const double x = padding + x_step * i;
-    const double y = MoodToY(samples[i].mood);
-    points << x << "," << y;
-    if (i + 1 < samples.size()) points << " ";
-  }
-
-  std::ostringstream circles;
-  for (size_t i = 0; i < samples.size(); ++i) {
-    const double x = padding + x_step * i;
-    const double y = MoodToY(samples[i].mood);
-    circles << "<circle cx=\"" << x << "\" cy=\"" << y
-            << "\" r=\"5\" fill=\"#2563eb\" stroke=\"white\" stroke-width=\"2\"></circle>";
-  }
-
-  std::ostringstream svg;
-  svg << "<svg width=\"" << width << "\" height=\"" << height << "\" viewBox=\"0 0 " << width << " "
-      << height << "\" role=\"img\" "
-      << "aria-label=\"Mood over time (1-100)\">";
-  svg << "<rect x=\"0\" y=\"0\" width=\"" << width << "\" height=\"" << height
-      << "\" fill=\"#f8fafc\" />";
-  svg << "<polyline fill=\"none\" stroke=\"#2563eb\" stroke-width=\"3\" points=\"" << points.str()
-      << "\"></polyline>";
-  svg << circles.str();
-  svg << "<text x=\"" << padding << "\" y=\"" << height - padding / 3
-      << "\" fill=\"#475569\" font-family=\"Helvetica, Arial, sans-serif\" "
-         "font-size=\"12\">Older</text>";
-  svg << "<text x=\"" << width - padding << "\" y=\"" << height - padding / 3
-      << "\" fill=\"#475569\" font-family=\"Helvetica, Arial, sans-serif\" font-size=\"12\" "
-      << "text-anchor=\"end\">Newer</text>";
-  svg << "<text x=\"" << padding << "\" y=\"" << padding / 1.8
-      << "\" fill=\"#475569\" font-family=\"Helvetica, Arial, sans-serif\" font-size=\"12\">Mood "
-         "(1-100)</text>";
-  svg << "</svg>";
-  return svg.str();
-}
-
-std::string BuildReportHtml(const std::vector<DayMood>& samples, const SummaryStats& summary,
-                            int days) {
-  std::ostringstream html;
-  html << "<!DOCTYPE html><html><head><meta charset=\"UTF-8\"><title>Life Tracker Report</title>";
-  html << "<style>"
-       << "body{font-family:Helvetica,Arial,sans-serif;background:#0f172a;color:#e2e8f0;"
-          "margin:0;padding:32px;}"
-       << "h1{margin:0 0 8px 0;font-size:28px;}"
-       << "p.lead{margin:0 0 24px 0;color:#cbd5e1;}"
-       << ".cards{display:grid;grid-template-columns:repeat(auto-fit,minmax(200px,1fr));"
-          "gap:16px;margin-bottom:24px;}"
-       << ".card{background:#1e293b;border:1px solid #334155;border-radius:12px;padding:16px;"
-          "box-shadow:0 10px 30px rgba(0,0,0,0.3);}"
-       << ".label{font-size:12px;letter-spacing:0.08em;text-transform:uppercase;color:#94a3b8;"
-          "margin-bottom:6px;display:block;}"
-       << ".value{font-size:22px;font-weight:700;}"
-       << ".chart{background:#fff;border-radius:12px;border:1px solid #e2e8f0;"
-          "padding:12px;}"
-       << ".chart h2{color:#0f172a;margin:0 0 8px 0;}"
-       << ".empty{color:#334155;font-style:italic;}"
-       << "</style></head><body>";
-  html << "<h1>Life Tracker Report</h1>";
-  html << "<p class=\"lead\">Last " << days << " day";
-  if (days != 1) html << "s";
-  html << " of mood entries.</p>";
-
-  html << "<div class=\"cards\">";
-  html << "<div class=\"card\"><span class=\"label\">Entries</span><div class=\"value\">"
-       << summary.count << "</div></div>";
-  html << "<div class=\"card\"><span class=\"label\">Average Mood</span><div class=\"value\">";
-  if (summary.has_data) {
-    html << absl::StrFormat("%.2f", summary.average_mood);
-  } else {
-    html << "n/a";
-  }
-  html << "</div></div>";
-  html << "<div class=\"card\"><span class=\"label\">Best Day</span><div class=\"value\">";
-  if (summary.has_data) {
-    html << absl::FormatCivilTime(summary.best.day) << " (" << summary.best.mood << ")";
-  } else {
-    html << "n/a";
-  }
-  html << "</div></div>";
-  html << "<div class=\"card\"><span class=\"label\">Toughest Day</span><div class=\"value\">";
-  if (summary.has_data) {
-    html << absl::FormatCivilTime(summary.worst.day) << " (" << summary.worst.mood << ")";
-  } else {
-    html << "n/a";
-  }
-  html << "</div></div>";
-  html << "</div>";
-
-  html << "<div class=\"chart\"><h2>Mood Over Time</h2>" << RenderSvg(samples) << "</div>";
-
-  html << "</body></html>";
-  return html.str();
-}
-
 std::string TodayIsoDate() {
   std::time_t t = std::time(nullptr);
   std::tm tm{};
@@ -164,45 +93,248 @@ std::string TodayIsoDate() {
   return std::string(buf);
 }
 
+LoadOptions CommandLoadOptions(bool load_notes = true) {
+  LoadOptions options;
+  options.use_mmap = absl::GetFlag(FLAGS_mmap);
+  options.load_notes = load_notes;
+  options.threads = absl::GetFlag(FLAGS_threads);
+  return options;
+}
+
+AppendOptions CommandAppendOptions() {
+  AppendOptions options;
+  options.sync = ParseSyncPolicy(absl::GetFlag(FLAGS_sync));
+  options.sync_interval_ms = absl::GetFlag(FLAGS_sync_interval_ms);
+  return options;
+}
+
+// Reads date,mood,note records in the data file's CSV format; an empty date means today.
+std::vector<Entry> ReadEntriesFromStdin() {
+  std::ostringstream buffer;
+  buffer << std::cin.rdbuf();
+  const std::string data = buffer.str();
+
+  std::vector<Entry> entries;
+  CsvScanner scanner(data);
+  EntryView view;
+  std::string unescaped;
+  const std::string today = TodayIsoDate();
+  while (scanner.Next(&view, &unescaped)) {
+    Entry entry = view.ToEntry();
+    if (entry.date.empty()) entry.date = today;
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+// The windows listed by --days, 0 meaning all time; 7 days if it is not set.
+std::vector<int> DayWindowsFromFlag() {
+  const std::string days = absl::GetFlag(FLAGS_days);
+  return ParseDayWindows(days.empty() ? "7" : days);
+}
+
+// --days for commands that cover a single window of days.
+int DaysFromFlag() {
+  const std::vector<int> windows = DayWindowsFromFlag();
+  if (windows.size() != 1 || windows[0] == 0) {
+    throw std::runtime_error("--days must be a single number of days for this command.");
+  }
+  return windows[0];
+}
+
+// Reads the inclusive [*from, *to] day window from --from/--to. An unset --to means `today` and an
+// unset --from means `days` days up to --to (0 = all time is not a window, so --from is then
+// required). Returns false if neither flag is set.
+bool DateWindowFromFlags(int days, absl::CivilDay today, int32_t* from, int32_t* to) {
+  const std::string from_flag = absl::GetFlag(FLAGS_from);
+  const std::string to_flag = absl::GetFlag(FLAGS_to);
+  if (from_flag.empty() && to_flag.empty()) return false;
+  if (from_flag.empty() && days <= 0) {
+    throw std::runtime_error("--to without --from needs --days to be a number of days.");
+  }
+
+  *to = to_flag.empty() ? DayNumberFromCivilDay(today) : ParseIsoDate(to_flag);
+  if (*to == kInvalidDay) throw std::runtime_error("--to must be a valid YYYY-MM-DD.");
+  *from = from_flag.empty() ? *to - (days - 1) : ParseIsoDate(from_flag);
+  if (*from == kInvalidDay) throw std::runtime_error("--from must be a valid YYYY-MM-DD.");
+  if (*from > *to) throw std::runtime_error("--from must not be after --to.");
+  return true;
+}
+
+// Whether `data_path` is a file in date order: as --assume_sorted says, or as its order sidecar
+// records (written by compact and kept current by add).
+bool DataIsSorted(const std::string& data_path) {
+  if (absl::GetFlag(FLAGS_assume_sorted)) return true;
+  DataOrder order;
+  return !IsPartitionedDataPath(data_path) && DataOrder::ReadIfFresh(data_path, &order) &&
+         order.sorted();
+}
+
+// Load options for commands that only look at the last `days` days of `data_path`. Partitioned
+// data is pruned to the months in the window whether or not it is sorted.
+LoadOptions RecentLoadOptions(const std::string& data_path, int days, absl::CivilDay today) {
+  LoadOptions options = CommandLoadOptions(/*load_notes=*/false);
+  if ((DataIsSorted(data_path) || IsPartitionedDataPath(data_path)) && days > 0) {
+    options.since_day = DayNumberFromCivilDay(today - (days - 1));
+  }
+  return options;
+}
+
+std::string SocketPathFor(const std::string& data_path) {
+  const std::string socket_flag = absl::GetFlag(FLAGS_socket);
+  return socket_flag.empty() ? DefaultSocketPath(data_path) : ResolveDataPath(socket_flag);
+}
+
+// Hands `command` to the `life serve` daemon for `data_path`, if one is running, and relays its
+// output. Returns false when the command should run in this process instead.
+bool ForwardToDaemon(const std::string& data_path, const std::string& command,
+                     std::vector<std::string> params, int* exit_code) {
+  if (!absl::GetFlag(FLAGS_forward)) return false;
+  std::vector<std::string> request = {command, "data_path", data_path};
+  request.insert(request.end(), std::make_move_iterator(params.begin()),
+                 std::make_move_iterator(params.end()));
+  TraceSpan span("forward");
+  std::vector<std::string> response;
+  const bool forwarded = ForwardRequest(SocketPathFor(data_path), request, &response);
+  span.Counter("forwarded", forwarded);
+  if (!forwarded) return false;
+  std::cout << response[1];
+  std::cerr << response[2];
+  *exit_code = std::atoi(response[0].c_str());
+  return true;
+}
+
 void PrintUsage() {
   std::cerr << "Usage:\n"
             << "  life add --mood=42 --note=\"text\" [--date=YYYY-MM-DD]\n"
-            << "  life list\n"
-            << "  life summary [--days=N]\n"
-            << "  life report [--days=N] [--out=PATH]\n"
-            << "  life export [--format=json] [--out=PATH]\n"
-            << "  life dashboard [--out=PATH] [--open=true] [--url=URL]\n"
+            << "  life add --stdin < entries.csv   (date,mood,note per line; one batch)\n"
+            << "  life list [--limit=N]\n"
+            << "  life search \"TERMS\" [--days=N | --from=DATE --to=DATE] [--limit=N]   "
+               "(entries whose notes contain every term, newest first)\n"
+            << "  life summary [--days=N,...]   (one row per window, e.g. --days=7,30,all)\n"
+            << "  life rollup [--by=week|month|year] [--from=DATE] [--to=DATE]\n"
+            << "  life report [--days=N | --from=DATE --to=DATE] [--out=PATH] [--max_points=N]\n"
+            << "  life export [--format=json|ndjson|csv] [--from=DATE] [--to=DATE] [--out=PATH]\n"
+            << "  life dashboard [--out=DIR] [--open=true] [--url=URL]   (manifest.json and "
+               "monthly shards; default DIR: web/public/data)\n"
+            << "  life convert --out=PATH   (PATH ending in .lcol writes columnar data, else CSV)\n"
+            << "  life repartition --out=DIR   (one CSV per month at DIR/YYYY/MM.csv; use DIR as "
+               "--data_path)\n"
+            << "  life compact [--merge=keep|dedupe|first|last|mean]   (rewrite the data "
+               "file in date order, merging each day's entries as --merge says)\n"
+            << "  life serve   (keep --data_path loaded; other commands forward to it)\n"
             << "Flags:\n"
-            << "  --data_path=PATH   Where to store entries (default: data/entries.csv)\n"
-            << "  --days=N           Number of days to include in reports (default: 7)\n"
+            << "  --data_path=PATH   Where to store entries: a CSV or columnar .lcol file, or a "
+               "partitioned directory (default: data/entries.csv)\n"
+            << "  --days=N           Number of days to include in reports (default: 7); summary, "
+               "export and dashboard take a list such as 7,30,all\n"
+            << "  --from=YYYY-MM-DD  First day for report/export (default: --days before --to)\n"
+            << "  --to=YYYY-MM-DD    Last day for report/export (default: today)\n"
+            << "  --limit=N          Newest entries to list (reads only the end of the file) or "
+               "search results to print (default: 0 = all)\n"
+            << "  --assume_sorted    Data is in date order; summary/report read only the "
+               "recent tail (implied after compact until an add is back-dated)\n"
+            << "  --merge=POLICY     What compact does with a day's entries: keep, dedupe, "
+               "first, last or mean (default: keep)\n"
+            << "  --compact_threshold=N  add compacts the data file once N entries are out of "
+               "date order (default: 0 = never)\n"
             << "  --out=PATH         Where to write reports/exports (default: report.html)\n"
-            << "  --format=FORMAT    Export format (default: json)\n"
+            << "  --format=FORMAT    Export format: json, ndjson or csv (default: json)\n"
+            << "  --max_points=N     Most points in the report chart; longer ranges are "
+               "downsampled keeping peaks and troughs (default: 0 = chart width)\n"
+            << "  --by=PERIOD        Rollup bucket: week, month or year; report/export include "
+               "the rollup when set (rollup default: month)\n"
             << "  --open=true/false  Open dashboard URL after exporting data (default: true)\n"
             << "  --url=URL          Dashboard URL to open when --open=true (default: "
-               "http://localhost:3000)\n";
+               "http://localhost:3000)\n"
+            << "  --sync=POLICY      When adds are fsynced: none, batch or interval "
+               "(default: batch)\n"
+            << "  --sync_interval_ms=N  Minimum time between fsyncs with --sync=interval "
+               "(default: 1000)\n"
+            << "  --mmap=true/false  Memory-map the data file when loading (default: true)\n"
+            << "  --threads=N        Threads used to parse the data file (default: 0 = all "
+               "cores)\n"
+            << "  --socket=PATH      Socket of the serve daemon (default: --data_path + .sock)\n"
+            << "  --forward=true/false  Use a running serve daemon when there is one (default: "
+               "true)\n"
+            << "  --trace=PATH       Write a Chrome trace (chrome://tracing, ui.perfetto.dev) "
+               "timing each phase\n";
+}
+
+// Compacts the data file after an add if --compact_threshold entries are out of date order.
+void AutoCompact(Tracker* tracker, MergePolicy policy) {
+  const int threshold = absl::GetFlag(FLAGS_compact_threshold);
+  if (threshold <= 0) return;
+  const std::optional<CompactionStats> stats =
+      tracker->CompactIfOutOfOrder(static_cast<uint64_t>(threshold), policy, CommandLoadOptions());
+  if (stats) PrintCompacted(*stats, policy, std::cout);
 }
 
 int RunAdd(const std::vector<std::string>& args) {
   (void)args;  // subcommand-specific positional args currently unused.
 
-  const int mood = absl::GetFlag(FLAGS_mood);
-  const std::string note = absl::GetFlag(FLAGS_note);
-  std::string date = absl::GetFlag(FLAGS_date);
-  if (date.empty()) date = TodayIsoDate();
-
   const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
 
-  Tracker tracker(data_path);
-  tracker.Load();
+  // Parsed up front so a bad --merge fails before anything is appended.
+  const MergePolicy policy = ParseMergePolicy(absl::GetFlag(FLAGS_merge));
+  const std::vector<std::string> compact_params = {
+      "compact_threshold", std::to_string(absl::GetFlag(FLAGS_compact_threshold)), "merge",
+      MergePolicyName(policy)};
+
+  int exit_code = 0;
+  if (absl::GetFlag(FLAGS_stdin)) {
+    const std::vector<Entry> entries = ReadEntriesFromStdin();
+    std::string csv;
+    for (const Entry& entry : entries) csv += entry.ToCsv() + "\n";
+    std::vector<std::string> params = {"entries", csv};
+    params.insert(params.end(), compact_params.begin(), compact_params.end());
+    if (ForwardToDaemon(data_path, "add", std::move(params), &exit_code)) return exit_code;
+
+    // Appending needs nothing from the existing entries, so the data file is never loaded.
+    Tracker tracker(data_path, CommandAppendOptions());
+    tracker.AddBatch(entries);
+    tracker.Close();  // Surfaces a failed sync before reporting success.
+    PrintAddedCount(entries.size(), std::cout);
+    AutoCompact(&tracker, policy);
+    return 0;
+  }
+
+  std::string date = absl::GetFlag(FLAGS_date);
+  if (date.empty()) date = TodayIsoDate();
 
   Entry e;
   e.date = date;
-  e.mood = mood;
-  e.note = note;
-
+  e.mood = absl::GetFlag(FLAGS_mood);
+  e.note = absl::GetFlag(FLAGS_note);
+
+  std::vector<std::string> params = {"date", e.date, "mood", std::to_string(e.mood), "note",
+                                     e.note};
+  params.insert(params.end(), compact_params.begin(), compact_params.end());
+  if (ForwardToDaemon(data_path, "add", std::move(params), &exit_code)) {
+    return exit_code;
+  }
+  Tracker tracker(data_path, CommandAppendOptions());
   tracker.Add(e);
+  tracker.Close();
+
+  PrintAdded(e, std::cout);
+  AutoCompact(&tracker, policy);
+  return 0;
+}
+
+int RunCompact(const std::vector<std::string>& args) {
+  (void)args;
+
+  const MergePolicy policy = ParseMergePolicy(absl::GetFlag(FLAGS_merge));
+  const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
+  int exit_code = 0;
+  // A daemon keeps the file open for appends, so it has to be the one that replaces it.
+  if (ForwardToDaemon(data_path, "compact", {"merge", MergePolicyName(policy)}, &exit_code)) {
+    return exit_code;
+  }
 
-  std::cout << "Added: " << e.date << " mood=" << e.mood << " note=\"" << e.note << "\"\n";
+  Tracker tracker(data_path);
+  PrintCompacted(tracker.Compact(policy, CommandLoadOptions()), policy, std::cout);
   return 0;
 }
 
@@ -211,38 +343,96 @@ int RunList(const std::vector<std::string>& args) {
 
   const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
 
+  const int limit = std::max(absl::GetFlag(FLAGS_limit), 0);
+  int exit_code = 0;
+  if (ForwardToDaemon(data_path, "list", {"limit", std::to_string(limit)}, &exit_code)) {
+    return exit_code;
+  }
+
+  LoadOptions options = CommandLoadOptions();
+  options.limit = static_cast<size_t>(limit);
+
   Tracker tracker(data_path);
-  tracker.Load();
+  tracker.Load(options);
 
-  const auto& entries = tracker.Entries();
-  if (entries.empty()) {
-    std::cout << "No entries yet.\n";
-    return 0;
+  PrintEntryList(tracker.Views(), std::cout);
+  return 0;
+}
+
+int RunSearch(const std::vector<std::string>& args) {
+  std::string query;
+  for (const std::string& arg : args) query += (query.empty() ? "" : " ") + arg;
+  if (TokenizeNote(query).empty()) {
+    throw std::runtime_error("search needs at least one term, e.g. life search \"gym\".");
   }
+  const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
+  const int limit = std::max(absl::GetFlag(FLAGS_limit), 0);
+  const int days = DaysFromFlag();
+  const absl::CivilDay today = absl::ToCivilDay(absl::Now(), absl::UTCTimeZone());
 
-  // Newest last in file; print newest-first.
-  for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
-    std::cout << it->date << "  mood=" << it->mood << "  " << it->note << "\n";
+  int32_t from = std::numeric_limits<int32_t>::min();
+  int32_t to = std::numeric_limits<int32_t>::max();
+  std::vector<std::string> params = {"query", query, "limit", std::to_string(limit)};
+  bool windowed = DateWindowFromFlags(days, today, &from, &to);
+  // Unlike the reports, search covers all history unless --days is set.
+  if (!windowed && !absl::GetFlag(FLAGS_days).empty()) {
+    to = DayNumberFromCivilDay(today);
+    from = to - (days - 1);
+    windowed = true;
   }
+  if (windowed) {
+    params.insert(params.end(), {"from", absl::FormatCivilTime(CivilDayFromDayNumber(from)),
+                                 "to", absl::FormatCivilTime(CivilDayFromDayNumber(to))});
+  }
+  int exit_code = 0;
+  if (ForwardToDaemon(data_path, "search", std::move(params), &exit_code)) return exit_code;
+
+  Tracker tracker(data_path);
+  PrintSearchResults(
+      tracker.Search(query, from, to, static_cast<size_t>(limit), CommandLoadOptions()),
+      std::cout);
   return 0;
 }
 
 int RunReport(const std::vector<std::string>& args) {
   (void)args;
 
-  const int days = absl::GetFlag(FLAGS_days);
+  int days = DaysFromFlag();
+  const int max_points = absl::GetFlag(FLAGS_max_points);
+  if (max_points < 0) throw std::runtime_error("--max_points must not be negative.");
   const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
   const std::string out_path = ResolveDataPath(absl::GetFlag(FLAGS_out));
 
+  absl::CivilDay today = absl::ToCivilDay(absl::Now(), absl::UTCTimeZone());
+  int32_t from = 0;
+  int32_t to = 0;
+  if (DateWindowFromFlags(days, today, &from, &to)) {
+    today = CivilDayFromDayNumber(to);
+    days = to - from + 1;
+  }
   Tracker tracker(data_path);
-  tracker.Load();
+  // The moving averages of the first days reach back before the window.
+  tracker.Load(RecentLoadOptions(data_path, days + kLongTrendDays - 1, today));
 
-  const std::vector<DayMood> samples = CollectRecentSamples(
-      tracker.Entries(), days, absl::ToCivilDay(absl::Now(), absl::UTCTimeZone()));
+  const int32_t last = DayNumberFromCivilDay(today);
+  const std::vector<DayMood> samples =
+      CollectRecentSamples(tracker.Query(last - (days - 1), last), days, today);
 
   const SummaryStats summary = ComputeSummary(samples);
-  const std::string html = BuildReportHtml(samples, summary, days);
+  const Trend trend =
+      TrendEntries(tracker.Query(last - (days - 1) - (kLongTrendDays - 1), last),
+                   last - (days - 1), last);
+  const std::string by = absl::GetFlag(FLAGS_by);
+  std::optional<Rollup> rollup;
+  if (!by.empty()) {
+    rollup = RollupEntries(tracker.Query(last - (days - 1), last), ParseRollupPeriod(by));
+  }
+  const std::string html = BuildReportHtml(samples, summary, days,
+                                           static_cast<size_t>(max_points),
+                                           rollup ? &*rollup : nullptr, &trend);
 
+  TraceSpan write_span("write_report");
+  write_span.Counter("bytes", static_cast<int64_t>(html.size()));
   std::filesystem::path path(out_path);
   if (path.has_parent_path()) {
     std::filesystem::create_directories(path.parent_path());
@@ -270,115 +460,69 @@ bool OpenDashboardUrl(const std::string& url) {
   return rc == 0;
 }
 
-std::string JsonEscape(const std::string& s) {
-  std::string out;
-  out.reserve(s.size() + 8);
-  for (char c : s) {
-    switch (c) {
-      case '\"':
-        out += "\\\"";
-        break;
-      case '\\':
-        out += "\\\\";
-        break;
-      case '\b':
-        out += "\\b";
-        break;
-      case '\f':
-        out += "\\f";
-        break;
-      case '\n':
-        out += "\\n";
-        break;
-      case '\r':
-        out += "\\r";
-        break;
-      case '\t':
-        out += "\\t";
-        break;
-      default:
-        if (static_cast<unsigned char>(c) < 0x20) {
-          out += absl::StrFormat("\\u%04x", static_cast<int>(static_cast<unsigned char>(c)));
-        } else {
-          out.push_back(c);
-        }
-    }
-  }
-  return out;
-}
-
-std::string ExportEntriesToJson(const std::string& out_flag, const std::string& default_out,
-                                int summary_days, absl::CivilDay today) {
-  const std::string format = absl::GetFlag(FLAGS_format);
-  if (format != "json") {
-    throw std::runtime_error("Unsupported export format: " + format);
-  }
-
+// Writes the export in `format` to the resolved --out path, stored in `*out_path`, and returns
+// the exit code. Entries are streamed from the data file unless a window over unsorted data
+// needs them loaded and put in date order first.
+int WriteExport(ExportFormat format, const std::string& out_flag, const std::string& default_out,
+                absl::CivilDay today, std::string* out_path) {
   const std::string resolved_out_flag = (out_flag == "report.html") ? default_out : out_flag;
 
   const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
-  const std::string out_path = ResolveDataPath(resolved_out_flag);
+  *out_path = ResolveDataPath(resolved_out_flag);
+
+  int32_t from = 0;
+  int32_t to = 0;
+  const std::vector<int> windows = DayWindowsFromFlag();
+  const bool windowed = DateWindowFromFlags(windows[0], today, &from, &to);
+  const std::string by = absl::GetFlag(FLAGS_by);
+  std::vector<std::string> params = {"out", *out_path, "days", absl::GetFlag(FLAGS_days),
+                                     "format", ExportFormatName(format), "by", by};
+  if (windowed) {
+    params.insert(params.end(), {"from", absl::FormatCivilTime(CivilDayFromDayNumber(from)),
+                                 "to", absl::FormatCivilTime(CivilDayFromDayNumber(to))});
+  }
+  int exit_code = 0;
+  if (ForwardToDaemon(data_path, "export", std::move(params), &exit_code)) return exit_code;
 
   Tracker tracker(data_path);
-  tracker.Load();
-
-  const auto& entries = tracker.Entries();
-  const std::vector<DayMood> samples = CollectRecentSamples(entries, summary_days, today);
-  const SummaryStats summary = ComputeSummary(samples);
-  const StreakStats streak = ComputeStreaks(entries, today);
-
-  std::filesystem::path path(out_path);
-  if (path.has_parent_path()) {
-    std::filesystem::create_directories(path.parent_path());
+  const bool stream = !windowed || DataIsSorted(data_path);
+  if (!stream) tracker.Load(CommandLoadOptions());
+  const AggregateCache& aggregates = tracker.Aggregates(CommandLoadOptions());
+  // As in report, a window's summary and streak describe the exported entries only: one summary
+  // over the window's days, as of its last day.
+  const AggregateCache in_window = windowed ? aggregates.Between(from, to) : AggregateCache();
+  const AggregateCache& described = windowed ? in_window : aggregates;
+  const absl::CivilDay reference = windowed ? CivilDayFromDayNumber(to) : today;
+  const std::vector<WindowSummary> summaries = described.SummarizeWindows(
+      windowed ? std::vector<int>{to - from + 1} : windows, reference);
+  const StreakStats streak = described.Streaks(reference);
+  const int32_t first_day = windowed ? from : std::numeric_limits<int32_t>::min();
+  const int32_t last_day = windowed ? to : std::numeric_limits<int32_t>::max();
+  std::optional<Rollup> rollup;
+  if (!by.empty()) {
+    rollup = RollupDays(aggregates.days(), ParseRollupPeriod(by), first_day, last_day);
   }
-  std::ofstream out(out_path, std::ios::out | std::ios::trunc);
-  if (!out.is_open()) {
-    throw std::runtime_error("Failed to open export file for writing: " + out_path);
-  }
-
-  out << "{\n";
-  out << "  \"meta\": {\"generated_at\":\""
-      << JsonEscape(absl::FormatTime(absl::Now(), absl::UTCTimeZone()))
-      << "\", \"days\":" << summary_days << "},\n";
-
-  out << "  \"summary\": {\n";
-  out << "    \"has_data\":" << (summary.has_data ? "true" : "false") << ",\n";
-  out << "    \"count\":" << summary.count << ",\n";
-  out << "    \"average_mood\":" << absl::StrFormat("%.1f", summary.average_mood) << ",\n";
-  out << "    \"stddev\":" << absl::StrFormat("%.1f", summary.stddev) << ",\n";
-  out << "    \"best\":";
-  if (summary.has_data) {
-    out << "{\"date\":\"" << JsonEscape(absl::FormatCivilTime(summary.best.day))
-        << "\",\"mood\":" << summary.best.mood << "}";
-  } else {
-    out << "null";
-  }
-  out << ",\n";
-  out << "    \"worst\":";
-  if (summary.has_data) {
-    out << "{\"date\":\"" << JsonEscape(absl::FormatCivilTime(summary.worst.day))
-        << "\",\"mood\":" << summary.worst.mood << "}";
-  } else {
-    out << "null";
-  }
-  out << "\n  },\n";
-
-  out << "  \"streak\": {\"current\":" << streak.current_streak
-      << ", \"longest\":" << streak.longest_streak << "},\n";
-
-  out << "  \"entries\": [";
-  for (size_t i = 0; i < entries.size(); ++i) {
-    const Entry& e = entries[i];
-    out << "\n    {\"date\":\"" << JsonEscape(e.date) << "\",\"mood\":" << e.mood << ",\"note\":\""
-        << JsonEscape(e.note) << "\"}";
-    if (i + 1 < entries.size()) out << ",";
+  // Only JSON has room for the trend.
+  std::optional<Trend> trend;
+  if (format == ExportFormat::kJson) trend = TrendDays(aggregates.days(), first_day, last_day);
+  if (!stream) {
+    WriteExportFile(*out_path, format, tracker.Query(from, to), summaries, streak,
+                    rollup ? &*rollup : nullptr, trend ? &*trend : nullptr);
+    return 0;
   }
-  if (!entries.empty()) out << "\n";
-  out << "  ]\n";
-  out << "}\n";
-  out.close();
 
-  return out_path;
+  TraceSpan span("write_export");
+  std::ofstream out = OpenExportFile(*out_path);
+  ExportWriter writer(format, &out);
+  writer.Begin(summaries, streak, rollup ? &*rollup : nullptr, trend ? &*trend : nullptr);
+  LoadOptions options = CommandLoadOptions();
+  if (windowed) options.since_day = from;
+  tracker.Scan(options, [&](const EntryView& entry) {
+    if (!windowed || (entry.day >= from && entry.day <= to)) writer.Add(entry);
+  });
+  writer.Finish();
+  span.Counter("bytes", static_cast<int64_t>(writer.bytes_written()));
+  return 0;
 }
 
 int RunExport(const std::vector<std::string>& args) {
@@ -386,8 +530,12 @@ int RunExport(const std::vector<std::string>& args) {
 
   const std::string out_flag = absl::GetFlag(FLAGS_out);
   const absl::CivilDay today = absl::ToCivilDay(absl::Now(), absl::UTCTimeZone());
-  const int summary_days = absl::GetFlag(FLAGS_days);
-  const std::string out_path = ExportEntriesToJson(out_flag, "export.json", summary_days, today);
+  const std::string format_name = absl::GetFlag(FLAGS_format);
+  const ExportFormat format = ParseExportFormat(format_name);
+  std::string out_path;
+  const int exit_code =
+      WriteExport(format, out_flag, "export." + format_name, today, &out_path);
+  if (exit_code != 0) return exit_code;
 
   std::cout << "Export written to " << out_path << "\n";
   return 0;
@@ -398,14 +546,41 @@ int RunDashboard(const std::vector<std::string>& args) {
 
   const std::string out_flag = absl::GetFlag(FLAGS_out);
   const absl::CivilDay today = absl::ToCivilDay(absl::Now(), absl::UTCTimeZone());
-  const int summary_days = absl::GetFlag(FLAGS_days);
+  const std::vector<int> windows = DayWindowsFromFlag();
+  const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
   const std::string out_path =
-      ExportEntriesToJson(out_flag, "web/data/entries.json", summary_days, today);
+      ResolveDataPath(out_flag == "report.html" ? "web/public/data" : out_flag);
+
+  int32_t from = 0;
+  int32_t to = 0;
+  const bool windowed = DateWindowFromFlags(windows[0], today, &from, &to);
+  std::vector<std::string> params = {"out", out_path, "days", absl::GetFlag(FLAGS_days)};
+  if (windowed) {
+    params.insert(params.end(), {"from", absl::FormatCivilTime(CivilDayFromDayNumber(from)),
+                                 "to", absl::FormatCivilTime(CivilDayFromDayNumber(to))});
+  }
+  int exit_code = 0;
+  if (!ForwardToDaemon(data_path, "dashboard", std::move(params), &exit_code)) {
+    Tracker tracker(data_path);
+    tracker.Load(CommandLoadOptions());
+    const AggregateCache& aggregates = tracker.Aggregates();
+    if (!windowed) {
+      from = std::numeric_limits<int32_t>::min();
+      to = std::numeric_limits<int32_t>::max();
+    }
+    PrintDashboardWritten(WriteDashboardData(out_path, tracker.Query(from, to),
+                                             aggregates.SummarizeWindows(windows, today),
+                                             aggregates.Streaks(today),
+                                             TrendDays(aggregates.days(), from, to)),
+                          std::cout);
+  }
+  if (exit_code != 0) return exit_code;
 
   const bool should_open = absl::GetFlag(FLAGS_open);
   const std::string url = absl::GetFlag(FLAGS_url);
 
   if (should_open) {
+    TraceSpan span("open_browser");
     if (!OpenDashboardUrl(url)) {
       std::cerr << "Dashboard data written to " << out_path
                 << " but opening the browser failed. Open manually: " << url << "\n";
@@ -419,31 +594,74 @@ int RunDashboard(const std::vector<std::string>& args) {
 int RunSummary(const std::vector<std::string>& args) {
   (void)args;
 
-  const int days = absl::GetFlag(FLAGS_days);
+  const std::vector<int> windows = DayWindowsFromFlag();
   const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
 
+  int exit_code = 0;
+  if (ForwardToDaemon(data_path, "summary", {"days", absl::GetFlag(FLAGS_days)}, &exit_code)) {
+    return exit_code;
+  }
+
+  const absl::CivilDay today = absl::ToCivilDay(absl::Now(), absl::UTCTimeZone());
   Tracker tracker(data_path);
-  tracker.Load();
-
-  const std::vector<DayMood> samples = CollectRecentSamples(
-      tracker.Entries(), days, absl::ToCivilDay(absl::Now(), absl::UTCTimeZone()));
-  if (samples.empty()) {
-    std::cout << "No entries in the last " << days << " day";
-    if (days != 1) std::cout << "s";
-    std::cout << ".\n";
-    return 0;
+  std::vector<WindowSummary> summaries;
+  const int longest = *std::min_element(windows.begin(), windows.end()) == 0
+                          ? 0
+                          : *std::max_element(windows.begin(), windows.end());
+  // An all-time window reads the whole file, which the aggregate cache answers faster unless
+  // --assume_sorted asks for it.
+  if (absl::GetFlag(FLAGS_assume_sorted) || (longest > 0 && DataIsSorted(data_path))) {
+    // Only the records inside the longest window are read.
+    tracker.Load(RecentLoadOptions(data_path, longest, today));
+    summaries = ComputeWindowSummaries(tracker.Views(), windows, today);
+  } else {
+    summaries = tracker.Aggregates(CommandLoadOptions(/*load_notes=*/false))
+                    .SummarizeWindows(windows, today);
   }
+  PrintWindowSummaries(summaries, std::cout);
+  return 0;
+}
 
-  const SummaryStats summary = ComputeSummary(samples);
+int RunConvert(const std::vector<std::string>& args) {
+  (void)args;
 
-  std::cout << "Entries: " << summary.count << "\n";
-  std::cout << "Average mood: " << absl::StrFormat("%.1f", summary.average_mood) << "\n";
-  std::cout << "Best day: " << absl::FormatCivilTime(summary.best.day) << " (" << summary.best.mood
-            << ")\n";
-  std::cout << "Worst day: " << absl::FormatCivilTime(summary.worst.day) << " ("
-            << summary.worst.mood << ")\n";
-  std::cout << "Mood volatility (std dev): " << absl::StrFormat("%.1f", summary.stddev) << "\n";
+  const std::string out_flag = absl::GetFlag(FLAGS_out);
+  if (out_flag == "report.html") {
+    throw std::runtime_error("convert requires --out=PATH (.lcol for columnar, otherwise CSV).");
+  }
+  const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
+  const std::string out_path = ResolveDataPath(out_flag);
+  if (out_path == data_path) {
+    throw std::runtime_error("convert --out must differ from --data_path.");
+  }
 
+  Tracker tracker(data_path);
+  tracker.Load(CommandLoadOptions());
+  WriteDataFile(out_path, tracker.Views());
+
+  std::cout << "Converted " << tracker.Views().size() << " entries to " << out_path << "\n";
+  return 0;
+}
+
+int RunRepartition(const std::vector<std::string>& args) {
+  (void)args;
+
+  const std::string out_flag = absl::GetFlag(FLAGS_out);
+  if (out_flag == "report.html") {
+    throw std::runtime_error("repartition requires --out=DIR.");
+  }
+  const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
+  const std::string out_path = ResolveDataPath(out_flag);
+  if (out_path == data_path) {
+    throw std::runtime_error("repartition --out must differ from --data_path.");
+  }
+
+  Tracker tracker(data_path);
+  tracker.Load(CommandLoadOptions());
+  WritePartitionedData(out_path, tracker.Views());
+
+  std::cout << "Repartitioned " << tracker.Views().size() << " entries into " << out_path
+            << "\n";
   return 0;
 }
 
@@ -451,23 +669,110 @@ int RunStreak(const std::vector<std::string>& args) {
   (void)args;
 
   const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
+  int exit_code = 0;
+  if (ForwardToDaemon(data_path, "streak", {}, &exit_code)) return exit_code;
 
   Tracker tracker(data_path);
-  tracker.Load();
+  const StreakStats stats = tracker.Aggregates(CommandLoadOptions(/*load_notes=*/false))
+                                .Streaks(absl::ToCivilDay(absl::Now(), absl::UTCTimeZone()));
 
-  const StreakStats stats =
-      ComputeStreaks(tracker.Entries(), absl::ToCivilDay(absl::Now(), absl::UTCTimeZone()));
+  PrintStreaks(stats, std::cout);
+  return 0;
+}
+
+int RunRollup(const std::vector<std::string>& args) {
+  (void)args;
 
-  std::cout << "Current streak: " << stats.current_streak << " day";
-  if (stats.current_streak != 1) std::cout << "s";
-  std::cout << "\n";
-  std::cout << "Longest streak: " << stats.longest_streak << " day";
-  if (stats.longest_streak != 1) std::cout << "s";
-  std::cout << "\n";
+  const std::string by = absl::GetFlag(FLAGS_by);
+  const RollupPeriod period = ParseRollupPeriod(by.empty() ? "month" : by);
+  const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
+  const absl::CivilDay today = absl::ToCivilDay(absl::Now(), absl::UTCTimeZone());
+  int32_t from = std::numeric_limits<int32_t>::min();
+  int32_t to = std::numeric_limits<int32_t>::max();
+  std::vector<std::string> params = {"by", RollupPeriodName(period)};
+  if (DateWindowFromFlags(DaysFromFlag(), today, &from, &to)) {
+    params.insert(params.end(), {"from", absl::FormatCivilTime(CivilDayFromDayNumber(from)),
+                                 "to", absl::FormatCivilTime(CivilDayFromDayNumber(to))});
+  }
+  int exit_code = 0;
+  if (ForwardToDaemon(data_path, "rollup", std::move(params), &exit_code)) return exit_code;
 
+  // The per-day aggregates are already date-sorted, so this never loads the entries.
+  Tracker tracker(data_path);
+  const AggregateCache& aggregates = tracker.Aggregates(CommandLoadOptions(/*load_notes=*/false));
+  PrintRollup(RollupDays(aggregates.days(), period, from, to), std::cout);
   return 0;
 }
 
+Server* active_server = nullptr;
+
+void StopActiveServer(int signal) {
+  (void)signal;
+  if (active_server != nullptr) active_server->Stop();
+}
+
+int RunServe(const std::vector<std::string>& args) {
+  (void)args;
+
+  const std::string data_path = ResolveDataPath(absl::GetFlag(FLAGS_data_path));
+  const std::string socket_path = SocketPathFor(data_path);
+
+  Server server(data_path, CommandAppendOptions());
+  active_server = &server;
+  std::signal(SIGINT, StopActiveServer);
+  std::signal(SIGTERM, StopActiveServer);
+
+  std::cout << "Serving " << data_path << " on " << socket_path << "\n" << std::flush;
+  server.Serve(socket_path);
+  active_server = nullptr;
+  return 0;
+}
+
+// Runs `command`, or prints usage if there is no such command. Returns the exit code.
+int RunCommand(const std::string& command, const std::vector<std::string>& positional) {
+  if (command == "add") {
+    return RunAdd(positional);
+  }
+  if (command == "list") {
+    return RunList(positional);
+  }
+  if (command == "search") {
+    return RunSearch(positional);
+  }
+  if (command == "summary") {
+    return RunSummary(positional);
+  }
+  if (command == "report") {
+    return RunReport(positional);
+  }
+  if (command == "export") {
+    return RunExport(positional);
+  }
+  if (command == "dashboard") {
+    return RunDashboard(positional);
+  }
+  if (command == "streak") {
+    return RunStreak(positional);
+  }
+  if (command == "rollup") {
+    return RunRollup(positional);
+  }
+  if (command == "convert") {
+    return RunConvert(positional);
+  }
+  if (command == "compact") {
+    return RunCompact(positional);
+  }
+  if (command == "repartition") {
+    return RunRepartition(positional);
+  }
+  if (command == "serve") {
+    return RunServe(positional);
+  }
+  PrintUsage();
+  return 1;
+}
+
 }  // namespace
 }  // namespace life_tracker
 
@@ -485,33 +790,25 @@ int main(int argc, char* argv[]) {
     positional.emplace_back(remaining[i]);
   }
 
-  try {
-    if (command == "add") {
-      return life_tracker::RunAdd(positional);
-    }
-    if (command == "list") {
-      return life_tracker::RunList(positional);
-    }
-    if (command == "summary") {
-      return life_tracker::RunSummary(positional);
-    }
-    if (command == "report") {
-      return life_tracker::RunReport(positional);
+  const std::string trace_path = absl::GetFlag(FLAGS_trace);
+  if (!trace_path.empty()) life_tracker::StartTracing();
+  int exit_code = 0;
+  {
+    life_tracker::TraceSpan span(command.c_str());
+    try {
+      exit_code = life_tracker::RunCommand(command, positional);
+    } catch (const std::exception& e) {
+      std::cerr << "Error: " << e.what() << "\n";
+      exit_code = 2;
     }
-    if (command == "export") {
-      return life_tracker::RunExport(positional);
-    }
-    if (command == "dashboard") {
-      return life_tracker::RunDashboard(positional);
-    }
-    if (command == "streak") {
-      return life_tracker::RunStreak(positional);
+  }
+  if (!trace_path.empty()) {
+    try {
+      life_tracker::WriteTrace(life_tracker::ResolveDataPath(trace_path));
+    } catch (const std::exception& e) {
+      std::cerr << "Error: " << e.what() << "\n";
+      if (exit_code == 0) exit_code = 2;
     }
-  } catch (const std::exception& e) {
-    std::cerr << "Error: " << e.what() << "\n";
-    return 2;
   }
-
-  life_tracker::PrintUsage();
-  return 1;
+  return exit_code;
 }
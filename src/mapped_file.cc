@@ -0,0 +1,85 @@
+#include "src/mapped_file.h"
+
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace life_tracker {
+
+MappedFile::~MappedFile() { Close(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this == &other) return *this;
+  Close();
+  fallback_ = std::move(other.fallback_);
+  mapped_ = other.mapped_;
+  size_ = other.size_;
+  data_ = mapped_ ? other.data_ : fallback_.data();
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.mapped_ = false;
+  return *this;
+}
+
+void MappedFile::Close() {
+#if !defined(_WIN32)
+  if (mapped_) munmap(const_cast<char*>(data_), size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  fallback_.clear();
+}
+
+bool MappedFile::Open(const std::string& path) {
+  Close();
+
+#if !defined(_WIN32)
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    if (errno == ENOENT) return false;
+    throw std::runtime_error("Failed to open data file: " + path);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    throw std::runtime_error("Failed to stat data file: " + path);
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ == 0) {  // mmap rejects empty mappings.
+    close(fd);
+    return true;
+  }
+  void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    size_ = 0;
+    throw std::runtime_error("Failed to map data file: " + path);
+  }
+  madvise(addr, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<const char*>(addr);
+  mapped_ = true;
+  return true;
+#else
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) return false;
+  fallback_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  data_ = fallback_.data();
+  size_ = fallback_.size();
+  return true;
+#endif
+}
+
+}  // namespace life_tracker
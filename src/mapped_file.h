@@ -0,0 +1,38 @@
+#ifndef LIFE_TRACKER_MAPPED_FILE_H_
+#define LIFE_TRACKER_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace life_tracker {
+
+// Read-only, memory-mapped view of a whole file. On platforms without mmap(2) the file is read
+// into memory instead, so callers can treat both cases the same way.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  // Maps `path`, replacing any previous mapping. Returns false if the file does not exist; throws
+  // std::runtime_error if it exists but cannot be read.
+  bool Open(const std::string& path);
+  void Close();
+
+  std::string_view data() const { return std::string_view(data_, size_); }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  bool mapped_ = false;
+  std::string fallback_;  // Backing storage when the file was read rather than mapped.
+};
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_MAPPED_FILE_H_
@@ -0,0 +1,258 @@
+#include "src/note_index.h"
+
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <utility>
+
+#include "src/binary_io.h"
+#include "src/sidecar.h"
+#include "src/trace.h"
+
+namespace life_tracker {
+namespace {
+
+constexpr std::string_view kMagic = "LTNOTEIX";
+constexpr uint32_t kVersion = 1;
+
+bool IsTermByte(unsigned char c) {
+  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+}
+
+char FoldCase(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+// Calls `visit` with each term of `text`, lowercased into `*scratch`.
+template <typename Visit>
+void ForEachTerm(std::string_view text, std::string* scratch, Visit visit) {
+  size_t i = 0;
+  while (i < text.size()) {
+    while (i < text.size() && !IsTermByte(static_cast<unsigned char>(text[i]))) ++i;
+    if (i == text.size()) return;
+    scratch->clear();
+    while (i < text.size() && IsTermByte(static_cast<unsigned char>(text[i]))) {
+      scratch->push_back(FoldCase(text[i]));
+      ++i;
+    }
+    visit(*scratch);
+  }
+}
+
+void AppendVarint(std::string* out, uint32_t value) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// Decodes the varint at `*p`, which must lie before `end`, and advances past it. Returns false if
+// it is truncated or longer than a uint32_t.
+bool ReadVarint(const char** p, const char* end, uint32_t* value) {
+  uint32_t result = 0;
+  for (int shift = 0; shift < 35 && *p < end; shift += 7) {
+    const auto byte = static_cast<unsigned char>(*(*p)++);
+    result |= static_cast<uint32_t>(byte & 0x7f) << shift;
+    if (byte < 0x80) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+// True if `gaps` decodes to exactly `count` strictly ascending ids, the largest being `last`, all
+// below `entries`. Searches index per-entry arrays with decoded ids, so a sidecar must pass this
+// for every term.
+bool ValidPostings(std::string_view gaps, uint32_t count, uint32_t last, uint64_t entries) {
+  const char* p = gaps.data();
+  const char* end = p + gaps.size();
+  uint64_t id = 0;
+  uint32_t gap = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    if (!ReadVarint(&p, end, &gap) || (i > 0 && gap == 0)) return false;
+    id += gap;
+    if (id >= entries) return false;
+  }
+  return p == end && id == last;
+}
+
+}  // namespace
+
+std::vector<std::string> TokenizeNote(std::string_view text) {
+  std::vector<std::string> terms;
+  std::string scratch;
+  ForEachTerm(text, &scratch, [&](const std::string& term) { terms.push_back(term); });
+  return terms;
+}
+
+std::string NoteIndex::SidecarPath(const std::string& data_path) { return data_path + ".idx"; }
+
+bool NoteIndex::ReadIfFresh(const std::string& data_path, NoteIndex* index) {
+  TraceSpan span("read_note_index");
+  std::string contents;
+  std::string_view payload;
+  if (!ReadFreshSidecar(data_path, SidecarPath(data_path), kMagic, kVersion, &contents,
+                        &payload)) {
+    return false;
+  }
+  span.Counter("bytes", static_cast<int64_t>(contents.size()));
+
+  ByteReader reader(payload);
+  uint8_t has_offsets = 0;
+  uint64_t entries = 0;
+  if (!reader.Read(&has_offsets) || !reader.Read(&entries)) return false;
+  const size_t entry_size = sizeof(int32_t) + (has_offsets ? sizeof(uint64_t) : 0);
+  if (entries > reader.remaining() / entry_size) return false;
+
+  NoteIndex loaded;
+  loaded.has_offsets_ = has_offsets != 0;
+  loaded.days_.resize(entries);
+  for (int32_t& day : loaded.days_) reader.Read(&day);
+  if (loaded.has_offsets_) {
+    loaded.offsets_.resize(entries);
+    for (uint64_t& offset : loaded.offsets_) reader.Read(&offset);
+  }
+
+  uint64_t terms = 0;
+  if (!reader.Read(&terms) || terms > reader.remaining()) return false;
+  loaded.postings_.reserve(terms);
+  for (uint64_t i = 0; i < terms; ++i) {
+    uint32_t term_size = 0;
+    std::string_view term;
+    Postings postings;
+    uint64_t gaps_size = 0;
+    std::string_view gaps;
+    if (!reader.Read(&term_size) || !reader.ReadBytes(term_size, &term) ||
+        !reader.Read(&postings.count) || !reader.Read(&postings.last) ||
+        !reader.Read(&gaps_size) || !reader.ReadBytes(gaps_size, &gaps) ||
+        postings.count == 0 ||
+        !ValidPostings(gaps, postings.count, postings.last, entries)) {
+      return false;
+    }
+    postings.gaps = std::string(gaps);
+    loaded.postings_.emplace(std::string(term), std::move(postings));
+  }
+  span.Counter("entries", static_cast<int64_t>(entries));
+  span.Counter("terms", static_cast<int64_t>(terms));
+  *index = std::move(loaded);
+  return true;
+}
+
+bool NoteIndex::Save(const std::string& data_path, const DataFileStamp& stamp) const {
+  TraceSpan span("save_note_index");
+  std::string out;
+  AppendRaw<uint8_t>(&out, has_offsets_ ? 1 : 0);
+  AppendRaw<uint64_t>(&out, days_.size());
+  out.append(reinterpret_cast<const char*>(days_.data()), days_.size() * sizeof(int32_t));
+  if (has_offsets_) {
+    out.append(reinterpret_cast<const char*>(offsets_.data()), offsets_.size() * sizeof(uint64_t));
+  }
+  // Sorted so the same entries always produce the same bytes.
+  std::vector<const std::pair<const std::string, Postings>*> terms;
+  terms.reserve(postings_.size());
+  for (const auto& term : postings_) terms.push_back(&term);
+  std::sort(terms.begin(), terms.end(), [](const auto* a, const auto* b) {
+    return a->first < b->first;
+  });
+  AppendRaw<uint64_t>(&out, terms.size());
+  for (const auto* term : terms) {
+    AppendRaw<uint32_t>(&out, static_cast<uint32_t>(term->first.size()));
+    out += term->first;
+    AppendRaw<uint32_t>(&out, term->second.count);
+    AppendRaw<uint32_t>(&out, term->second.last);
+    AppendRaw<uint64_t>(&out, term->second.gaps.size());
+    out += term->second.gaps;
+  }
+  span.Counter("bytes", static_cast<int64_t>(out.size()));
+  return WriteSidecar(SidecarPath(data_path), stamp, kMagic, kVersion, out);
+}
+
+void NoteIndex::Add(int32_t day, std::string_view note, uint64_t offset) {
+  const auto id = static_cast<uint32_t>(days_.size());
+  days_.push_back(day);
+  if (offset == kNoOffset) {
+    has_offsets_ = false;
+    offsets_.clear();
+  } else if (has_offsets_) {
+    offsets_.push_back(offset);
+  }
+
+  std::string scratch;
+  ForEachTerm(note, &scratch, [&](const std::string& term) {
+    Postings& postings = postings_[term];
+    // A term repeated within the note is already posted.
+    if (postings.count > 0 && postings.last == id) return;
+    AppendVarint(&postings.gaps, id - (postings.count > 0 ? postings.last : 0));
+    ++postings.count;
+    postings.last = id;
+  });
+}
+
+std::vector<uint32_t> NoteIndex::Decode(const Postings& postings) {
+  std::vector<uint32_t> ids;
+  ids.reserve(postings.count);
+  const char* p = postings.gaps.data();
+  const char* end = p + postings.gaps.size();
+  uint32_t id = 0;
+  uint32_t gap = 0;
+  while (p < end && ReadVarint(&p, end, &gap)) {
+    id += gap;
+    ids.push_back(id);
+  }
+  return ids;
+}
+
+std::vector<uint32_t> NoteIndex::Search(std::string_view query, int32_t from_day, int32_t to_day,
+                                        size_t limit) const {
+  std::vector<const Postings*> lists;
+  std::string scratch;
+  bool missing = false;
+  ForEachTerm(query, &scratch, [&](const std::string& term) {
+    const auto it = postings_.find(term);
+    if (it == postings_.end()) {
+      missing = true;
+    } else {
+      lists.push_back(&it->second);
+    }
+  });
+  if (missing || lists.empty()) return {};
+
+  // Start from the rarest term so every later pass only filters a short candidate list, and
+  // stream the longer lists rather than decoding them into vectors.
+  std::sort(lists.begin(), lists.end(), [](const Postings* a, const Postings* b) {
+    return a->count != b->count ? a->count < b->count : std::less<const Postings*>()(a, b);
+  });
+  lists.erase(std::unique(lists.begin(), lists.end()), lists.end());  // Repeated terms.
+  std::vector<uint32_t> ids = Decode(*lists[0]);
+  for (size_t k = 1; k < lists.size() && !ids.empty(); ++k) {
+    const char* p = lists[k]->gaps.data();
+    const char* end = p + lists[k]->gaps.size();
+    uint32_t id = 0;
+    uint32_t gap = 0;
+    size_t kept = 0;
+    size_t i = 0;
+    while (i < ids.size() && p < end && ReadVarint(&p, end, &gap)) {
+      id += gap;
+      while (i < ids.size() && ids[i] < id) ++i;
+      if (i < ids.size() && ids[i] == id) ids[kept++] = ids[i++];
+    }
+    ids.resize(kept);
+  }
+
+  ids.erase(std::remove_if(ids.begin(), ids.end(),
+                           [&](uint32_t id) { return days_[id] < from_day || days_[id] > to_day; }),
+            ids.end());
+  const auto newer = [&](uint32_t a, uint32_t b) {
+    return days_[a] != days_[b] ? days_[a] > days_[b] : a > b;
+  };
+  if (limit > 0 && limit < ids.size()) {
+    std::partial_sort(ids.begin(), ids.begin() + static_cast<std::ptrdiff_t>(limit), ids.end(),
+                      newer);
+    ids.resize(limit);
+  } else {
+    std::sort(ids.begin(), ids.end(), newer);
+  }
+  return ids;
+}
+
+}  // namespace life_tracker
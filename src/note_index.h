@@ -0,0 +1,73 @@
+#ifndef LIFE_TRACKER_NOTE_INDEX_H_
+#define LIFE_TRACKER_NOTE_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "src/sidecar.h"
+
+namespace life_tracker {
+
+// Splits `text` into lowercased search terms: maximal runs of ASCII letters and digits and of
+// non-ASCII bytes, so UTF-8 words stay whole. Only ASCII letters are case-folded.
+std::vector<std::string> TokenizeNote(std::string_view text);
+
+// Inverted index over the notes of a data file. Entries are identified by their position in file
+// order; each term maps to the ascending ids of the entries whose note contains it, stored as
+// varint-encoded gaps. The index also keeps each entry's day, so searches filter and rank by
+// date without touching the data file, and for CSV data each record's byte offset, so the
+// matching records can be read on their own. Persisted in a sidecar next to the data file.
+class NoteIndex {
+ public:
+  static constexpr uint64_t kNoOffset = std::numeric_limits<uint64_t>::max();
+
+  static std::string SidecarPath(const std::string& data_path);
+
+  // Reads the sidecar of `data_path` into `*index` if it is fresh (see ReadFreshSidecar()).
+  static bool ReadIfFresh(const std::string& data_path, NoteIndex* index);
+  // Writes the sidecar of `data_path`, stamped with `stamp`, the version of the data file this
+  // was built from (see WriteSidecar()).
+  bool Save(const std::string& data_path, const DataFileStamp& stamp) const;
+
+  // Indexes the next entry in file order. `offset` is where its record starts in a CSV data
+  // file; once any entry comes without one, the index keeps no offsets at all.
+  void Add(int32_t day, std::string_view note, uint64_t offset = kNoOffset);
+
+  // Ids of the entries whose notes contain every term of `query` (see TokenizeNote()) and that
+  // are dated from `from_day` to `to_day` inclusive, newest first and in reverse file order
+  // within a day. At most `limit` ids are returned (0 = all). A query without terms matches
+  // nothing.
+  std::vector<uint32_t> Search(std::string_view query, int32_t from_day, int32_t to_day,
+                               size_t limit = 0) const;
+
+  size_t size() const { return days_.size(); }
+  size_t term_count() const { return postings_.size(); }
+  int32_t day(uint32_t id) const { return days_[id]; }
+  bool has_offsets() const { return has_offsets_; }
+  // Requires has_offsets().
+  uint64_t offset(uint32_t id) const { return offsets_[id]; }
+
+ private:
+  struct Postings {
+    std::string gaps;     // Varint-encoded differences between successive ids, the first from 0.
+    uint32_t count = 0;
+    uint32_t last = 0;    // Largest id, the base of the next gap.
+  };
+
+  // Returns the ids in `postings` in ascending order.
+  static std::vector<uint32_t> Decode(const Postings& postings);
+
+  std::vector<int32_t> days_;
+  std::vector<uint64_t> offsets_;
+  bool has_offsets_ = true;
+  absl::flat_hash_map<std::string, Postings> postings_;
+};
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_NOTE_INDEX_H_
@@ -0,0 +1,194 @@
+#include "src/note_index.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/date.h"
+#include "src/test_util.h"
+#include "src/tracker.h"
+
+namespace life_tracker {
+namespace {
+
+constexpr int32_t kAllDays = std::numeric_limits<int32_t>::max();
+constexpr int32_t kNoDays = std::numeric_limits<int32_t>::min();
+
+TEST(TokenizeNoteTest, SplitsOnPunctuationAndLowercases) {
+  EXPECT_EQ(TokenizeNote("Gym, then  RUN-club!"),
+            (std::vector<std::string>{"gym", "then", "run", "club"}));
+  EXPECT_EQ(TokenizeNote("Caf\xc3\xa9 42x"), (std::vector<std::string>{"caf\xc3\xa9", "42x"}));
+  EXPECT_TRUE(TokenizeNote(" ,.;\"\n").empty());
+}
+
+TEST(NoteIndexTest, IntersectsTermsNewestFirst) {
+  NoteIndex index;
+  index.Add(ParseIsoDate("2026-01-03"), "gym and run");  // 0
+  index.Add(ParseIsoDate("2026-01-01"), "Gym");          // 1
+  index.Add(ParseIsoDate("2026-01-02"), "run, gym gym");  // 2
+  index.Add(ParseIsoDate("2026-01-02"), "gym run");      // 3
+  index.Add(ParseIsoDate("2026-01-04"), "rest");         // 4
+  EXPECT_EQ(index.size(), 5u);
+  EXPECT_EQ(index.term_count(), 4u);
+
+  EXPECT_EQ(index.Search("gym", kNoDays, kAllDays), (std::vector<uint32_t>{0, 3, 2, 1}));
+  EXPECT_EQ(index.Search("RUN gym", kNoDays, kAllDays), (std::vector<uint32_t>{0, 3, 2}));
+  EXPECT_EQ(index.Search("gym gym", kNoDays, kAllDays, 2), (std::vector<uint32_t>{0, 3}));
+  EXPECT_EQ(index.Search("gym", ParseIsoDate("2026-01-02"), ParseIsoDate("2026-01-02")),
+            (std::vector<uint32_t>{3, 2}));
+  EXPECT_TRUE(index.Search("gym swim", kNoDays, kAllDays).empty());
+  EXPECT_TRUE(index.Search("", kNoDays, kAllDays).empty());
+}
+
+TEST(NoteIndexTest, MatchesLinearScanOnRandomNotes) {
+  const std::vector<std::string> words = {"gym", "run", "read", "cook", "walk", "sleep", "work"};
+  std::mt19937 rng(3);
+  std::vector<std::vector<std::string>> notes;
+  NoteIndex index;
+  // Enough entries that the id gaps of the rarer terms need multi-byte varints.
+  for (int i = 0; i < 50000; ++i) {
+    std::vector<std::string> note;
+    std::string text;
+    for (const std::string& word : words) {
+      if (rng() % (word == "sleep" ? 4000 : 3) == 0) {
+        note.push_back(word);
+        text += word + " ";
+      }
+    }
+    notes.push_back(note);
+    index.Add(i / 10, text);
+  }
+
+  for (const std::string query : {"gym", "gym run", "sleep", "sleep read work"}) {
+    const std::vector<std::string> terms = TokenizeNote(query);
+    std::vector<uint32_t> expected;
+    for (uint32_t id = 0; id < notes.size(); ++id) {
+      if (std::all_of(terms.begin(), terms.end(), [&](const std::string& term) {
+            return std::find(notes[id].begin(), notes[id].end(), term) != notes[id].end();
+          })) {
+        expected.push_back(id);
+      }
+    }
+    std::reverse(expected.begin(), expected.end());
+    EXPECT_EQ(index.Search(query, kNoDays, kAllDays), expected) << query;
+  }
+}
+
+class NoteIndexSidecarTest : public TempDirTest {
+ protected:
+  void SetUp() override {
+    TempDirTest::SetUp();
+    data_path_ = (dir_ / "entries.csv").string();
+  }
+
+  void WriteData(const std::string& csv, std::ios::openmode mode = std::ios::trunc) {
+    std::ofstream out(data_path_, std::ios::binary | mode);
+    out << csv;
+  }
+
+  std::string data_path_;
+};
+
+TEST_F(NoteIndexSidecarTest, SavedIndexIsFreshUntilDataChanges) {
+  WriteData("2026-01-01,40,gym\n");
+  NoteIndex index;
+  index.Add(ParseIsoDate("2026-01-01"), "gym", 0);
+  ASSERT_TRUE(index.Save(data_path_, StampDataFile(data_path_)));
+
+  NoteIndex read;
+  ASSERT_TRUE(NoteIndex::ReadIfFresh(data_path_, &read));
+  EXPECT_EQ(read.size(), 1u);
+  ASSERT_TRUE(read.has_offsets());
+  EXPECT_EQ(read.offset(0), 0u);
+  EXPECT_EQ(read.Search("gym", kNoDays, kAllDays), (std::vector<uint32_t>{0}));
+
+  WriteData("2026-01-02,60,run\n", std::ios::app);
+  EXPECT_FALSE(NoteIndex::ReadIfFresh(data_path_, &read));
+}
+
+TEST_F(NoteIndexSidecarTest, RejectsPostingsWithIdsPastTheEntries) {
+  WriteData("2026-01-01,40,gym\n2026-01-02,50,rest\n2026-01-03,60,gym\n");
+  NoteIndex index;
+  index.Add(ParseIsoDate("2026-01-01"), "gym");
+  index.Add(ParseIsoDate("2026-01-02"), "rest");
+  index.Add(ParseIsoDate("2026-01-03"), "gym");
+  ASSERT_TRUE(index.Save(data_path_, StampDataFile(data_path_)));
+  NoteIndex read;
+  ASSERT_TRUE(NoteIndex::ReadIfFresh(data_path_, &read));
+
+  // Corrupt the first gap of "gym" (ids 0, 2) so the ids become 9, 11 while the count and the
+  // stored last id still look plausible.
+  const std::string sidecar = NoteIndex::SidecarPath(data_path_);
+  std::string bytes = ReadFile(sidecar);
+  const size_t term = bytes.find("gym");
+  ASSERT_NE(term, std::string::npos);
+  const size_t gaps = term + 3 + 2 * sizeof(uint32_t) + sizeof(uint64_t);
+  ASSERT_EQ(bytes.substr(gaps, 2), std::string("\x00\x02", 2));
+  bytes[gaps] = '\x09';
+  std::ofstream(sidecar, std::ios::binary | std::ios::trunc) << bytes;
+  EXPECT_FALSE(NoteIndex::ReadIfFresh(data_path_, &read));
+}
+
+TEST_F(NoteIndexSidecarTest, TrackerSearchReadsMatchingRecords) {
+  WriteData("2026-01-01,40,Gym day\n\n2026-01-03,50,\"gym, then \"\"run\"\"\"\n"
+            "2026-01-02,60,rest\n");
+  {
+    Tracker tracker(data_path_);
+    const std::vector<Entry> matches = tracker.Search("gym", kNoDays, kAllDays, 0);
+    ASSERT_EQ(matches.size(), 2u);
+    EXPECT_EQ(matches[0].note, "gym, then \"run\"");
+    EXPECT_EQ(matches[1].date, "2026-01-01");
+  }
+  ASSERT_TRUE(std::filesystem::exists(NoteIndex::SidecarPath(data_path_)));
+
+  // Add() extends the fresh sidecar, offsets included.
+  {
+    Tracker tracker(data_path_);
+    tracker.Add(Entry{"2026-01-04", 70, "run with \"friends\""});
+  }
+  NoteIndex read;
+  ASSERT_TRUE(NoteIndex::ReadIfFresh(data_path_, &read));
+  EXPECT_EQ(read.size(), 4u);
+  Tracker tracker(data_path_);
+  std::vector<Entry> matches = tracker.Search("RUN", kNoDays, kAllDays, 0);
+  ASSERT_EQ(matches.size(), 2u);
+  EXPECT_EQ(matches[0].note, "run with \"friends\"");
+  EXPECT_EQ(matches[1].date, "2026-01-03");
+
+  // An append behind the index's back is detected and rebuilt transparently.
+  WriteData("2026-01-05,80,gym\n", std::ios::app);
+  matches = tracker.Search("gym", ParseIsoDate("2026-01-02"), kAllDays, 1);
+  ASSERT_EQ(matches.size(), 1u);
+  EXPECT_EQ(matches[0].date, "2026-01-05");
+}
+
+TEST_F(NoteIndexSidecarTest, SearchesColumnarAndPartitionedData) {
+  std::vector<Entry> entries = {{"2026-01-01", 40, "gym"},
+                                {"2026-02-01", 50, "read"},
+                                {"2026-02-02", 60, "gym and read"}};
+  std::vector<EntryView> views;
+  for (const Entry& e : entries) views.push_back({e.date, e.mood, e.note, ParseIsoDate(e.date)});
+  const std::string columnar_path = (dir_ / "entries.lcol").string();
+  const std::string partitioned_path = (dir_ / "parts").string();
+  WriteDataFile(columnar_path, views);
+  WritePartitionedData(partitioned_path, views);
+
+  for (const std::string& path : {columnar_path, partitioned_path}) {
+    Tracker tracker(path);
+    EXPECT_FALSE(tracker.Notes().has_offsets()) << path;
+    tracker.Add(Entry{"2026-01-15", 70, "read"});
+    const std::vector<Entry> matches = tracker.Search("read", kNoDays, kAllDays, 0);
+    ASSERT_EQ(matches.size(), 3u) << path;
+    EXPECT_EQ(matches[0].date, "2026-02-02");
+    EXPECT_EQ(matches[1].date, "2026-02-01");
+    EXPECT_EQ(matches[2].date, "2026-01-15");
+  }
+}
+
+}  // namespace
+}  // namespace life_tracker
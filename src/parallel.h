@@ -0,0 +1,19 @@
+#ifndef LIFE_TRACKER_PARALLEL_H_
+#define LIFE_TRACKER_PARALLEL_H_
+
+#include <cstddef>
+#include <functional>
+
+namespace life_tracker {
+
+// Returns `requested`, or the number of hardware threads if `requested` is 0 or negative.
+int ResolveThreadCount(int requested);
+
+// Calls `task(i)` for every i in [0, count) using up to `max_threads` threads, including the
+// calling thread, and returns once all calls have finished. If any task throws, the exception from
+// the lowest-numbered failing task is rethrown after the others complete.
+void RunParallel(size_t count, int max_threads, const std::function<void(size_t)>& task);
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_PARALLEL_H_
@@ -0,0 +1,43 @@
+#include "src/parallel.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace life_tracker {
+namespace {
+
+TEST(RunParallelTest, RunsEveryTaskOnce) {
+  std::vector<std::atomic<int>> calls(100);
+  RunParallel(calls.size(), 4, [&](size_t i) { ++calls[i]; });
+  for (const auto& count : calls) EXPECT_EQ(count.load(), 1);
+}
+
+TEST(RunParallelTest, HandlesNoTasks) {
+  RunParallel(0, 4, [](size_t) { FAIL() << "no task should run"; });
+}
+
+TEST(RunParallelTest, RethrowsLowestFailingTask) {
+  std::atomic<int> finished{0};
+  try {
+    RunParallel(10, 3, [&](size_t i) {
+      if (i == 7) throw std::runtime_error("seven");
+      if (i == 3) throw std::runtime_error("three");
+      ++finished;
+    });
+    FAIL() << "expected an exception";
+  } catch (const std::runtime_error& e) {
+    EXPECT_STREQ(e.what(), "three");
+  }
+  EXPECT_EQ(finished.load(), 8);
+}
+
+TEST(ResolveThreadCountTest, ZeroMeansHardwareThreads) {
+  EXPECT_EQ(ResolveThreadCount(3), 3);
+  EXPECT_GE(ResolveThreadCount(0), 1);
+}
+
+}  // namespace
+}  // namespace life_tracker
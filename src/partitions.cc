@@ -0,0 +1,66 @@
+#include "src/partitions.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "src/date.h"
+
+namespace life_tracker {
+namespace {
+namespace fs = std::filesystem;
+
+constexpr char kPartitionExtension[] = ".csv";
+
+// Parses a string of exactly `digits` decimal digits; returns -1 otherwise.
+int ParseDigits(std::string_view s, size_t digits) {
+  if (s.size() != digits) return -1;
+  int value = 0;
+  for (const char c : s) {
+    if (c < '0' || c > '9') return -1;
+    value = value * 10 + (c - '0');
+  }
+  return value;
+}
+
+}  // namespace
+
+bool IsPartitionedDataPath(const std::string& path) {
+  std::error_code ec;
+  return fs::is_directory(path, ec);
+}
+
+std::vector<Partition> ListPartitions(const std::string& dir) {
+  std::vector<Partition> partitions;
+  std::error_code ec;
+  for (const fs::directory_entry& year_dir : fs::directory_iterator(dir, ec)) {
+    const int year = ParseDigits(year_dir.path().filename().string(), 4);
+    if (year < 0 || !year_dir.is_directory(ec)) continue;
+    for (const fs::directory_entry& file : fs::directory_iterator(year_dir.path(), ec)) {
+      const fs::path& path = file.path();
+      if (path.extension() != kPartitionExtension || !file.is_regular_file(ec)) continue;
+      const int month = ParseDigits(path.stem().string(), 2);
+      if (month < 1 || month > 12) continue;
+      Partition partition;
+      partition.path = path.string();
+      partition.first_day = DayNumberFromCivil(year, month, 1);
+      partition.last_day = DayNumberFromCivil(year, month, DaysInMonth(year, month));
+      partitions.push_back(std::move(partition));
+    }
+  }
+  std::sort(partitions.begin(), partitions.end(), [](const Partition& a, const Partition& b) {
+    return a.first_day < b.first_day;
+  });
+  return partitions;
+}
+
+std::string PartitionPathForDay(const std::string& dir, int32_t day) {
+  char date[10];
+  FormatIsoDate(day, date);
+  return (fs::path(dir) / std::string(date, 4) / (std::string(date + 5, 2) + kPartitionExtension))
+      .string();
+}
+
+}  // namespace life_tracker
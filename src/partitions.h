@@ -0,0 +1,32 @@
+#ifndef LIFE_TRACKER_PARTITIONS_H_
+#define LIFE_TRACKER_PARTITIONS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace life_tracker {
+
+// A partitioned data directory holds one CSV file per month at YYYY/MM.csv, each containing only
+// entries dated in that month. Commands that look at a date window open just the months it
+// overlaps.
+
+// One month file of a partitioned data directory.
+struct Partition {
+  std::string path;
+  int32_t first_day = 0;  // Day numbers of the first and last day of the month.
+  int32_t last_day = 0;
+};
+
+// True if `path` is an existing directory, which makes it a partitioned data directory.
+bool IsPartitionedDataPath(const std::string& path);
+
+// The month files under `dir`, oldest first. Anything not named YYYY/MM.csv is ignored.
+std::vector<Partition> ListPartitions(const std::string& dir);
+
+// The partition file under `dir` that holds entries dated `day`.
+std::string PartitionPathForDay(const std::string& dir, int32_t day);
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_PARTITIONS_H_
@@ -0,0 +1,55 @@
+#include "src/partitions.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "src/date.h"
+#include "src/test_util.h"
+
+namespace life_tracker {
+namespace {
+
+namespace fs = std::filesystem;
+
+class PartitionsTest : public TempDirTest {
+ protected:
+  void Touch(const std::string& relative) {
+    fs::create_directories((dir_ / relative).parent_path());
+    std::ofstream out(dir_ / relative);
+  }
+};
+
+TEST_F(PartitionsTest, PathForDayIsYearAndMonth) {
+  EXPECT_EQ(PartitionPathForDay("data", ParseIsoDate("2026-01-31")),
+            (fs::path("data") / "2026" / "01.csv").string());
+  EXPECT_EQ(PartitionPathForDay("data", ParseIsoDate("1999-12-01")),
+            (fs::path("data") / "1999" / "12.csv").string());
+}
+
+TEST_F(PartitionsTest, ListsMonthFilesOldestFirstAndIgnoresOthers) {
+  Touch("2026/02.csv");
+  Touch("2025/12.csv");
+  Touch("2026/01.csv");
+  Touch("2026/13.csv");
+  Touch("2026/1.csv");
+  Touch("2026/03.lcol");
+  Touch("notes/01.csv");
+  Touch("entries.csv");
+
+  EXPECT_TRUE(IsPartitionedDataPath(dir_.string()));
+  EXPECT_FALSE(IsPartitionedDataPath((dir_ / "entries.csv").string()));
+  EXPECT_FALSE(IsPartitionedDataPath((dir_ / "missing").string()));
+
+  const std::vector<Partition> partitions = ListPartitions(dir_.string());
+  ASSERT_EQ(partitions.size(), 3u);
+  EXPECT_EQ(partitions[0].path, (dir_ / "2025" / "12.csv").string());
+  EXPECT_EQ(partitions[0].first_day, ParseIsoDate("2025-12-01"));
+  EXPECT_EQ(partitions[0].last_day, ParseIsoDate("2025-12-31"));
+  EXPECT_EQ(partitions[2].first_day, ParseIsoDate("2026-02-01"));
+  EXPECT_EQ(partitions[2].last_day, ParseIsoDate("2026-02-28"));
+}
+
+}  // namespace
+}  // namespace life_tracker
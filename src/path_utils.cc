@@ -4,10 +4,13 @@
 #include <filesystem>
 #include <string>
 
+#include "src/trace.h"
+
 namespace life_tracker {
 namespace fs = std::filesystem;
 
 std::string ResolveDataPath(const std::string& flag_value) {
+  TraceSpan span("resolve_path");
   fs::path path(flag_value);
   if (path.is_absolute()) return path.lexically_normal().string();
 
@@ -0,0 +1,300 @@
+#include "src/report.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_format.h"
+#include "absl/time/civil_time.h"
+#include "src/date.h"
+#include "src/trace.h"
+
+namespace life_tracker {
+
+std::vector<size_t> LttbIndices(const std::vector<DayMood>& samples, size_t max_points) {
+  const size_t n = samples.size();
+  std::vector<size_t> kept;
+  if (max_points == 0 || max_points >= n) {
+    kept.resize(n);
+    for (size_t i = 0; i < n; ++i) kept[i] = i;
+    return kept;
+  }
+  max_points = std::max<size_t>(max_points, 3);
+  if (max_points >= n) return LttbIndices(samples, 0);
+
+  // Bucket b (0-based) of the samples between the endpoints is [BucketStart(b), BucketStart(b+1)).
+  const size_t buckets = max_points - 2;
+  const auto BucketStart = [&](size_t b) { return 1 + b * (n - 2) / buckets; };
+  kept.reserve(max_points);
+  kept.push_back(0);
+  for (size_t b = 0; b < buckets; ++b) {
+    // The next bucket's mean; the last bucket is followed by the last sample alone.
+    const size_t next_begin = BucketStart(b + 1);
+    const size_t next_end = b + 1 < buckets ? BucketStart(b + 2) : n;
+    double mean_x = 0;
+    double mean_y = 0;
+    for (size_t i = next_begin; i < next_end; ++i) {
+      mean_x += static_cast<double>(i);
+      mean_y += samples[i].mood;
+    }
+    mean_x /= static_cast<double>(next_end - next_begin);
+    mean_y /= static_cast<double>(next_end - next_begin);
+
+    const double a_x = static_cast<double>(kept.back());
+    const double a_y = samples[kept.back()].mood;
+    size_t best = BucketStart(b);
+    double best_area = -1;
+    for (size_t i = BucketStart(b); i < next_begin; ++i) {
+      // Twice the triangle's area; only the comparison matters.
+      const double area = std::abs((a_x - mean_x) * (samples[i].mood - a_y) -
+                                   (a_x - static_cast<double>(i)) * (mean_y - a_y));
+      if (area > best_area) {
+        best_area = area;
+        best = i;
+      }
+    }
+    kept.push_back(best);
+  }
+  kept.push_back(n - 1);
+  return kept;
+}
+
+std::string RenderSvg(const std::vector<DayMood>& samples, size_t max_points, const Trend* trend) {
+  if (samples.empty()) {
+    return "<div class=\"empty\">No data to chart.</div>";
+  }
+
+  const int min_mood = 1;
+  const int max_mood = 100;
+  const double mood_range = static_cast<double>(max_mood - min_mood);
+
+  constexpr int width = 720;
+  constexpr int height = 360;
+  constexpr int padding = 48;
+  constexpr int plot_width = width - 2 * padding;
+  static_assert(plot_width == kChartPlotWidth, "kChartPlotWidth must match the chart layout");
+  const int plot_height = height - 2 * padding;
+  // A circle is 10px across plus its stroke; closer than that they merge into a smear.
+  const size_t max_circles = plot_width / 12;
+
+  const std::vector<size_t> kept =
+      LttbIndices(samples, max_points == 0 ? static_cast<size_t>(plot_width) : max_points);
+  // Points keep their place in the full series, so uneven picks do not stretch the time axis.
+  const double x_step =
+      samples.size() > 1 ? static_cast<double>(plot_width) / (samples.size() - 1) : 0.0;
+
+  auto MoodToY = [&](double mood) {
+    const double clamped = std::min(std::max(mood, 1.0 * min_mood), 1.0 * max_mood);
+    const double normalized = (max_mood - clamped) / mood_range;  // 0 at max, 1 at min.
+    return padding + normalized * plot_height;
+  };
+
+  std::ostringstream points;
+  for (size_t k = 0; k < kept.size(); ++k) {
+    const double x = padding + x_step * kept[k];
+    const double y = MoodToY(samples[kept[k]].mood);
+    points << x << "," << y;
+    if (k + 1 < kept.size()) points << " ";
+  }
+
+  std::ostringstream circles;
+  if (kept.size() <= max_circles) {
+    for (const size_t i : kept) {
+      const double x = padding + x_step * i;
+      const double y = MoodToY(samples[i].mood);
+      circles << "<circle cx=\"" << x << "\" cy=\"" << y
+              << "\" r=\"5\" fill=\"#2563eb\" stroke=\"white\" stroke-width=\"2\"></circle>";
+    }
+  }
+
+  // Each trend point sits on the last sample of its day, so the lines share the chart's time axis.
+  // Points less than a pixel right of the previous one are skipped, except the last.
+  const auto TrendLine = [&](double TrendPoint::*value, const char* color) {
+    std::ostringstream line;
+    size_t i = 0;
+    double last_x = -1;
+    for (const TrendPoint& point : trend->points) {
+      const absl::CivilDay day = CivilDayFromDayNumber(point.day);
+      while (i + 1 < samples.size() && samples[i + 1].day <= day) ++i;
+      if (samples[i].day != day) continue;
+      const double x = padding + x_step * i;
+      if (last_x >= 0 && x - last_x < 1 && &point != &trend->points.back()) continue;
+      line << (last_x >= 0 ? " " : "") << x << "," << MoodToY(point.*value);
+      last_x = x;
+    }
+    return "<polyline fill=\"none\" stroke=\"" + std::string(color) +
+           "\" stroke-width=\"2\" points=\"" + line.str() + "\"></polyline>";
+  };
+
+  std::ostringstream svg;
+  svg << "<svg width=\"" << width << "\" height=\"" << height << "\" viewBox=\"0 0 " << width << " "
+      << height << "\" role=\"img\" "
+      << "aria-label=\"Mood over time (1-100)\">";
+  svg << "<rect x=\"0\" y=\"0\" width=\"" << width << "\" height=\"" << height
+      << "\" fill=\"#f8fafc\" />";
+  svg << "<polyline fill=\"none\" stroke=\"#2563eb\" stroke-width=\"3\" points=\"" << points.str()
+      << "\"></polyline>";
+  svg << circles.str();
+  if (trend != nullptr && !trend->points.empty()) {
+    svg << TrendLine(&TrendPoint::average30, "#9333ea")
+        << TrendLine(&TrendPoint::average7, "#f97316");
+    svg << "<text x=\"" << width - padding << "\" y=\"" << padding / 1.8
+        << "\" font-family=\"Helvetica, Arial, sans-serif\" font-size=\"12\" "
+           "text-anchor=\"end\"><tspan fill=\"#f97316\">"
+        << kShortTrendDays << "-day average</tspan> <tspan fill=\"#9333ea\">" << kLongTrendDays
+        << "-day average</tspan></text>";
+  }
+  svg << "<text x=\"" << padding << "\" y=\"" << height - padding / 3
+      << "\" fill=\"#475569\" font-family=\"Helvetica, Arial, sans-serif\" "
+         "font-size=\"12\">Older</text>";
+  svg << "<text x=\"" << width - padding << "\" y=\"" << height - padding / 3
+      << "\" fill=\"#475569\" font-family=\"Helvetica, Arial, sans-serif\" font-size=\"12\" "
+      << "text-anchor=\"end\">Newer</text>";
+  svg << "<text x=\"" << padding << "\" y=\"" << padding / 1.8
+      << "\" fill=\"#475569\" font-family=\"Helvetica, Arial, sans-serif\" font-size=\"12\">Mood "
+         "(1-100)</text>";
+  svg << "</svg>";
+  return svg.str();
+}
+
+std::string RenderRollupTable(const Rollup& rollup) {
+  std::ostringstream table;
+  table << "<table class=\"rollup\"><thead><tr><th>" << RollupPeriodName(rollup.period)
+        << "</th><th>Entries</th><th>Average</th><th>Std dev</th><th>Min</th><th>Max</th>"
+           "<th>Days logged</th></tr></thead><tbody>";
+  for (const RollupBucket& bucket : rollup.buckets) {
+    const SummaryStats& summary = bucket.summary;
+    table << "<tr><td>" << RollupBucketLabel(rollup.period, bucket) << "</td><td>"
+          << summary.count << "</td><td>" << absl::StrFormat("%.1f", summary.average_mood)
+          << "</td><td>" << absl::StrFormat("%.1f", summary.stddev) << "</td><td>"
+          << summary.worst.mood << "</td><td>" << summary.best.mood << "</td><td>"
+          << bucket.days_with_entries << "/" << bucket.days_in_range << "</td></tr>";
+  }
+  table << "</tbody></table>";
+  return table.str();
+}
+
+std::string BuildReportHtml(const std::vector<DayMood>& samples, const SummaryStats& summary,
+                            int days, size_t max_points, const Rollup* rollup,
+                            const Trend* trend) {
+  TraceSpan span("render_html");
+  span.Counter("samples", static_cast<int64_t>(samples.size()));
+  std::ostringstream html;
+  html << "<!DOCTYPE html><html><head><meta charset=\"UTF-8\"><title>Life Tracker Report</title>";
+  html << "<style>"
+       << "body{font-family:Helvetica,Arial,sans-serif;background:#0f172a;color:#e2e8f0;"
+          "margin:0;padding:32px;}"
+       << "h1{margin:0 0 8px 0;font-size:28px;}"
+       << "p.lead{margin:0 0 24px 0;color:#cbd5e1;}"
+       << ".cards{display:grid;grid-template-columns:repeat(auto-fit,minmax(200px,1fr));"
+          "gap:16px;margin-bottom:24px;}"
+       << ".card{background:#1e293b;border:1px solid #334155;border-radius:12px;padding:16px;"
+          "box-shadow:0 10px 30px rgba(0,0,0,0.3);}"
+       << ".label{font-size:12px;letter-spacing:0.08em;text-transform:uppercase;color:#94a3b8;"
+          "margin-bottom:6px;display:block;}"
+       << ".value{font-size:22px;font-weight:700;}"
+       << ".chart{background:#fff;border-radius:12px;border:1px solid #e2e8f0;"
+          "padding:12px;}"
+       << ".chart h2{color:#0f172a;margin:0 0 8px 0;}"
+       << ".empty{color:#334155;font-style:italic;}"
+       << "table.rollup{width:100%;border-collapse:collapse;margin-top:12px;color:#0f172a;"
+          "font-size:13px;}"
+       << "table.rollup th,table.rollup td{padding:4px 8px;border-bottom:1px solid #e2e8f0;"
+          "text-align:right;}"
+       << "table.rollup th:first-child,table.rollup td:first-child{text-align:left;"
+          "text-transform:capitalize;}"
+       << "</style></head><body>";
+  html << "<h1>Life Tracker Report</h1>";
+  html << "<p class=\"lead\">Last " << days << " day";
+  if (days != 1) html << "s";
+  html << " of mood entries.</p>";
+
+  html << "<div class=\"cards\">";
+  html << "<div class=\"card\"><span class=\"label\">Entries</span><div class=\"value\">"
+       << summary.count << "</div></div>";
+  html << "<div class=\"card\"><span class=\"label\">Average Mood</span><div class=\"value\">";
+  if (summary.has_data) {
+    html << absl::StrFormat("%.2f", summary.average_mood);
+  } else {
+    html << "n/a";
+  }
+  html << "</div></div>";
+  html << "<div class=\"card\"><span class=\"label\">Best Day</span><div class=\"value\">";
+  if (summary.has_data) {
+    html << absl::FormatCivilTime(summary.best.day) << " (" << summary.best.mood << ")";
+  } else {
+    html << "n/a";
+  }
+  html << "</div></div>";
+  html << "<div class=\"card\"><span class=\"label\">Toughest Day</span><div class=\"value\">";
+  if (summary.has_data) {
+    html << absl::FormatCivilTime(summary.worst.day) << " (" << summary.worst.mood << ")";
+  } else {
+    html << "n/a";
+  }
+  html << "</div></div>";
+  const MoodDistribution& distribution = summary.distribution;
+  html << "<div class=\"card\"><span class=\"label\">Median Mood</span><div class=\"value\">";
+  if (summary.has_distribution) {
+    html << absl::StrFormat("%.1f", distribution.median);
+  } else {
+    html << "n/a";
+  }
+  html << "</div></div>";
+  html << "<div class=\"card\"><span class=\"label\">Middle 50% (IQR)</span>"
+          "<div class=\"value\">";
+  if (summary.has_distribution) {
+    html << distribution.p25 << "&ndash;" << distribution.p75 << " (" << distribution.iqr << ")";
+  } else {
+    html << "n/a";
+  }
+  html << "</div></div>";
+  html << "<div class=\"card\"><span class=\"label\">10th&ndash;90th Percentile</span>"
+          "<div class=\"value\">";
+  if (summary.has_distribution) {
+    html << distribution.p10 << "&ndash;" << distribution.p90;
+  } else {
+    html << "n/a";
+  }
+  html << "</div></div>";
+  html << "<div class=\"card\"><span class=\"label\">Most Common Mood</span>"
+          "<div class=\"value\">";
+  if (summary.has_distribution) {
+    html << distribution.mode;
+  } else {
+    html << "n/a";
+  }
+  html << "</div></div>";
+  html << "<div class=\"card\"><span class=\"label\">Trend</span><div class=\"value\">";
+  if (trend != nullptr && trend->has_slope) {
+    html << absl::StrFormat("%+.2f / day", trend->slope);
+  } else {
+    html << "n/a";
+  }
+  html << "</div></div>";
+  html << "</div>";
+
+  if (rollup == nullptr) {
+    html << "<div class=\"chart\"><h2>Mood Over Time</h2>"
+         << RenderSvg(samples, max_points, trend) << "</div>";
+  } else {
+    // One point per bucket, at its rounded mean.
+    std::vector<DayMood> means;
+    means.reserve(rollup->buckets.size());
+    for (const RollupBucket& bucket : rollup->buckets) {
+      means.push_back({bucket.first_day,
+                       static_cast<int>(std::lround(bucket.summary.average_mood))});
+    }
+    html << "<div class=\"chart\"><h2>Average Mood per " << RollupPeriodName(rollup->period)
+         << "</h2>" << RenderSvg(means, max_points) << RenderRollupTable(*rollup) << "</div>";
+  }
+
+  html << "</body></html>";
+  std::string result = html.str();
+  span.Counter("bytes", static_cast<int64_t>(result.size()));
+  return result;
+}
+
+}  // namespace life_tracker
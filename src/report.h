@@ -0,0 +1,44 @@
+#ifndef LIFE_TRACKER_REPORT_H_
+#define LIFE_TRACKER_REPORT_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "src/rollup.h"
+#include "src/stats.h"
+#include "src/trend.h"
+
+namespace life_tracker {
+
+// Width in pixels of the chart's plot area, and so the most points it can usefully show.
+inline constexpr int kChartPlotWidth = 624;
+
+// Indices of at most `max_points` of `samples` chosen by Largest-Triangle-Three-Buckets: the
+// first and last samples, plus from each of `max_points` - 2 equal runs in between the sample
+// that spans the largest triangle with the previous pick and the next run's mean. Peaks and
+// troughs survive, unlike with averaging or striding. All indices if `max_points` is 0 or covers
+// every sample; `max_points` below 3 is treated as 3.
+std::vector<size_t> LttbIndices(const std::vector<DayMood>& samples, size_t max_points);
+
+// Renders `samples` (oldest first) as an inline SVG line chart of mood over time, downsampled to
+// at most `max_points` points (0 = kChartPlotWidth) with LttbIndices(). Points are marked with
+// circles only while they are far enough apart for the circles not to overlap. With a `trend`
+// covering the samples' days, its short and long moving averages are drawn over them.
+std::string RenderSvg(const std::vector<DayMood>& samples, size_t max_points = 0,
+                      const Trend* trend = nullptr);
+
+// Renders `rollup` as an HTML table, one row per bucket.
+std::string RenderRollupTable(const Rollup& rollup);
+
+// Builds the standalone HTML page written by `life report`: summary cards for the last `days`
+// days followed by the mood chart, with at most `max_points` points as for RenderSvg(). With a
+// `rollup`, the chart plots its bucket means instead of `samples` and the table follows it.
+// A `trend` adds a card with its slope and, on the per-sample chart, its moving averages.
+std::string BuildReportHtml(const std::vector<DayMood>& samples, const SummaryStats& summary,
+                            int days, size_t max_points = 0, const Rollup* rollup = nullptr,
+                            const Trend* trend = nullptr);
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_REPORT_H_
@@ -0,0 +1,145 @@
+#include "src/report.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/date.h"
+
+namespace life_tracker {
+namespace {
+
+size_t CountOf(const std::string& haystack, const std::string& needle) {
+  size_t count = 0;
+  for (size_t pos = haystack.find(needle); pos != std::string::npos;
+       pos = haystack.find(needle, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+TEST(ReportTest, EmptyChartSaysSo) {
+  EXPECT_NE(RenderSvg({}).find("No data to chart."), std::string::npos);
+}
+
+TEST(ReportTest, ChartHasOnePointPerSample) {
+  const std::vector<DayMood> samples = {{absl::CivilDay(2026, 1, 1), 10},
+                                        {absl::CivilDay(2026, 1, 2), 90},
+                                        {absl::CivilDay(2026, 1, 3), 50}};
+  EXPECT_EQ(CountOf(RenderSvg(samples), "<circle"), samples.size());
+}
+
+std::vector<DayMood> Series(size_t n) {
+  std::vector<DayMood> samples;
+  for (size_t i = 0; i < n; ++i) {
+    samples.push_back({absl::CivilDay(2000, 1, 1) + static_cast<int>(i),
+                       static_cast<int>(50 + (i * 7919) % 41 - 20)});
+  }
+  return samples;
+}
+
+TEST(LttbTest, KeepsEverythingWhenUnderTheCap) {
+  const std::vector<DayMood> samples = Series(10);
+  EXPECT_EQ(LttbIndices(samples, 0).size(), 10u);
+  EXPECT_EQ(LttbIndices(samples, 10).size(), 10u);
+  EXPECT_EQ(LttbIndices(samples, 50).size(), 10u);
+  EXPECT_TRUE(LttbIndices({}, 5).empty());
+}
+
+TEST(LttbTest, PicksOnePointPerBucketBetweenTheEndpoints) {
+  const std::vector<DayMood> samples = Series(10000);
+  for (const size_t max_points : {3u, 4u, 100u, 624u, 9999u}) {
+    const std::vector<size_t> kept = LttbIndices(samples, max_points);
+    ASSERT_EQ(kept.size(), max_points);
+    EXPECT_EQ(kept.front(), 0u);
+    EXPECT_EQ(kept.back(), samples.size() - 1);
+    for (size_t k = 1; k < kept.size(); ++k) ASSERT_LT(kept[k - 1], kept[k]);
+  }
+  EXPECT_EQ(LttbIndices(samples, 1).size(), 3u);
+}
+
+TEST(LttbTest, KeepsIsolatedPeaksAndTroughs) {
+  std::vector<DayMood> samples(5000, DayMood{absl::CivilDay(2000, 1, 1), 50});
+  samples[1234].mood = 100;
+  samples[3456].mood = 1;
+  const std::vector<size_t> kept = LttbIndices(samples, 20);
+  EXPECT_NE(std::find(kept.begin(), kept.end(), 1234u), kept.end());
+  EXPECT_NE(std::find(kept.begin(), kept.end(), 3456u), kept.end());
+}
+
+TEST(ReportTest, LongRangesAreDownsampledWithoutCircles) {
+  const std::vector<DayMood> samples = Series(3650);
+  const std::string svg = RenderSvg(samples);
+  const size_t begin = svg.find("points=\"");
+  const std::string points = svg.substr(begin, svg.find('"', begin + 8) - begin);
+  EXPECT_EQ(CountOf(points, ","), static_cast<size_t>(kChartPlotWidth));
+  EXPECT_EQ(CountOf(svg, "<circle"), 0u);
+
+  const std::string sparse = RenderSvg(samples, 20);
+  EXPECT_EQ(CountOf(sparse, "<circle"), 20u);
+}
+
+TEST(ReportTest, HtmlChartsRollupMeansAndTabulatesThem) {
+  std::vector<EntryView> views;
+  const std::vector<std::string> dates = {"2026-01-01", "2026-01-02", "2026-02-01"};
+  const std::vector<int> moods = {10, 20, 90};
+  for (size_t i = 0; i < dates.size(); ++i) {
+    EntryView view;
+    view.date = dates[i];
+    view.mood = moods[i];
+    view.day = ParseIsoDate(dates[i]);
+    views.push_back(view);
+  }
+  const Rollup rollup = RollupEntries(views, RollupPeriod::kMonth);
+  const std::vector<DayMood> samples = CollectRecentSamples(
+      absl::MakeConstSpan(views), 40, absl::CivilDay(2026, 2, 1));
+  const std::string html =
+      BuildReportHtml(samples, ComputeSummary(samples), 40, 0, &rollup);
+  EXPECT_NE(html.find("Average Mood per month"), std::string::npos);
+  EXPECT_EQ(CountOf(html, "<circle"), 2u);
+  EXPECT_NE(html.find("<td>2026-01</td><td>2</td><td>15.0</td>"), std::string::npos);
+  EXPECT_NE(html.find("<td>2026-02</td><td>1</td><td>90.0</td>"), std::string::npos);
+}
+
+TEST(ReportTest, HtmlOverlaysMovingAveragesAndShowsSlope) {
+  const std::vector<std::string> dates = {"2026-01-01", "2026-01-02", "2026-01-02", "2026-01-03"};
+  const std::vector<int> moods = {10, 40, 60, 90};
+  std::vector<EntryView> views;
+  std::vector<DayMood> samples;
+  for (size_t i = 0; i < dates.size(); ++i) {
+    views.push_back({dates[i], moods[i], "", ParseIsoDate(dates[i])});
+    samples.push_back({CivilDayFromDayNumber(views.back().day), moods[i]});
+  }
+  const Trend trend = TrendEntries(views, views.front().day, views.back().day);
+  const std::string html = BuildReportHtml(samples, ComputeSummary(samples), 3, 0, nullptr, &trend);
+  EXPECT_EQ(CountOf(html, "<polyline"), 3u);
+  EXPECT_NE(html.find("7-day average"), std::string::npos);
+  EXPECT_NE(html.find("Trend</span><div class=\"value\">+40.00 / day<"), std::string::npos);
+
+  // One trend point per day, on the day's last sample.
+  const size_t begin = html.find("points=\"", html.find("stroke=\"#f97316\""));
+  const std::string points = html.substr(begin, html.find('"', begin + 8) - begin);
+  EXPECT_EQ(CountOf(points, ","), 3u);
+
+  EXPECT_EQ(CountOf(BuildReportHtml(samples, ComputeSummary(samples), 3), "<polyline"), 1u);
+}
+
+TEST(ReportTest, HtmlShowsSummaryCards) {
+  const std::vector<DayMood> samples = {{absl::CivilDay(2026, 1, 1), 10},
+                                        {absl::CivilDay(2026, 1, 2), 90}};
+  const std::string html = BuildReportHtml(samples, ComputeSummary(samples), 2);
+  EXPECT_NE(html.find("Last 2 days"), std::string::npos);
+  EXPECT_NE(html.find("2026-01-02 (90)"), std::string::npos);
+  EXPECT_NE(html.find("2026-01-01 (10)"), std::string::npos);
+  EXPECT_NE(html.find("50.00"), std::string::npos);
+  EXPECT_NE(html.find("Median Mood</span><div class=\"value\">50.0<"), std::string::npos);
+  EXPECT_NE(html.find("<div class=\"value\">10&ndash;90 (80)<"), std::string::npos);
+
+  const std::string empty = BuildReportHtml({}, ComputeSummary({}), 1);
+  EXPECT_NE(empty.find("Last 1 day of"), std::string::npos);
+  EXPECT_NE(empty.find("n/a"), std::string::npos);
+}
+
+}  // namespace
+}  // namespace life_tracker
@@ -0,0 +1,169 @@
+#include "src/rollup.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "absl/strings/str_format.h"
+#include "src/date.h"
+#include "src/trace.h"
+
+namespace life_tracker {
+namespace {
+
+// Day numbers of the first and last day of the bucket holding `day`.
+std::pair<int32_t, int32_t> BucketBounds(int32_t day, RollupPeriod period) {
+  switch (period) {
+    case RollupPeriod::kWeek: {
+      // Day 0, 1970-01-01, was a Thursday, so Mondays are the days where (day + 3) % 7 == 0.
+      const int32_t monday = day - ((day + 3) % 7 + 7) % 7;
+      return {monday, monday + 6};
+    }
+    case RollupPeriod::kMonth: {
+      const absl::CivilMonth month(CivilDayFromDayNumber(day));
+      return {DayNumberFromCivilDay(absl::CivilDay(month)),
+              DayNumberFromCivilDay(absl::CivilDay(month + 1)) - 1};
+    }
+    case RollupPeriod::kYear: {
+      const absl::CivilYear year(CivilDayFromDayNumber(day));
+      return {DayNumberFromCivilDay(absl::CivilDay(year)),
+              DayNumberFromCivilDay(absl::CivilDay(year + 1)) - 1};
+    }
+  }
+  return {day, day};
+}
+
+// Accumulates days in date order into buckets.
+class RollupBuilder {
+ public:
+  explicit RollupBuilder(RollupPeriod period) { rollup_.period = period; }
+
+  // Adds the moods of `day`, which must not precede any day added before.
+  void Add(int32_t day, const SummaryAccumulator& moods) {
+    if (day == kInvalidDay) throw std::runtime_error("Invalid date in data.");
+    if (have_day_ && day < last_day_) {
+      throw std::runtime_error("Rollup input is not in date order.");
+    }
+    if (!have_day_ || day > bucket_last_) {
+      Close(/*final=*/false);
+      std::tie(bucket_first_, bucket_last_) = BucketBounds(day, rollup_.period);
+      if (!have_day_) first_data_day_ = day;
+    }
+    if (!have_day_ || day != last_day_) ++days_with_entries_;
+    moods_.Merge(moods);
+    last_day_ = day;
+    have_day_ = true;
+  }
+
+  Rollup Finish() {
+    Close(/*final=*/true);
+    return std::move(rollup_);
+  }
+
+ private:
+  // Emits the open bucket. Only the final one can end before its last calendar day.
+  void Close(bool final) {
+    if (moods_.count() == 0) return;
+    RollupBucket bucket;
+    bucket.first_day = CivilDayFromDayNumber(bucket_first_);
+    bucket.last_day = CivilDayFromDayNumber(bucket_last_);
+    bucket.summary = moods_.Result();
+    bucket.days_with_entries = days_with_entries_;
+    bucket.days_in_range =
+        (final ? std::min(bucket_last_, last_day_) : bucket_last_) -
+        std::max(bucket_first_, first_data_day_) + 1;
+    rollup_.buckets.push_back(bucket);
+    moods_ = SummaryAccumulator();
+    days_with_entries_ = 0;
+  }
+
+  Rollup rollup_;
+  bool have_day_ = false;
+  int32_t first_data_day_ = 0;
+  int32_t last_day_ = 0;
+  int32_t bucket_first_ = 0;
+  int32_t bucket_last_ = 0;
+  SummaryAccumulator moods_;
+  int days_with_entries_ = 0;
+};
+
+}  // namespace
+
+RollupPeriod ParseRollupPeriod(std::string_view name) {
+  if (name == "week") return RollupPeriod::kWeek;
+  if (name == "month") return RollupPeriod::kMonth;
+  if (name == "year") return RollupPeriod::kYear;
+  throw std::runtime_error("Unsupported rollup period: " + std::string(name) +
+                           " (expected week, month or year)");
+}
+
+const char* RollupPeriodName(RollupPeriod period) {
+  switch (period) {
+    case RollupPeriod::kWeek:
+      return "week";
+    case RollupPeriod::kMonth:
+      return "month";
+    case RollupPeriod::kYear:
+      return "year";
+  }
+  return "month";
+}
+
+std::string RollupBucketLabel(RollupPeriod period, const RollupBucket& bucket) {
+  const absl::CivilDay day = bucket.first_day;
+  switch (period) {
+    case RollupPeriod::kWeek:
+      return absl::FormatCivilTime(day);
+    case RollupPeriod::kMonth:
+      return absl::StrFormat("%04d-%02d", day.year(), day.month());
+    case RollupPeriod::kYear:
+      return absl::StrFormat("%04d", day.year());
+  }
+  return absl::FormatCivilTime(day);
+}
+
+Rollup RollupEntries(absl::Span<const EntryView> entries, RollupPeriod period) {
+  TraceSpan span("rollup");
+  span.Counter("entries", static_cast<int64_t>(entries.size()));
+  RollupBuilder builder(period);
+  // Entries of one day are pushed into one accumulator, so civil dates are computed per day.
+  SummaryAccumulator day_moods;
+  int32_t day = kInvalidDay;
+  absl::CivilDay civil_day;
+  for (const EntryView& entry : entries) {
+    if (entry.day == kInvalidDay) {
+      throw std::runtime_error("Invalid date in data: " + std::string(entry.date));
+    }
+    if (entry.day != day) {
+      if (day_moods.count() > 0) builder.Add(day, day_moods);
+      day_moods = SummaryAccumulator();
+      day = entry.day;
+      civil_day = CivilDayFromDayNumber(day);
+    }
+    day_moods.Push({civil_day, entry.mood});
+  }
+  if (day_moods.count() > 0) builder.Add(day, day_moods);
+  Rollup rollup = builder.Finish();
+  span.Counter("buckets", static_cast<int64_t>(rollup.buckets.size()));
+  return rollup;
+}
+
+Rollup RollupDays(const std::vector<AggregateBucket>& days, RollupPeriod period,
+                  int32_t from_day, int32_t to_day) {
+  TraceSpan span("rollup");
+  const auto key_less = [](const AggregateBucket& bucket, int32_t day) { return bucket.key < day; };
+  RollupBuilder builder(period);
+  for (auto it = std::lower_bound(days.begin(), days.end(), from_day, key_less);
+       it != days.end() && it->key <= to_day; ++it) {
+    const MoodAggregate& mood = it->mood;
+    builder.Add(it->key, SummaryAccumulator::FromMoments(CivilDayFromDayNumber(it->key),
+                                                         mood.count, mood.sum, mood.sum_squares,
+                                                         mood.min, mood.max));
+  }
+  Rollup rollup = builder.Finish();
+  span.Counter("buckets", static_cast<int64_t>(rollup.buckets.size()));
+  return rollup;
+}
+
+}  // namespace life_tracker
@@ -0,0 +1,55 @@
+#ifndef LIFE_TRACKER_ROLLUP_H_
+#define LIFE_TRACKER_ROLLUP_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/time/civil_time.h"
+#include "absl/types/span.h"
+#include "src/aggregate_cache.h"
+#include "src/entry.h"
+#include "src/stats.h"
+
+namespace life_tracker {
+
+// Calendar buckets a rollup groups days into. Weeks run Monday to Sunday.
+enum class RollupPeriod { kWeek, kMonth, kYear };
+
+// Parses "week", "month" or "year". Throws std::runtime_error for anything else.
+RollupPeriod ParseRollupPeriod(std::string_view name);
+// The name ParseRollupPeriod() accepts for `period`.
+const char* RollupPeriodName(RollupPeriod period);
+
+// Mood statistics of the entries in one calendar bucket.
+struct RollupBucket {
+  absl::CivilDay first_day;  // Calendar bounds of the bucket, whatever the data covers.
+  absl::CivilDay last_day;
+  SummaryStats summary;  // best and worst are the bucket's maximum and minimum.
+  int days_with_entries = 0;
+  // Days of the bucket inside the rolled-up date range (first to last day with data), so partial
+  // buckets at either end are not reported as poorly covered.
+  int days_in_range = 0;
+};
+
+struct Rollup {
+  RollupPeriod period = RollupPeriod::kMonth;
+  std::vector<RollupBucket> buckets;  // Oldest first; buckets without entries are left out.
+};
+
+// "2026-01-05" (first day) for weeks, "2026-01" for months, "2026" for years.
+std::string RollupBucketLabel(RollupPeriod period, const RollupBucket& bucket);
+
+// Rolls up `entries`, which must be in date order, in one pass. Throws std::runtime_error if an
+// entry has a malformed date or the entries are out of order.
+Rollup RollupEntries(absl::Span<const EntryView> entries, RollupPeriod period);
+
+// Rolls up the per-day aggregates of an AggregateCache (AggregateCache::days()), keeping the days
+// from `from_day` to `to_day` inclusive. Costs O(days with entries) however many entries there are,
+// and gives the same result as RollupEntries() over those days' entries.
+Rollup RollupDays(const std::vector<AggregateBucket>& days, RollupPeriod period,
+                  int32_t from_day, int32_t to_day);
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_ROLLUP_H_
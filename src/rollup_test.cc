@@ -0,0 +1,145 @@
+#include "src/rollup.h"
+
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/date.h"
+
+namespace life_tracker {
+namespace {
+
+class RollupTest : public ::testing::Test {
+ protected:
+  void Add(const std::string& date, int mood) {
+    dates_.push_back(date);
+    moods_.push_back(mood);
+  }
+
+  std::vector<EntryView> Views() const {
+    std::vector<EntryView> views;
+    for (size_t i = 0; i < dates_.size(); ++i) {
+      EntryView view;
+      view.date = dates_[i];
+      view.mood = moods_[i];
+      view.day = ParseIsoDate(view.date);
+      views.push_back(view);
+    }
+    return views;
+  }
+
+  std::vector<std::string> dates_;
+  std::vector<int> moods_;
+};
+
+TEST(RollupPeriodTest, ParsesKnownNames) {
+  for (const RollupPeriod period :
+       {RollupPeriod::kWeek, RollupPeriod::kMonth, RollupPeriod::kYear}) {
+    EXPECT_EQ(ParseRollupPeriod(RollupPeriodName(period)), period);
+  }
+  EXPECT_THROW(ParseRollupPeriod("decade"), std::runtime_error);
+}
+
+TEST_F(RollupTest, WeeksRunMondayToSunday) {
+  Add("2026-01-04", 10);  // Sunday.
+  Add("2026-01-05", 20);  // Monday.
+  Add("2026-01-05", 40);
+  Add("2026-01-11", 60);  // Sunday.
+  const Rollup rollup = RollupEntries(Views(), RollupPeriod::kWeek);
+  ASSERT_EQ(rollup.buckets.size(), 2u);
+
+  EXPECT_EQ(rollup.buckets[0].first_day, absl::CivilDay(2025, 12, 29));
+  EXPECT_EQ(rollup.buckets[0].last_day, absl::CivilDay(2026, 1, 4));
+  EXPECT_EQ(rollup.buckets[0].summary.count, 1);
+  EXPECT_EQ(rollup.buckets[0].days_in_range, 1);
+
+  const RollupBucket& week = rollup.buckets[1];
+  EXPECT_EQ(RollupBucketLabel(RollupPeriod::kWeek, week), "2026-01-05");
+  EXPECT_EQ(week.summary.count, 3);
+  EXPECT_DOUBLE_EQ(week.summary.average_mood, 40.0);
+  EXPECT_EQ(week.summary.worst.mood, 20);
+  EXPECT_EQ(week.summary.best.mood, 60);
+  EXPECT_EQ(week.days_with_entries, 2);
+  EXPECT_EQ(week.days_in_range, 7);
+}
+
+TEST_F(RollupTest, MonthsAndYearsSkipEmptyBucketsAndClipCoverage) {
+  Add("2024-02-10", 10);
+  Add("2024-02-29", 30);
+  Add("2024-05-01", 50);
+  Add("2025-01-31", 70);
+
+  const Rollup months = RollupEntries(Views(), RollupPeriod::kMonth);
+  ASSERT_EQ(months.buckets.size(), 3u);
+  EXPECT_EQ(RollupBucketLabel(RollupPeriod::kMonth, months.buckets[0]), "2024-02");
+  EXPECT_EQ(months.buckets[0].last_day, absl::CivilDay(2024, 2, 29));
+  EXPECT_EQ(months.buckets[0].days_in_range, 20);  // From the first entry on the 10th.
+  EXPECT_EQ(months.buckets[1].days_in_range, 31);
+  EXPECT_EQ(months.buckets[2].days_in_range, 31);  // Through the last entry on the 31st.
+
+  const Rollup years = RollupEntries(Views(), RollupPeriod::kYear);
+  ASSERT_EQ(years.buckets.size(), 2u);
+  EXPECT_EQ(RollupBucketLabel(RollupPeriod::kYear, years.buckets[0]), "2024");
+  EXPECT_EQ(years.buckets[0].summary.count, 3);
+  EXPECT_EQ(years.buckets[0].days_with_entries, 3);
+  EXPECT_EQ(years.buckets[0].days_in_range, 326);
+  EXPECT_EQ(years.buckets[1].days_in_range, 31);
+}
+
+TEST_F(RollupTest, RejectsUnsortedAndInvalidEntries) {
+  Add("2026-01-02", 10);
+  Add("2026-01-01", 20);
+  EXPECT_THROW(RollupEntries(Views(), RollupPeriod::kMonth), std::runtime_error);
+
+  dates_ = {"2026-01-01", "2026-13-01"};
+  EXPECT_THROW(RollupEntries(Views(), RollupPeriod::kMonth), std::runtime_error);
+  EXPECT_TRUE(RollupEntries({}, RollupPeriod::kWeek).buckets.empty());
+}
+
+TEST_F(RollupTest, DailyAggregatesGiveTheSameRollup) {
+  std::mt19937 rng(3);
+  AggregateCache cache;
+  for (int32_t day = DayNumberFromCivil(2023, 11, 20); day < DayNumberFromCivil(2025, 3, 1);
+       ++day) {
+    if (rng() % 5 == 0) continue;
+    char date[10];
+    FormatIsoDate(day, date);
+    for (unsigned n = 1 + rng() % 3; n > 0; --n) {
+      const int mood = 1 + static_cast<int>(rng() % 100);
+      Add(std::string(date, sizeof(date)), mood);
+      cache.Add(day, mood);
+    }
+  }
+
+  for (const RollupPeriod period :
+       {RollupPeriod::kWeek, RollupPeriod::kMonth, RollupPeriod::kYear}) {
+    const Rollup expected = RollupEntries(Views(), period);
+    const Rollup actual = RollupDays(cache.days(), period, std::numeric_limits<int32_t>::min(),
+                                     std::numeric_limits<int32_t>::max());
+    ASSERT_EQ(actual.buckets.size(), expected.buckets.size());
+    for (size_t i = 0; i < expected.buckets.size(); ++i) {
+      const RollupBucket& a = actual.buckets[i];
+      const RollupBucket& e = expected.buckets[i];
+      EXPECT_EQ(a.first_day, e.first_day);
+      EXPECT_EQ(a.summary.count, e.summary.count);
+      EXPECT_NEAR(a.summary.average_mood, e.summary.average_mood, 1e-9);
+      EXPECT_NEAR(a.summary.stddev, e.summary.stddev, 1e-9);
+      EXPECT_EQ(a.summary.best.mood, e.summary.best.mood);
+      EXPECT_EQ(a.summary.worst.mood, e.summary.worst.mood);
+      EXPECT_EQ(a.days_with_entries, e.days_with_entries);
+      EXPECT_EQ(a.days_in_range, e.days_in_range);
+    }
+  }
+
+  const Rollup january = RollupDays(cache.days(), RollupPeriod::kMonth,
+                                    DayNumberFromCivil(2024, 1, 1),
+                                    DayNumberFromCivil(2024, 1, 31));
+  ASSERT_EQ(january.buckets.size(), 1u);
+  EXPECT_EQ(RollupBucketLabel(RollupPeriod::kMonth, january.buckets[0]), "2024-01");
+}
+
+}  // namespace
+}  // namespace life_tracker
@@ -0,0 +1,383 @@
+#include "src/serve.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "absl/strings/numbers.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "src/binary_io.h"
+#include "src/command_output.h"
+#include "src/compaction.h"
+#include "src/csv_scanner.h"
+#include "src/dashboard_data.h"
+#include "src/date.h"
+#include "src/export_writer.h"
+#include "src/rollup.h"
+#include "src/trend.h"
+
+#if !defined(_WIN32)
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace life_tracker {
+namespace {
+
+// Largest message either side accepts. A client runs a bigger request itself instead of sending
+// it, and the daemon answers with an error in place of a bigger response.
+constexpr uint32_t kMaxMessageSize = 256 << 20;
+
+using Params = std::map<std::string, std::string>;
+
+const std::string& Param(const Params& params, const std::string& key) {
+  static const std::string kEmpty;
+  auto it = params.find(key);
+  return it == params.end() ? kEmpty : it->second;
+}
+
+int IntParam(const Params& params, const std::string& key, int default_value) {
+  const std::string& value = Param(params, key);
+  if (value.empty()) return default_value;
+  int parsed = 0;
+  if (!absl::SimpleAtoi(absl::string_view(value.data(), value.size()), &parsed)) {
+    throw std::runtime_error("Invalid --" + key + ": " + value);
+  }
+  return parsed;
+}
+
+int32_t DayParam(const Params& params, const std::string& key) {
+  const int32_t day = ParseIsoDate(Param(params, key));
+  if (day == kInvalidDay) throw std::runtime_error("--" + key + " must be a valid YYYY-MM-DD.");
+  return day;
+}
+
+// The request's --days windows (see ParseDayWindows()), 7 days if it has none.
+std::vector<int> DayWindowsParam(const Params& params) {
+  const std::string& value = Param(params, "days");
+  return ParseDayWindows(value.empty() ? "7" : value);
+}
+
+// The request's merge policy (see ParseMergePolicy()), keep if it has none.
+MergePolicy MergePolicyParam(const Params& params) {
+  const std::string& value = Param(params, "merge");
+  return ParseMergePolicy(value.empty() ? "keep" : value);
+}
+
+// The request's from/to window, or every day if it has none.
+std::pair<int32_t, int32_t> WindowParams(const Params& params) {
+  if (params.count("from") == 0) {
+    return {std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()};
+  }
+  return {DayParam(params, "from"), DayParam(params, "to")};
+}
+
+#if !defined(_WIN32)
+bool FillSocketAddress(const std::string& path, sockaddr_un* addr) {
+  *addr = sockaddr_un();
+  addr->sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr->sun_path)) return false;
+  path.copy(addr->sun_path, path.size());
+  return true;
+}
+
+bool SendAll(int fd, std::string_view bytes) {
+#if defined(MSG_NOSIGNAL)
+  constexpr int kFlags = MSG_NOSIGNAL;
+#else
+  constexpr int kFlags = 0;
+#endif
+  while (!bytes.empty()) {
+    const ssize_t sent = send(fd, bytes.data(), bytes.size(), kFlags);
+    if (sent < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    bytes.remove_prefix(static_cast<size_t>(sent));
+  }
+  return true;
+}
+
+bool ReceiveAll(int fd, char* out, size_t size) {
+  while (size > 0) {
+    const ssize_t received = recv(fd, out, size, 0);
+    if (received < 0 && errno == EINTR) continue;
+    if (received <= 0) return false;
+    out += received;
+    size -= static_cast<size_t>(received);
+  }
+  return true;
+}
+
+// Sends an EncodeMessage() payload behind its length.
+bool WritePayload(int fd, std::string_view payload) {
+  std::string framed;
+  AppendRaw<uint32_t>(&framed, static_cast<uint32_t>(payload.size()));
+  framed += payload;
+  return SendAll(fd, framed);
+}
+
+bool ReadMessage(int fd, std::vector<std::string>* fields) {
+  char header[sizeof(uint32_t)];
+  if (!ReceiveAll(fd, header, sizeof(header))) return false;
+  const uint32_t size = ReadRaw<uint32_t>(header);
+  if (size > kMaxMessageSize) return false;
+  std::string payload(size, '\0');
+  return ReceiveAll(fd, payload.data(), size) && DecodeMessage(payload, fields);
+}
+
+// Connects to the daemon at `path`; returns -1 if none is listening.
+int ConnectTo(const std::string& path) {
+  sockaddr_un addr;
+  if (!FillSocketAddress(path, &addr)) return -1;
+  const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  if (connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+#endif
+
+}  // namespace
+
+std::string EncodeMessage(const std::vector<std::string>& fields) {
+  std::string out;
+  AppendRaw<uint32_t>(&out, static_cast<uint32_t>(fields.size()));
+  for (const std::string& field : fields) {
+    AppendRaw<uint32_t>(&out, static_cast<uint32_t>(field.size()));
+    out += field;
+  }
+  return out;
+}
+
+bool DecodeMessage(std::string_view payload, std::vector<std::string>* fields) {
+  ByteReader reader(payload);
+  uint32_t count = 0;
+  if (!reader.Read(&count) || count > reader.remaining() / sizeof(uint32_t)) return false;
+  fields->clear();
+  fields->reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t size = 0;
+    if (!reader.Read(&size) || size > reader.remaining()) return false;
+    fields->emplace_back(payload.substr(payload.size() - reader.remaining(), size));
+    reader.Skip(size);
+  }
+  return reader.remaining() == 0;
+}
+
+std::string DefaultSocketPath(const std::string& data_path) { return data_path + ".sock"; }
+
+Server::Server(std::string data_path, AppendOptions append_options)
+    : data_path_(std::move(data_path)), tracker_(data_path_, append_options) {
+  LoadOptions options;
+  options.use_mmap = true;
+  options.threads = 0;
+  options.detach = true;
+  options.intern_notes = true;
+  tracker_.Load(options);
+}
+
+std::vector<std::string> Server::Handle(const std::vector<std::string>& request) {
+  std::ostringstream out;
+  try {
+    if (request.empty() || request.size() % 2 == 0) {
+      throw std::runtime_error("Malformed request.");
+    }
+    Params params;
+    for (size_t i = 1; i + 1 < request.size(); i += 2) params[request[i]] = request[i + 1];
+    const std::string& command = request[0];
+    const std::string& data_path = Param(params, "data_path");
+    if (!data_path.empty() && data_path != data_path_) {
+      throw std::runtime_error("This daemon serves " + data_path_ + ", not " + data_path + ".");
+    }
+
+    tracker_.Refresh();
+    const absl::CivilDay today = absl::ToCivilDay(absl::Now(), absl::UTCTimeZone());
+    if (command == "add") {
+      const int compact_threshold = IntParam(params, "compact_threshold", 0);
+      const MergePolicy policy = MergePolicyParam(params);
+      if (params.count("entries")) {
+        std::vector<Entry> entries;
+        const std::string& csv = Param(params, "entries");
+        CsvScanner scanner(csv);
+        EntryView view;
+        std::string unescaped;
+        while (scanner.Next(&view, &unescaped)) entries.push_back(view.ToEntry());
+        tracker_.AddBatch(entries);
+        PrintAddedCount(entries.size(), out);
+      } else {
+        Entry entry;
+        entry.date = Param(params, "date");
+        entry.mood = IntParam(params, "mood", 0);
+        entry.note = Param(params, "note");
+        tracker_.Add(entry);
+        PrintAdded(entry, out);
+      }
+      if (compact_threshold > 0) {
+        const std::optional<CompactionStats> stats =
+            tracker_.CompactIfOutOfOrder(static_cast<uint64_t>(compact_threshold), policy);
+        if (stats) PrintCompacted(*stats, policy, out);
+      }
+    } else if (command == "compact") {
+      const MergePolicy policy = MergePolicyParam(params);
+      PrintCompacted(tracker_.Compact(policy), policy, out);
+    } else if (command == "list") {
+      const std::vector<EntryView>& views = tracker_.Views();
+      const size_t limit = static_cast<size_t>(std::max(IntParam(params, "limit", 0), 0));
+      const size_t first = limit > 0 && limit < views.size() ? views.size() - limit : 0;
+      PrintEntryList(absl::MakeConstSpan(views).subspan(first), out);
+    } else if (command == "search") {
+      const auto [from, to] = WindowParams(params);
+      const size_t limit = static_cast<size_t>(std::max(IntParam(params, "limit", 0), 0));
+      PrintSearchResults(tracker_.Search(Param(params, "query"), from, to, limit), out);
+    } else if (command == "summary") {
+      PrintWindowSummaries(tracker_.Aggregates().SummarizeWindows(DayWindowsParam(params), today),
+                           out);
+    } else if (command == "streak") {
+      PrintStreaks(tracker_.Aggregates().Streaks(today), out);
+    } else if (command == "rollup") {
+      const auto [from, to] = WindowParams(params);
+      PrintRollup(RollupDays(tracker_.Aggregates().days(), ParseRollupPeriod(Param(params, "by")),
+                             from, to),
+                  out);
+    } else if (command == "export") {
+      const bool windowed = params.count("from") > 0;
+      const absl::Span<const EntryView> entries =
+          windowed ? tracker_.Query(DayParam(params, "from"), DayParam(params, "to"))
+                   : absl::MakeConstSpan(tracker_.Views());
+      const std::string& format = Param(params, "format");
+      const std::string& by = Param(params, "by");
+      const AggregateCache& aggregates = tracker_.Aggregates();
+      const ExportFormat export_format = ParseExportFormat(format.empty() ? "json" : format);
+      const auto [from, to] = WindowParams(params);
+      // Like the CLI: a window's summary and streak describe only the exported entries, as of the
+      // window's last day.
+      const AggregateCache in_window =
+          windowed ? aggregates.Between(from, to) : AggregateCache();
+      const AggregateCache& described = windowed ? in_window : aggregates;
+      const absl::CivilDay reference = windowed ? CivilDayFromDayNumber(to) : today;
+      const std::vector<int> windows =
+          windowed ? std::vector<int>{to - from + 1} : DayWindowsParam(params);
+      std::optional<Rollup> rollup;
+      if (!by.empty()) rollup = RollupDays(aggregates.days(), ParseRollupPeriod(by), from, to);
+      std::optional<Trend> trend;
+      if (export_format == ExportFormat::kJson) trend = TrendDays(aggregates.days(), from, to);
+      WriteExportFile(Param(params, "out"), export_format, entries,
+                      described.SummarizeWindows(windows, reference),
+                      described.Streaks(reference), rollup ? &*rollup : nullptr,
+                      trend ? &*trend : nullptr);
+    } else if (command == "dashboard") {
+      const std::vector<int> windows = DayWindowsParam(params);
+      const auto [from, to] = WindowParams(params);
+      const AggregateCache& aggregates = tracker_.Aggregates();
+      PrintDashboardWritten(WriteDashboardData(Param(params, "out"), tracker_.Query(from, to),
+                                               aggregates.SummarizeWindows(windows, today),
+                                               aggregates.Streaks(today),
+                                               TrendDays(aggregates.days(), from, to)),
+                            out);
+    } else {
+      throw std::runtime_error("Unsupported command for life serve: " + command);
+    }
+  } catch (const std::exception& e) {
+    return {"2", out.str(), std::string("Error: ") + e.what() + "\n"};
+  }
+  return {"0", out.str(), ""};
+}
+
+#if !defined(_WIN32)
+void Server::Serve(const std::string& socket_path) {
+  sockaddr_un addr;
+  if (!FillSocketAddress(socket_path, &addr)) {
+    throw std::runtime_error("Socket path is too long: " + socket_path);
+  }
+  // A socket file nobody answers on is left over from a daemon that did not exit cleanly.
+  const int existing = ConnectTo(socket_path);
+  if (existing >= 0) {
+    close(existing);
+    throw std::runtime_error("Another daemon is already listening on " + socket_path);
+  }
+  unlink(socket_path.c_str());
+
+  const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0 ||
+      bind(listener, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+      listen(listener, 64) != 0) {
+    if (listener >= 0) close(listener);
+    throw std::runtime_error("Failed to listen on " + socket_path);
+  }
+  signal(SIGPIPE, SIG_IGN);  // A client that hangs up must not take the daemon down.
+
+  while (!stop_.load()) {
+    pollfd ready = {listener, POLLIN, 0};
+    const int polled = poll(&ready, 1, /*timeout_ms=*/200);
+    // Idle or not, appends held back by an interval sync policy are flushed on time.
+    try {
+      tracker_.SyncIfDue();
+    } catch (const std::exception& e) {
+      std::cerr << "Error: " << e.what() << "\n";
+    }
+    if (polled <= 0) continue;
+    const int client = accept(listener, nullptr, nullptr);
+    if (client < 0) continue;
+    // Never let one stalled client hold up everyone else for long.
+    timeval timeout = {2, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    std::vector<std::string> request;
+    if (ReadMessage(client, &request)) {
+      std::string response = EncodeMessage(Handle(request));
+      if (response.size() > kMaxMessageSize) {
+        response = EncodeMessage(
+            {"2", "",
+             "Error: The output (" + std::to_string(response.size()) +
+                 " bytes) is too large to send from the daemon; rerun with --forward=false.\n"});
+      }
+      WritePayload(client, response);
+    }
+    close(client);
+  }
+  close(listener);
+  unlink(socket_path.c_str());
+  tracker_.Close();
+}
+
+bool ForwardRequest(const std::string& socket_path, const std::vector<std::string>& request,
+                    std::vector<std::string>* response) {
+  // Too big for the daemon to accept; run it here instead.
+  const std::string payload = EncodeMessage(request);
+  if (payload.size() > kMaxMessageSize) return false;
+  const int fd = ConnectTo(socket_path);
+  if (fd < 0) return false;
+  const bool ok = WritePayload(fd, payload) && ReadMessage(fd, response) && response->size() == 3;
+  close(fd);
+  if (!ok) throw std::runtime_error("Lost connection to the daemon on " + socket_path);
+  return true;
+}
+#else
+void Server::Serve(const std::string& socket_path) {
+  (void)socket_path;
+  throw std::runtime_error("life serve needs Unix domain sockets, which this build lacks.");
+}
+
+bool ForwardRequest(const std::string& socket_path, const std::vector<std::string>& request,
+                    std::vector<std::string>* response) {
+  (void)socket_path;
+  (void)request;
+  (void)response;
+  return false;
+}
+#endif
+
+}  // namespace life_tracker
@@ -0,0 +1,64 @@
+#ifndef LIFE_TRACKER_SERVE_H_
+#define LIFE_TRACKER_SERVE_H_
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "src/append_log.h"
+#include "src/tracker.h"
+
+namespace life_tracker {
+
+// `life serve` keeps a data file's entries and aggregates resident and answers commands over a
+// Unix domain socket, so scripts that run `life` many times a minute skip the load each time.
+//
+// Protocol: one request and one response per connection. Each message is a list of strings,
+// framed as a uint32 byte length followed by the payload; the payload is a uint32 field count
+// followed by each field as a uint32 length and its bytes. Integers are in host byte order, as
+// both ends run on the same machine.
+//   request:  command, then key/value pairs (data_path, mood, note, date, entries, limit, days,
+//             from, to, out, format, by, merge, compact_threshold)
+//   response: exit code, stdout text, stderr text
+
+std::string EncodeMessage(const std::vector<std::string>& fields);
+// Returns false if `payload` is not exactly one well-formed message.
+bool DecodeMessage(std::string_view payload, std::vector<std::string>* fields);
+
+// The socket a daemon for `data_path` listens on unless told otherwise.
+std::string DefaultSocketPath(const std::string& data_path);
+
+class Server {
+ public:
+  // Loads `data_path` (detached, so appends by other processes can be read incrementally).
+  Server(std::string data_path, AppendOptions append_options);
+
+  // Answers one request. Errors are reported in the response rather than thrown.
+  std::vector<std::string> Handle(const std::vector<std::string>& request);
+
+  // Listens on `socket_path` and answers connections one at a time until Stop(). Between
+  // connections, appends held back by an interval sync policy are synced as they fall due; a
+  // failed sync is reported on stderr and retried. Throws std::runtime_error if the socket cannot
+  // be created or another daemon already owns it, or if the final sync on exit fails.
+  void Serve(const std::string& socket_path);
+  // Makes Serve() return within a fraction of a second. Safe to call from a signal handler or
+  // another thread.
+  void Stop() { stop_.store(true); }
+
+ private:
+  std::string data_path_;
+  Tracker tracker_;
+  std::atomic<bool> stop_{false};
+};
+
+// Sends `request` to the daemon listening on `socket_path` and stores its reply in `*response`.
+// Returns false, having sent nothing, if no daemon is listening there or `request` is over the
+// daemon's message size limit, so the caller runs it itself. Throws
+// std::runtime_error if the daemon accepts the request but the exchange fails.
+bool ForwardRequest(const std::string& socket_path, const std::vector<std::string>& request,
+                    std::vector<std::string>* response);
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_SERVE_H_
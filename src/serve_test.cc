@@ -0,0 +1,187 @@
+#include "src/serve.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/test_util.h"
+
+namespace life_tracker {
+namespace {
+
+class ServeTest : public TempDirTest {
+ protected:
+  void SetUp() override {
+    TempDirTest::SetUp();
+    data_path_ = (dir_ / "entries.csv").string();
+    std::ofstream out(data_path_, std::ios::binary);
+    out << "2026-01-01,10,first\n2026-01-02,20,second\n";
+  }
+
+  std::string data_path_;
+};
+
+TEST(MessageTest, RoundTripsFields) {
+  const std::vector<std::string> fields = {"add", "", std::string("a\0b", 3), "note,\"x\"\n"};
+  std::vector<std::string> decoded;
+  ASSERT_TRUE(DecodeMessage(EncodeMessage(fields), &decoded));
+  EXPECT_EQ(decoded, fields);
+
+  ASSERT_TRUE(DecodeMessage(EncodeMessage({}), &decoded));
+  EXPECT_TRUE(decoded.empty());
+}
+
+TEST(MessageTest, RejectsTruncatedAndTrailingBytes) {
+  const std::string payload = EncodeMessage({"list", "limit", "3"});
+  std::vector<std::string> decoded;
+  EXPECT_FALSE(DecodeMessage(payload.substr(0, payload.size() - 1), &decoded));
+  EXPECT_FALSE(DecodeMessage(payload + "x", &decoded));
+  EXPECT_FALSE(DecodeMessage("", &decoded));
+}
+
+TEST_F(ServeTest, WindowedExportSummarizesTheExportedEntries) {
+  std::ofstream(data_path_, std::ios::binary | std::ios::app)
+      << "2026-01-03,30,third\n2026-03-01,90,later\n";
+  Server server(data_path_, AppendOptions());
+  const std::string out_path = (dir_ / "export.json").string();
+  const std::vector<std::string> response =
+      server.Handle({"export", "out", out_path, "days", "7", "from", "2026-01-02", "to",
+                     "2026-01-03"});
+  ASSERT_EQ(response[0], "0") << response[2];
+
+  const std::string json = ReadFile(out_path);
+  // Two entries averaging 25, not the --days window ending today, which holds none of them.
+  EXPECT_NE(json.find("\"days\":2}"), std::string::npos) << json;
+  EXPECT_NE(json.find("\"count\":2,"), std::string::npos) << json;
+  EXPECT_NE(json.find("\"average_mood\":25.0"), std::string::npos) << json;
+  EXPECT_NE(json.find("\"current\":2"), std::string::npos) << json;
+  EXPECT_EQ(json.find("later"), std::string::npos);
+}
+
+TEST_F(ServeTest, HandlesCommandsAgainstResidentData) {
+  Server server(data_path_, AppendOptions());
+
+  std::vector<std::string> response = server.Handle({"list", "limit", "1"});
+  ASSERT_EQ(response.size(), 3u);
+  EXPECT_EQ(response[0], "0");
+  EXPECT_NE(response[1].find("second"), std::string::npos);
+  EXPECT_EQ(response[1].find("first"), std::string::npos);
+
+  response = server.Handle(
+      {"add", "data_path", data_path_, "date", "2026-01-03", "mood", "30", "note", "third"});
+  EXPECT_EQ(response[0], "0");
+  response = server.Handle({"add", "entries", "2026-01-04,40,fourth\n2026-01-05,50,\"a, b\"\n"});
+  EXPECT_EQ(response[0], "0");
+  EXPECT_NE(response[1].find('2'), std::string::npos);
+
+  response = server.Handle({"list"});
+  EXPECT_NE(response[1].find("a, b"), std::string::npos);
+  EXPECT_NE(response[1].find("third"), std::string::npos);
+
+  response = server.Handle({"rollup", "by", "week", "from", "2026-01-01", "to", "2026-01-04"});
+  ASSERT_EQ(response[0], "0") << response[2];
+  EXPECT_NE(response[1].find("2025-12-29        4     25.0"), std::string::npos) << response[1];
+
+  response = server.Handle({"summary", "days", "7,all"});
+  ASSERT_EQ(response[0], "0") << response[2];
+  EXPECT_EQ(response[1].rfind("Window ", 0), 0u) << response[1];
+  EXPECT_NE(response[1].find("\nall time          5     30.0"), std::string::npos) << response[1];
+
+  response = server.Handle({"search", "query", "A third", "limit", "0"});
+  ASSERT_EQ(response[0], "0") << response[2];
+  EXPECT_EQ(response[1], "No matching entries.\n");
+  response = server.Handle({"search", "query", "B", "from", "2026-01-05", "to", "2026-01-05"});
+  EXPECT_EQ(response[1], "2026-01-05  mood=50  a, b\n");
+
+  EXPECT_NE(ReadFile(data_path_).find("2026-01-05,50,\"a, b\"\n"), std::string::npos);
+}
+
+TEST_F(ServeTest, WritesDashboardShards) {
+  Server server(data_path_, AppendOptions());
+  const std::string out = (dir_ / "dashboard").string();
+  std::vector<std::string> response = server.Handle({"dashboard", "out", out, "days", "7"});
+  ASSERT_EQ(response[0], "0") << response[2];
+  EXPECT_EQ(response[1], "Wrote 1 of 1 monthly shard.\n");
+  EXPECT_TRUE(std::filesystem::exists(std::filesystem::path(out) / "manifest.json"));
+
+  response = server.Handle({"dashboard", "out", out, "from", "2026-01-02", "to", "2026-01-02"});
+  EXPECT_EQ(response[1], "Wrote 1 of 1 monthly shard (removed 1 stale).\n");
+}
+
+TEST_F(ServeTest, PicksUpAppendsFromOtherProcesses) {
+  Server server(data_path_, AppendOptions());
+  EXPECT_EQ(server.Handle({"list"})[1].find("third"), std::string::npos);
+
+  {
+    std::ofstream out(data_path_, std::ios::binary | std::ios::app);
+    out << "2026-01-03,30,third\n";
+  }
+  EXPECT_NE(server.Handle({"list"})[1].find("third"), std::string::npos);
+}
+
+TEST_F(ServeTest, CompactsTheResidentFile) {
+  Server server(data_path_, AppendOptions());
+  std::vector<std::string> response = server.Handle(
+      {"add", "date", "2026-01-01", "mood", "30", "note", "", "compact_threshold", "1", "merge",
+       "mean"});
+  ASSERT_EQ(response[0], "0") << response[2];
+  EXPECT_EQ(response[1],
+            "Added: 2026-01-01 mood=30 note=\"\"\n"
+            "Compacted 3 entries (1 out of date order) into 2 with --merge=mean.\n");
+
+  // Appends after the rewrite land in the new file.
+  response = server.Handle({"add", "date", "2026-01-01", "mood", "40", "note", ""});
+  ASSERT_EQ(response[0], "0") << response[2];
+  response = server.Handle({"compact", "merge", "first"});
+  ASSERT_EQ(response[0], "0") << response[2];
+  EXPECT_EQ(response[1], "Compacted 3 entries (1 out of date order) into 2 with --merge=first.\n");
+  EXPECT_EQ(ReadFile(data_path_), "2026-01-01,20,first\n2026-01-02,20,second\n");
+  EXPECT_EQ(server.Handle({"compact", "merge", "median"})[0], "2");
+}
+
+TEST_F(ServeTest, ReportsErrorsInTheResponse) {
+  Server server(data_path_, AppendOptions());
+  std::vector<std::string> response =
+      server.Handle({"add", "date", "2026-01-03", "mood", "0", "note", ""});
+  EXPECT_EQ(response[0], "2");
+  EXPECT_NE(response[2].find("Mood"), std::string::npos);
+
+  EXPECT_EQ(server.Handle({"summary", "data_path", data_path_ + ".other"})[0], "2");
+  EXPECT_EQ(server.Handle({"rollback"})[0], "2");
+  EXPECT_EQ(server.Handle({"list", "limit"})[0], "2");
+  EXPECT_EQ(server.Handle({"summary", "days", "7,month"})[0], "2");
+}
+
+#if !defined(_WIN32)
+TEST_F(ServeTest, ForwardsOverTheSocket) {
+  // sun_path is short, so keep the socket out of the (possibly deep) test directory.
+  const std::string socket_path =
+      "/tmp/life_serve_test_" + std::to_string(std::hash<std::string>()(data_path_)) + ".sock";
+  std::vector<std::string> response;
+  EXPECT_FALSE(ForwardRequest(socket_path, {"list"}, &response));
+
+  Server server(data_path_, AppendOptions());
+  std::thread serving([&] { server.Serve(socket_path); });
+  bool forwarded = false;
+  for (int attempt = 0; attempt < 500 && !forwarded; ++attempt) {
+    forwarded = ForwardRequest(socket_path, {"list", "data_path", data_path_}, &response);
+    if (!forwarded) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  server.Stop();
+  serving.join();
+
+  ASSERT_TRUE(forwarded);
+  ASSERT_EQ(response.size(), 3u);
+  EXPECT_EQ(response[0], "0");
+  EXPECT_NE(response[1].find("first"), std::string::npos);
+  EXPECT_FALSE(std::filesystem::exists(socket_path));
+}
+#endif
+
+}  // namespace
+}  // namespace life_tracker
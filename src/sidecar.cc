@@ -0,0 +1,83 @@
+#include "src/sidecar.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+#include "src/binary_io.h"
+#include "src/partitions.h"
+
+namespace life_tracker {
+namespace fs = std::filesystem;
+
+DataFileStamp StampDataFile(const std::string& path) {
+  DataFileStamp stamp;
+  if (IsPartitionedDataPath(path)) {
+    // Total size and newest mtime of the partitions; an append to any of them changes both.
+    bool first = true;
+    for (const Partition& partition : ListPartitions(path)) {
+      const DataFileStamp part = StampDataFile(partition.path);
+      stamp.size += part.size;
+      stamp.mtime = first ? part.mtime : std::max(stamp.mtime, part.mtime);
+      first = false;
+    }
+    return stamp;
+  }
+  std::error_code ec;
+  const uintmax_t size = fs::file_size(path, ec);
+  if (ec) return stamp;
+  const fs::file_time_type mtime = fs::last_write_time(path, ec);
+  if (ec) return stamp;
+  stamp.size = size;
+  stamp.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+  return stamp;
+}
+
+bool ReadFreshSidecar(const std::string& data_path, const std::string& sidecar_path,
+                      std::string_view magic, uint32_t version, std::string* contents,
+                      std::string_view* payload) {
+  const DataFileStamp stamp = StampDataFile(data_path);
+  if (stamp.mtime == 0) return false;
+
+  std::ifstream in(sidecar_path, std::ios::binary);
+  if (!in.is_open()) return false;
+  contents->assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+  const std::string_view data(*contents);
+  if (data.substr(0, magic.size()) != magic) return false;
+  ByteReader reader(data.substr(magic.size()));
+  uint32_t cached_version = 0;
+  DataFileStamp cached;
+  if (!reader.Read(&cached_version) || cached_version != version || !reader.Read(&cached.size) ||
+      !reader.Read(&cached.mtime) || cached != stamp) {
+    return false;
+  }
+  *payload = data.substr(data.size() - reader.remaining());
+  return true;
+}
+
+bool WriteSidecar(const std::string& sidecar_path, const DataFileStamp& stamp,
+                  std::string_view magic, uint32_t version, std::string_view payload) {
+  if (stamp.mtime == 0) return false;
+
+  std::string header(magic);
+  AppendRaw<uint32_t>(&header, version);
+  AppendRaw<uint64_t>(&header, stamp.size);
+  AppendRaw<int64_t>(&header, stamp.mtime);
+
+  const std::string tmp_path = sidecar_path + ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    if (!file) return false;
+  }
+  std::error_code ec;
+  fs::rename(tmp_path, sidecar_path, ec);
+  return !ec;
+}
+
+}  // namespace life_tracker
@@ -0,0 +1,53 @@
+#ifndef LIFE_TRACKER_SIDECAR_H_
+#define LIFE_TRACKER_SIDECAR_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace life_tracker {
+
+// Identifies one version of a data file. A sidecar whose stamp no longer matches is stale.
+struct DataFileStamp {
+  uint64_t size = 0;
+  int64_t mtime = 0;  // Filesystem clock ticks; only compared for equality.
+
+  bool operator==(const DataFileStamp& other) const {
+    return size == other.size && mtime == other.mtime;
+  }
+  bool operator!=(const DataFileStamp& other) const { return !(*this == other); }
+};
+
+// Returns the stamp of `path`, or a zero stamp if it does not exist. A partitioned data directory
+// is stamped with the total size and newest mtime of its partitions.
+DataFileStamp StampDataFile(const std::string& path);
+
+// Sidecars are caches derived from a data file and stored next to it (aggregates, note index,
+// date order). Each starts with an 8-byte magic, a uint32 format version and the stamp of the
+// data file it was built from, followed by a payload only its owner understands:
+//
+//     char     magic[8]
+//     uint32   version
+//     uint64   stamp.size
+//     int64    stamp.mtime
+//     ...      payload
+
+// Reads the sidecar at `sidecar_path` into `*contents` and points `*payload` at the bytes after
+// its header. Returns false if the sidecar is missing or truncated, has another magic or version,
+// or is stamped for a different version of `data_path`.
+bool ReadFreshSidecar(const std::string& data_path, const std::string& sidecar_path,
+                      std::string_view magic, uint32_t version, std::string* contents,
+                      std::string_view* payload);
+
+// Writes `payload` to `sidecar_path` behind a header stamped with `stamp`, the version of the
+// data file the payload was built from. A file that has changed since then therefore never
+// matches, even if it changed while the payload was being built. The sidecar is written to a
+// temporary file and renamed into place, so readers never see half of one. Returns false for a
+// zero stamp (no data file) or if the sidecar could not be written; sidecars are best-effort, so
+// callers carry on without one.
+bool WriteSidecar(const std::string& sidecar_path, const DataFileStamp& stamp,
+                  std::string_view magic, uint32_t version, std::string_view payload);
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_SIDECAR_H_
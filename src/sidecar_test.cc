@@ -0,0 +1,77 @@
+#include "src/sidecar.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+#include "src/test_util.h"
+
+namespace life_tracker {
+namespace {
+
+constexpr std::string_view kMagic = "LTTESTSC";
+
+class SidecarTest : public TempDirTest {
+ protected:
+  void SetUp() override {
+    TempDirTest::SetUp();
+    data_path_ = (dir_ / "entries.csv").string();
+    sidecar_path_ = data_path_ + ".test";
+    Append("2026-01-01,10,a\n");
+  }
+
+  void Append(const std::string& text) {
+    std::ofstream(data_path_, std::ios::binary | std::ios::app) << text;
+  }
+
+  bool Read(uint32_t version, std::string* contents, std::string_view* payload) {
+    return ReadFreshSidecar(data_path_, sidecar_path_, kMagic, version, contents, payload);
+  }
+
+  std::string data_path_;
+  std::string sidecar_path_;
+};
+
+TEST_F(SidecarTest, RoundTripsPayloadWhileTheDataIsUnchanged) {
+  ASSERT_TRUE(WriteSidecar(sidecar_path_, StampDataFile(data_path_), kMagic, 3, "payload"));
+  EXPECT_FALSE(std::filesystem::exists(sidecar_path_ + ".tmp"));
+
+  std::string contents;
+  std::string_view payload;
+  ASSERT_TRUE(Read(3, &contents, &payload));
+  EXPECT_EQ(payload, "payload");
+  EXPECT_FALSE(Read(4, &contents, &payload));
+  EXPECT_FALSE(ReadFreshSidecar(data_path_, sidecar_path_, "LTOTHER!", 3, &contents, &payload));
+
+  Append("2026-01-02,20,b\n");
+  EXPECT_FALSE(Read(3, &contents, &payload));
+}
+
+TEST_F(SidecarTest, StampsWithTheVersionThePayloadDescribes) {
+  const DataFileStamp built_from = StampDataFile(data_path_);
+  Append("2026-01-02,20,b\n");
+  ASSERT_TRUE(WriteSidecar(sidecar_path_, built_from, kMagic, 1, "stale"));
+  std::string contents;
+  std::string_view payload;
+  EXPECT_FALSE(Read(1, &contents, &payload));
+}
+
+TEST_F(SidecarTest, RejectsTruncatedSidecarsAndMissingData) {
+  ASSERT_TRUE(WriteSidecar(sidecar_path_, StampDataFile(data_path_), kMagic, 1, ""));
+  std::string contents;
+  std::string_view payload;
+  ASSERT_TRUE(Read(1, &contents, &payload));
+  EXPECT_TRUE(payload.empty());
+
+  std::filesystem::resize_file(sidecar_path_, kMagic.size() + 6);
+  EXPECT_FALSE(Read(1, &contents, &payload));
+
+  std::filesystem::remove(data_path_);
+  EXPECT_FALSE(WriteSidecar(sidecar_path_, StampDataFile(data_path_), kMagic, 1, ""));
+  EXPECT_FALSE(Read(1, &contents, &payload));
+}
+
+}  // namespace
+}  // namespace life_tracker
@@ -2,120 +2,341 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
 #include <stdexcept>
+#include <string>
 
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
 #include "absl/time/time.h"
+#include "src/date.h"
+#include "src/day_bitmap.h"
+#include "src/trace.h"
 
 namespace life_tracker {
+namespace {
 
-absl::CivilDay ParseCivilDay(const std::string& date_str) {
-  absl::Time timestamp;
-  if (!absl::ParseTime("%Y-%m-%d", date_str, absl::UTCTimeZone(), &timestamp, nullptr)) {
-    throw std::runtime_error("Invalid date in data: " + date_str);
-  }
-  return absl::ToCivilDay(timestamp, absl::UTCTimeZone());
-}
+absl::CivilDay DayOf(const Entry& entry) { return ParseCivilDay(entry.date); }
 
-SummaryStats ComputeSummary(const std::vector<DayMood>& samples) {
-  SummaryStats summary;
-  if (samples.empty()) return summary;
-
-  summary.has_data = true;
-  summary.count = static_cast<int>(samples.size());
-  summary.best = samples.front();
-  summary.worst = samples.front();
-
-  int total = 0;
-  for (const auto& sample : samples) {
-    total += sample.mood;
-    if (sample.mood > summary.best.mood ||
-        (sample.mood == summary.best.mood && sample.day < summary.best.day)) {
-      summary.best = sample;
-    }
-    if (sample.mood < summary.worst.mood ||
-        (sample.mood == summary.worst.mood && sample.day < summary.worst.day)) {
-      summary.worst = sample;
-    }
-  }
-
-  summary.average_mood = static_cast<double>(total) / summary.count;
-
-  double variance = 0.0;
-  for (const auto& sample : samples) {
-    const double diff = static_cast<double>(sample.mood) - summary.average_mood;
-    variance += diff * diff;
+absl::CivilDay DayOf(const EntryView& entry) {
+  if (entry.day == kInvalidDay) {
+    throw std::runtime_error("Invalid date in data: " + std::string(entry.date));
   }
-  variance /= summary.count;
-  summary.stddev = std::sqrt(variance);
-  return summary;
+  return CivilDayFromDayNumber(entry.day);
 }
 
-std::vector<DayMood> CollectRecentSamples(const std::vector<Entry>& entries, int days,
-                                          absl::CivilDay today) {
+template <typename Entries>
+std::vector<DayMood> CollectRecentSamplesImpl(const Entries& entries, int days,
+                                              absl::CivilDay today) {
   if (days <= 0) {
     throw std::runtime_error("--days must be positive.");
   }
 
+  // Converts each entry's date to a civil day, so this is where `report` pays for dates.
+  TraceSpan span("collect_samples");
+  span.Counter("entries", static_cast<int64_t>(entries.size()));
   const absl::CivilDay cutoff = today - (days - 1);
 
   std::vector<DayMood> samples;
   samples.reserve(entries.size());
   for (const auto& entry : entries) {
-    const absl::CivilDay entry_day = ParseCivilDay(entry.date);
+    const absl::CivilDay entry_day = DayOf(entry);
     if (entry_day < cutoff) continue;
     samples.push_back({entry_day, entry.mood});
   }
 
-  std::sort(samples.begin(), samples.end(),
-            [](const DayMood& a, const DayMood& b) { return a.day < b.day; });
-
+  const auto day_less = [](const DayMood& a, const DayMood& b) { return a.day < b.day; };
+  if (!std::is_sorted(samples.begin(), samples.end(), day_less)) {
+    std::sort(samples.begin(), samples.end(), day_less);
+  }
+  span.Counter("samples", static_cast<int64_t>(samples.size()));
   return samples;
 }
 
-StreakStats ComputeStreaks(const std::vector<Entry>& entries, absl::CivilDay today) {
-  StreakStats streaks;
-  if (entries.empty()) return streaks;
+int32_t DayNumberOf(const Entry& entry) { return DayNumberFromCivilDay(DayOf(entry)); }
+
+int32_t DayNumberOf(const EntryView& entry) {
+  if (entry.day == kInvalidDay) {
+    throw std::runtime_error("Invalid date in data: " + std::string(entry.date));
+  }
+  return entry.day;
+}
 
-  std::vector<absl::CivilDay> days;
-  days.reserve(entries.size());
+template <typename Entries>
+StreakStats ComputeStreaksImpl(const Entries& entries, absl::CivilDay today) {
+  TraceSpan span("compute_streaks");
+  span.Counter("entries", static_cast<int64_t>(entries.size()));
+  DayBitmap days;
   for (const auto& entry : entries) {
-    days.push_back(ParseCivilDay(entry.date));
+    days.Set(DayNumberOf(entry));
+  }
+  return ComputeStreaks(days, today);
+}
+
+}  // namespace
+
+absl::CivilDay ParseCivilDay(std::string_view date_str) {
+  const int32_t day = ParseIsoDate(date_str);
+  if (day == kInvalidDay) {
+    throw std::runtime_error("Invalid date in data: " + std::string(date_str));
+  }
+  return CivilDayFromDayNumber(day);
+}
+
+void MoodHistogram::Add(int mood, int64_t count) {
+  counts_[std::clamp(mood, 0, kMaxMood)] += count;
+  total_ += count;
+}
+
+void MoodHistogram::Merge(const MoodHistogram& other) {
+  if (other.total_ == 0) return;
+  for (int mood = 0; mood <= kMaxMood; ++mood) counts_[mood] += other.counts_[mood];
+  total_ += other.total_;
+}
+
+int MoodHistogram::MoodAtRank(int64_t rank) const {
+  int64_t seen = 0;
+  for (int mood = 0; mood <= kMaxMood; ++mood) {
+    seen += counts_[mood];
+    if (seen >= rank) return mood;
+  }
+  return kMaxMood;
+}
+
+int MoodHistogram::Percentile(double fraction) const {
+  const auto rank = static_cast<int64_t>(std::ceil(fraction * static_cast<double>(total_)));
+  return MoodAtRank(std::max<int64_t>(rank, 1));
+}
+
+MoodDistribution MoodHistogram::Distribution() const {
+  MoodDistribution distribution;
+  if (total_ == 0) return distribution;
+  const int64_t middle = (total_ + 1) / 2;
+  distribution.median = total_ % 2 == 1
+                            ? MoodAtRank(middle)
+                            : (MoodAtRank(middle) + MoodAtRank(middle + 1)) / 2.0;
+  distribution.p10 = Percentile(0.10);
+  distribution.p25 = Percentile(0.25);
+  distribution.p75 = Percentile(0.75);
+  distribution.p90 = Percentile(0.90);
+  distribution.iqr = distribution.p75 - distribution.p25;
+  for (int mood = 0; mood <= kMaxMood; ++mood) {
+    if (counts_[mood] > counts_[distribution.mode]) distribution.mode = mood;
+  }
+  return distribution;
+}
+
+void SummaryAccumulator::Push(const DayMood& sample) {
+  if (count_ == 0 || sample.mood > best_.mood ||
+      (sample.mood == best_.mood && sample.day < best_.day)) {
+    best_ = sample;
+  }
+  if (count_ == 0 || sample.mood < worst_.mood ||
+      (sample.mood == worst_.mood && sample.day < worst_.day)) {
+    worst_ = sample;
+  }
+  ++count_;
+  moods_.Add(sample.mood);
+  const double delta = sample.mood - mean_;
+  mean_ += delta / static_cast<double>(count_);
+  m2_ += delta * (sample.mood - mean_);
+}
+
+void SummaryAccumulator::Merge(const SummaryAccumulator& other) {
+  if (other.count_ == 0) return;
+  if (count_ == 0) {
+    *this = other;
+    return;
+  }
+  if (other.best_.mood > best_.mood ||
+      (other.best_.mood == best_.mood && other.best_.day < best_.day)) {
+    best_ = other.best_;
+  }
+  if (other.worst_.mood < worst_.mood ||
+      (other.worst_.mood == worst_.mood && other.worst_.day < worst_.day)) {
+    worst_ = other.worst_;
+  }
+  const double n_a = static_cast<double>(count_);
+  const double n_b = static_cast<double>(other.count_);
+  const double n = n_a + n_b;
+  const double delta = other.mean_ - mean_;
+  mean_ += delta * n_b / n;
+  m2_ += other.m2_ + delta * delta * n_a * n_b / n;
+  count_ += other.count_;
+  moods_.Merge(other.moods_);
+}
+
+SummaryAccumulator SummaryAccumulator::FromMoments(absl::CivilDay day, int64_t count, int64_t sum,
+                                                   int64_t sum_squares, int min, int max) {
+  SummaryAccumulator acc;
+  if (count <= 0) return acc;
+  acc.count_ = count;
+  acc.mean_ = static_cast<double>(sum) / static_cast<double>(count);
+  // sum_squares - sum^2 / count, with the subtraction done on the exact integer quotient first
+  // so the cancellation only affects the remainder term.
+  const int64_t whole = sum / count;
+  const int64_t remainder = sum % count;
+  const double m2 = static_cast<double>(sum_squares - whole * sum) -
+                    static_cast<double>(remainder) * acc.mean_;
+  acc.m2_ = std::max(m2, 0.0);
+  acc.best_ = {day, max};
+  acc.worst_ = {day, min};
+  return acc;
+}
+
+SummaryStats SummaryAccumulator::Result() const {
+  SummaryStats summary;
+  if (count_ == 0) return summary;
+  summary.has_data = true;
+  summary.count = count_;
+  summary.average_mood = mean_;
+  summary.stddev = std::sqrt(m2_ / static_cast<double>(count_));
+  summary.best = best_;
+  summary.worst = worst_;
+  summary.has_distribution = moods_.count() == count_;
+  if (summary.has_distribution) summary.distribution = moods_.Distribution();
+  return summary;
+}
+
+WindowedSummaries::WindowedSummaries(absl::Span<const int> windows, absl::CivilDay today)
+    : windows_(windows.begin(), windows.end()) {
+  const int32_t today_number = DayNumberFromCivilDay(today);
+  std::vector<int32_t> cutoffs;
+  for (const int days : windows_) {
+    if (days < 0) throw std::runtime_error("--days must be positive.");
+    cutoffs.push_back(days == 0 ? std::numeric_limits<int32_t>::min() : today_number - (days - 1));
   }
-  std::sort(days.begin(), days.end());
-  days.erase(std::unique(days.begin(), days.end()), days.end());
+  cutoffs_ = cutoffs;
+  std::sort(cutoffs_.begin(), cutoffs_.end(), std::greater<int32_t>());
+  cutoffs_.erase(std::unique(cutoffs_.begin(), cutoffs_.end()), cutoffs_.end());
+  for (const int32_t cutoff : cutoffs) {
+    ring_of_.push_back(static_cast<size_t>(
+        std::find(cutoffs_.begin(), cutoffs_.end(), cutoff) - cutoffs_.begin()));
+  }
+  rings_.resize(cutoffs_.size());
+  ring_moods_.resize(cutoffs_.size());
+}
+
+int WindowedSummaries::Ring(int32_t day) const {
+  // A handful of windows, so a linear scan beats a binary search.
+  for (size_t ring = 0; ring < cutoffs_.size(); ++ring) {
+    if (day >= cutoffs_[ring]) return static_cast<int>(ring);
+  }
+  return -1;
+}
 
-  int longest = 0;
-  int current_run = 0;
-  absl::CivilDay prev = days.front() - 1;
-  for (const auto& day : days) {
-    if (day == prev + 1) {
-      ++current_run;
+void WindowedSummaries::Push(int32_t day, int mood) {
+  const int ring = Ring(day);
+  if (ring >= 0) rings_[ring].Push({CivilDayFromDayNumber(day), mood});
+}
+
+void WindowedSummaries::MergeMoments(int32_t day, const SummaryAccumulator& moments) {
+  const int ring = Ring(day);
+  if (ring >= 0) rings_[ring].Merge(moments);
+}
+
+void WindowedSummaries::AddMoods(int32_t day, int mood, int64_t count) {
+  const int ring = Ring(day);
+  if (ring >= 0) ring_moods_[ring].Add(mood, count);
+}
+
+std::vector<WindowSummary> WindowedSummaries::Results() const {
+  std::vector<SummaryStats> by_ring;
+  SummaryAccumulator acc;
+  MoodHistogram moods;
+  for (size_t ring = 0; ring < rings_.size(); ++ring) {
+    acc.Merge(rings_[ring]);
+    moods.Merge(ring_moods_[ring]);
+    SummaryAccumulator window = acc;
+    window.AddMoods(moods);
+    by_ring.push_back(window.Result());
+  }
+  std::vector<WindowSummary> results;
+  for (size_t i = 0; i < windows_.size(); ++i) {
+    results.push_back({windows_[i], by_ring[ring_of_[i]]});
+  }
+  return results;
+}
+
+std::vector<int> ParseDayWindows(std::string_view list) {
+  std::vector<int> windows;
+  for (const absl::string_view part : absl::StrSplit(absl::string_view(list.data(), list.size()),
+                                                    ',')) {
+    const absl::string_view token = absl::StripAsciiWhitespace(part);
+    int days = 0;
+    if (token == "all") {
+      windows.push_back(0);
+    } else if (absl::SimpleAtoi(token, &days) && days > 0) {
+      windows.push_back(days);
     } else {
-      current_run = 1;
-    }
-    longest = std::max(longest, current_run);
-    prev = day;
-  }
-
-  int current = 0;
-  if (!days.empty()) {
-    const absl::CivilDay latest = days.back();
-    if (latest == today || latest == today - 1) {
-      current = 1;
-      for (int i = static_cast<int>(days.size()) - 2; i >= 0; --i) {
-        if (days[i] == days[i + 1] - 1) {
-          ++current;
-        } else {
-          break;
-        }
-      }
+      throw std::runtime_error(
+          "--days must be a positive number of days or a comma-separated list of them, with "
+          "\"all\" for all time (e.g. --days=7,30,all).");
     }
   }
+  return windows;
+}
 
-  streaks.current_streak = current;
-  streaks.longest_streak = longest;
+SummaryStats ComputeSummary(const std::vector<DayMood>& samples) {
+  TraceSpan span("compute_summary");
+  span.Counter("samples", static_cast<int64_t>(samples.size()));
+  SummaryAccumulator acc;
+  for (const DayMood& sample : samples) acc.Push(sample);
+  return acc.Result();
+}
+
+SummaryStats ComputeRecentSummary(absl::Span<const EntryView> entries, int days,
+                                  absl::CivilDay today) {
+  if (days <= 0) {
+    throw std::runtime_error("--days must be positive.");
+  }
+  const int windows[] = {days};
+  return ComputeWindowSummaries(entries, windows, today)[0].summary;
+}
+
+std::vector<WindowSummary> ComputeWindowSummaries(absl::Span<const EntryView> entries,
+                                                  absl::Span<const int> windows,
+                                                  absl::CivilDay today) {
+  TraceSpan span("compute_summary");
+  span.Counter("entries", static_cast<int64_t>(entries.size()));
+  span.Counter("windows", static_cast<int64_t>(windows.size()));
+  WindowedSummaries summaries(windows, today);
+  for (const EntryView& entry : entries) summaries.Push(DayNumberOf(entry), entry.mood);
+  return summaries.Results();
+}
+
+std::vector<DayMood> CollectRecentSamples(const std::vector<Entry>& entries, int days,
+                                          absl::CivilDay today) {
+  return CollectRecentSamplesImpl(entries, days, today);
+}
+
+std::vector<DayMood> CollectRecentSamples(absl::Span<const EntryView> entries, int days,
+                                          absl::CivilDay today) {
+  return CollectRecentSamplesImpl(entries, days, today);
+}
+
+StreakStats ComputeStreaks(const DayBitmap& days, absl::CivilDay today) {
+  StreakStats streaks;
+  if (days.empty()) return streaks;
+
+  const int32_t latest = days.last_day();
+  const int32_t today_number = DayNumberFromCivilDay(today);
+  if (latest == today_number || latest == today_number - 1) {
+    streaks.current_streak = days.RunEndingAt(latest);
+  }
+  streaks.longest_streak = days.LongestRun();
   return streaks;
 }
 
+StreakStats ComputeStreaks(const std::vector<Entry>& entries, absl::CivilDay today) {
+  return ComputeStreaksImpl(entries, today);
+}
+
+StreakStats ComputeStreaks(absl::Span<const EntryView> entries, absl::CivilDay today) {
+  return ComputeStreaksImpl(entries, today);
+}
+
 }  // namespace life_tracker
@@ -1,9 +1,14 @@
 #ifndef LIFE_TRACKER_STATS_H_
 #define LIFE_TRACKER_STATS_H_
 
+#include <array>
+#include <cstdint>
+#include <string_view>
 #include <vector>
 
 #include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "src/day_bitmap.h"
 #include "src/entry.h"
 
 namespace life_tracker {
@@ -13,13 +18,59 @@ struct DayMood {
   int mood;
 };
 
+// Order statistics of a set of moods. Percentiles are nearest-rank: the smallest mood with at
+// least that share of the samples at or below it.
+struct MoodDistribution {
+  double median = 0.0;  // Mean of the two middle moods when the count is even.
+  int p10 = 0;
+  int p25 = 0;
+  int p75 = 0;
+  int p90 = 0;
+  int iqr = 0;   // p75 - p25.
+  int mode = 0;  // Most frequent mood; the lowest on ties.
+};
+
+// Count of samples per mood 0..kMaxMood. Moods are bounded, so this fixed-size table answers
+// percentile, median and mode queries without keeping or sorting the samples, and histograms of
+// disjoint data merge by adding counts.
+class MoodHistogram {
+ public:
+  static constexpr int kMaxMood = 100;
+
+  // Moods outside 0..kMaxMood are clamped into range.
+  void Add(int mood, int64_t count = 1);
+  void Merge(const MoodHistogram& other);
+
+  int64_t count() const { return total_; }
+  // Nearest-rank percentile for `fraction` in (0, 1]. Requires count() > 0.
+  int Percentile(double fraction) const;
+  // All zero when empty.
+  MoodDistribution Distribution() const;
+
+ private:
+  // Mood with the given 1-based rank in sorted order.
+  int MoodAtRank(int64_t rank) const;
+
+  std::array<int64_t, kMaxMood + 1> counts_{};
+  int64_t total_ = 0;
+};
+
 struct SummaryStats {
   bool has_data = false;
-  int count = 0;
+  int64_t count = 0;
   double average_mood = 0.0;
   double stddev = 0.0;
   DayMood best;
   DayMood worst;
+  // Set when has_data and every sample's mood was counted; see SummaryAccumulator.
+  bool has_distribution = false;
+  MoodDistribution distribution;
+};
+
+// Summary of the entries from the last `days` days, or of all of them when `days` is 0.
+struct WindowSummary {
+  int days = 0;
+  SummaryStats summary;
 };
 
 struct StreakStats {
@@ -27,14 +78,97 @@ struct StreakStats {
   int longest_streak = 0;
 };
 
+// Streaming summary of mood samples: one pass, O(1) state, numerically stable mean and variance
+// (Welford's update). Accumulators over disjoint parts of the data can be merged in any order
+// (Chan et al.'s pairwise combination), so partial results from parallel workers or from
+// pre-aggregated buckets combine into the same summary a single pass would give. A mood
+// histogram rides along, so the result also carries the distribution at the cost of one
+// increment per sample.
+class SummaryAccumulator {
+ public:
+  void Push(const DayMood& sample);
+  void Merge(const SummaryAccumulator& other);
+
+  // An accumulator for `count` samples from one day with the given sum, sum of squares, minimum
+  // and maximum, as kept by pre-aggregated buckets. Moments carry no distribution; add the
+  // samples' moods with AddMoods() for Result() to report one.
+  static SummaryAccumulator FromMoments(absl::CivilDay day, int64_t count, int64_t sum,
+                                        int64_t sum_squares, int min, int max);
+  void AddMoods(const MoodHistogram& moods) { moods_.Merge(moods); }
+
+  int64_t count() const { return count_; }
+  SummaryStats Result() const;
+
+ private:
+  int64_t count_ = 0;
+  double mean_ = 0.0;
+  double m2_ = 0.0;  // Sum of squared deviations from mean_.
+  DayMood best_;     // Highest mood; earliest day on ties.
+  DayMood worst_;    // Lowest mood; earliest day on ties.
+  MoodHistogram moods_;
+};
+
+// Summaries over several windows ending on the same day, filled in one pass. The windows nest,
+// so each sample is pushed once, into the accumulator of the smallest window that holds it, and
+// Results() merges those accumulators from the smallest window outwards: every window then
+// covers its own samples and those of the windows inside it.
+class WindowedSummaries {
+ public:
+  // `windows` are numbers of days ending `today`, 0 meaning all time, in any order.
+  WindowedSummaries(absl::Span<const int> windows, absl::CivilDay today);
+
+  // Earliest day number any window covers; the minimum int32_t with an all-time window.
+  int32_t first_day() const { return cutoffs_.back(); }
+
+  void Push(int32_t day, int mood);
+  // Adds samples from `day` summarized by SummaryAccumulator::FromMoments(). Their moods, if
+  // known, are added separately with AddMoods().
+  void MergeMoments(int32_t day, const SummaryAccumulator& moments);
+  void AddMoods(int32_t day, int mood, int64_t count);
+
+  // One summary per window, in the order the windows were given.
+  std::vector<WindowSummary> Results() const;
+
+ private:
+  // Index of the smallest window holding `day`, or -1 if none does.
+  int Ring(int32_t day) const;
+
+  std::vector<int> windows_;        // As given.
+  std::vector<size_t> ring_of_;     // Ring of each window in windows_.
+  std::vector<int32_t> cutoffs_;    // First day of each ring, latest first.
+  std::vector<SummaryAccumulator> rings_;
+  std::vector<MoodHistogram> ring_moods_;  // Moods added with AddMoods().
+};
+
+// Parses a --days value: comma-separated positive numbers of days and "all" for all time, such
+// as "7,30,all". Throws std::runtime_error if it is empty or malformed.
+std::vector<int> ParseDayWindows(std::string_view list);
+
 SummaryStats ComputeSummary(const std::vector<DayMood>& samples);
 
+// Summaries of the entries from each of the last `windows` days (0 = all time), in one pass over
+// the entries; see WindowedSummaries.
+std::vector<WindowSummary> ComputeWindowSummaries(absl::Span<const EntryView> entries,
+                                                  absl::Span<const int> windows,
+                                                  absl::CivilDay today);
+
+// Summary of the entries from the last `days` days, accumulated as the entries are scanned
+// without collecting them first.
+SummaryStats ComputeRecentSummary(absl::Span<const EntryView> entries, int days,
+                                  absl::CivilDay today);
+
 std::vector<DayMood> CollectRecentSamples(const std::vector<Entry>& entries, int days,
                                           absl::CivilDay today);
+std::vector<DayMood> CollectRecentSamples(absl::Span<const EntryView> entries, int days,
+                                          absl::CivilDay today);
 
+// Streaks over the days set in `days`: the longest run of consecutive days, and the run ending at
+// the latest day if that is today or yesterday.
+StreakStats ComputeStreaks(const DayBitmap& days, absl::CivilDay today);
 StreakStats ComputeStreaks(const std::vector<Entry>& entries, absl::CivilDay today);
+StreakStats ComputeStreaks(absl::Span<const EntryView> entries, absl::CivilDay today);
 
-absl::CivilDay ParseCivilDay(const std::string& date_str);
+absl::CivilDay ParseCivilDay(std::string_view date_str);
 
 }  // namespace life_tracker
 
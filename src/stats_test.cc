@@ -1,9 +1,14 @@
 #include "src/stats.h"
 
+#include <algorithm>
 #include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "src/date.h"
 
 namespace life_tracker {
 namespace {
@@ -35,6 +40,177 @@ TEST(ComputeSummaryTest, ComputesAverageAndStdDev) {
   EXPECT_EQ(summary.worst.mood, 50);
 }
 
+TEST(SummaryAccumulatorTest, MergedPartsMatchOnePass) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> mood(1, 100);
+  std::vector<DayMood> samples;
+  for (int i = 0; i < 1000; ++i) {
+    samples.push_back({absl::CivilDay(2026, 1, 1) + i % 97, mood(rng)});
+  }
+
+  double mean = 0.0;
+  for (const DayMood& s : samples) mean += s.mood;
+  mean /= samples.size();
+  double variance = 0.0;
+  for (const DayMood& s : samples) variance += (s.mood - mean) * (s.mood - mean);
+  variance /= samples.size();
+
+  SummaryAccumulator parts[3];
+  for (size_t i = 0; i < samples.size(); ++i) parts[i * 3 / samples.size()].Push(samples[i]);
+  SummaryAccumulator merged;
+  merged.Merge(parts[2]);
+  merged.Merge(SummaryAccumulator());
+  merged.Merge(parts[0]);
+  merged.Merge(parts[1]);
+
+  const SummaryStats whole = ComputeSummary(samples);
+  const SummaryStats combined = merged.Result();
+  EXPECT_EQ(combined.count, 1000);
+  EXPECT_NEAR(whole.average_mood, mean, 1e-9);
+  EXPECT_NEAR(whole.stddev, std::sqrt(variance), 1e-9);
+  EXPECT_NEAR(combined.average_mood, mean, 1e-9);
+  EXPECT_NEAR(combined.stddev, std::sqrt(variance), 1e-9);
+  EXPECT_EQ(combined.best.day, whole.best.day);
+  EXPECT_EQ(combined.best.mood, whole.best.mood);
+  EXPECT_EQ(combined.worst.day, whole.worst.day);
+  EXPECT_EQ(combined.worst.mood, whole.worst.mood);
+}
+
+TEST(MoodHistogramTest, MatchesSortedSamples) {
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> mood(1, 100);
+  for (const int size : {1, 2, 3, 10, 101, 1000}) {
+    std::vector<int> moods;
+    MoodHistogram halves[2];
+    for (int i = 0; i < size; ++i) {
+      moods.push_back(mood(rng));
+      halves[i % 2].Add(moods.back());
+    }
+    MoodHistogram histogram;
+    histogram.Merge(halves[0]);
+    histogram.Merge(halves[1]);
+    ASSERT_EQ(histogram.count(), size);
+
+    std::sort(moods.begin(), moods.end());
+    const auto nearest_rank = [&](double fraction) {
+      const auto rank = static_cast<size_t>(std::ceil(fraction * size));
+      return moods[std::max<size_t>(rank, 1) - 1];
+    };
+    const MoodDistribution distribution = histogram.Distribution();
+    const double median = size % 2 == 1 ? moods[size / 2]
+                                        : (moods[size / 2 - 1] + moods[size / 2]) / 2.0;
+    EXPECT_EQ(distribution.median, median) << size;
+    EXPECT_EQ(distribution.p10, nearest_rank(0.10)) << size;
+    EXPECT_EQ(distribution.p25, nearest_rank(0.25)) << size;
+    EXPECT_EQ(distribution.p75, nearest_rank(0.75)) << size;
+    EXPECT_EQ(distribution.p90, nearest_rank(0.90)) << size;
+    EXPECT_EQ(distribution.iqr, distribution.p75 - distribution.p25) << size;
+  }
+}
+
+TEST(MoodHistogramTest, ModePrefersLowestOnTies) {
+  MoodHistogram histogram;
+  EXPECT_EQ(histogram.Distribution().mode, 0);
+  histogram.Add(70, 2);
+  histogram.Add(30, 2);
+  histogram.Add(50);
+  EXPECT_EQ(histogram.Distribution().mode, 30);
+  EXPECT_EQ(histogram.Distribution().median, 50.0);
+  histogram.Add(250);  // Clamped to the top bucket.
+  EXPECT_EQ(histogram.Percentile(1.0), MoodHistogram::kMaxMood);
+}
+
+TEST(SummaryAccumulatorTest, ReportsDistributionOnlyWhenEveryMoodIsCounted) {
+  SummaryAccumulator pushed;
+  pushed.Push({absl::CivilDay(2026, 1, 1), 40});
+  pushed.Push({absl::CivilDay(2026, 1, 2), 60});
+  EXPECT_TRUE(pushed.Result().has_distribution);
+  EXPECT_EQ(pushed.Result().distribution.median, 50.0);
+
+  SummaryAccumulator moments =
+      SummaryAccumulator::FromMoments(absl::CivilDay(2026, 1, 3), 2, 100, 5200, 40, 60);
+  EXPECT_FALSE(moments.Result().has_distribution);
+  moments.Merge(pushed);
+  EXPECT_FALSE(moments.Result().has_distribution);
+  MoodHistogram moods;
+  moods.Add(40);
+  moods.Add(60);
+  moments.AddMoods(moods);
+  ASSERT_TRUE(moments.Result().has_distribution);
+  EXPECT_EQ(moments.Result().distribution.p25, 40);
+  EXPECT_EQ(moments.Result().distribution.p75, 60);
+}
+
+TEST(SummaryAccumulatorTest, MomentsBeyondIntRange) {
+  // Three billion entries would overflow an int total many times over.
+  const int64_t count = 3'000'000'000;
+  SummaryAccumulator acc = SummaryAccumulator::FromMoments(
+      absl::CivilDay(2026, 1, 1), count, 99 * count, 99 * 99 * count, 99, 99);
+  acc.Merge(SummaryAccumulator::FromMoments(absl::CivilDay(2026, 1, 2), count, count, count, 1,
+                                            1));
+  const SummaryStats summary = acc.Result();
+  EXPECT_EQ(summary.count, 2 * count);
+  EXPECT_NEAR(summary.average_mood, 50.0, 1e-9);
+  EXPECT_NEAR(summary.stddev, 49.0, 1e-9);
+  EXPECT_EQ(summary.best.mood, 99);
+  EXPECT_EQ(summary.worst.day, absl::CivilDay(2026, 1, 2));
+}
+
+TEST(ComputeRecentSummaryTest, MatchesCollectedSamples) {
+  std::vector<EntryView> views = {{"2026-01-01", 50, ""}, {"2026-01-05", 30, ""},
+                                  {"2026-01-03", 80, ""}, {"2026-01-07", 60, ""}};
+  for (EntryView& view : views) view.day = ParseIsoDate(view.date);
+  const absl::CivilDay today(2026, 1, 7);
+
+  const SummaryStats streamed = ComputeRecentSummary(views, 5, today);
+  const SummaryStats collected = ComputeSummary(CollectRecentSamples(views, 5, today));
+  EXPECT_EQ(streamed.count, 3);
+  EXPECT_EQ(streamed.count, collected.count);
+  EXPECT_NEAR(streamed.average_mood, collected.average_mood, 1e-9);
+  EXPECT_NEAR(streamed.stddev, collected.stddev, 1e-9);
+  EXPECT_EQ(streamed.best.day, absl::CivilDay(2026, 1, 3));
+}
+
+TEST(ComputeWindowSummariesTest, MatchesOneSummaryPerWindow) {
+  std::mt19937 rng(11);
+  std::vector<Entry> entries;
+  char date[10];
+  for (int i = 0; i < 500; ++i) {
+    FormatIsoDate(ParseIsoDate("2025-01-01") + static_cast<int>(rng() % 400), date);
+    entries.push_back(
+        MakeEntry(std::string(date, sizeof(date)), 1 + static_cast<int>(rng() % 100)));
+  }
+  std::vector<EntryView> views;
+  for (const Entry& e : entries) views.push_back({e.date, e.mood, e.note, ParseIsoDate(e.date)});
+  const absl::CivilDay today(2026, 1, 20);
+
+  const std::vector<int> windows = {30, 0, 7, 365, 30};
+  const std::vector<WindowSummary> summaries = ComputeWindowSummaries(views, windows, today);
+  ASSERT_EQ(summaries.size(), windows.size());
+  for (size_t i = 0; i < windows.size(); ++i) {
+    const int days = windows[i] == 0 ? 100000 : windows[i];
+    const SummaryStats expected = ComputeSummary(CollectRecentSamples(entries, days, today));
+    const SummaryStats& actual = summaries[i].summary;
+    EXPECT_EQ(summaries[i].days, windows[i]);
+    EXPECT_EQ(actual.count, expected.count) << windows[i];
+    EXPECT_NEAR(actual.average_mood, expected.average_mood, 1e-9);
+    EXPECT_NEAR(actual.stddev, expected.stddev, 1e-9);
+    EXPECT_EQ(actual.best.day, expected.best.day);
+    EXPECT_EQ(actual.worst.day, expected.worst.day);
+    ASSERT_TRUE(actual.has_distribution);
+    EXPECT_EQ(actual.distribution.median, expected.distribution.median);
+    EXPECT_EQ(actual.distribution.p90, expected.distribution.p90);
+  }
+}
+
+TEST(ParseDayWindowsTest, ParsesNumbersAndAll) {
+  EXPECT_EQ(ParseDayWindows("7"), (std::vector<int>{7}));
+  EXPECT_EQ(ParseDayWindows("7, 30,all"), (std::vector<int>{7, 30, 0}));
+  for (const char* bad : {"", "0", "-3", "7,", "week", "7,,30"}) {
+    EXPECT_THROW(ParseDayWindows(bad), std::runtime_error) << bad;
+  }
+}
+
 TEST(CollectRecentSamplesTest, FiltersByDays) {
   std::vector<Entry> entries = {
       MakeEntry("2026-01-01", 50),
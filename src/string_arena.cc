@@ -0,0 +1,66 @@
+#include "src/string_arena.h"
+
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+namespace life_tracker {
+namespace {
+
+constexpr size_t kBlockSize = 64 << 10;
+// Larger requests get a block of their own so they do not strand the rest of the current one.
+constexpr size_t kMaxSharedSize = kBlockSize / 4;
+
+}  // namespace
+
+std::string_view StringArena::Store(std::string_view s) {
+  if (s.empty()) return std::string_view();
+  char* bytes = Allocate(s.size());
+  std::memcpy(bytes, s.data(), s.size());
+  return std::string_view(bytes, s.size());
+}
+
+std::string_view StringArena::Intern(std::string_view s) {
+  if (s.empty()) return std::string_view();
+  auto it = interned_.find(s);
+  if (it != interned_.end()) return *it;
+  const std::string_view stored = Store(s);
+  interned_.insert(stored);
+  return stored;
+}
+
+char* StringArena::Allocate(size_t size) {
+  if (size > kMaxSharedSize) {
+    blocks_.emplace_back(new char[size]);  // Left uninitialized.
+    capacity_ += size;
+    return blocks_.back().get();
+  }
+  if (size > remaining_) {
+    blocks_.emplace_back(new char[kBlockSize]);
+    capacity_ += kBlockSize;
+    cursor_ = blocks_.back().get();
+    remaining_ = kBlockSize;
+  }
+  char* bytes = cursor_;
+  cursor_ += size;
+  remaining_ -= size;
+  return bytes;
+}
+
+void StringArena::Absorb(StringArena&& other) {
+  // The current block is tracked by cursor_, not by position, so this arena keeps filling it.
+  blocks_.insert(blocks_.end(), std::make_move_iterator(other.blocks_.begin()),
+                 std::make_move_iterator(other.blocks_.end()));
+  capacity_ += other.capacity_;
+  other.Clear();
+}
+
+void StringArena::Clear() {
+  blocks_.clear();
+  cursor_ = nullptr;
+  remaining_ = 0;
+  capacity_ = 0;
+  interned_.clear();
+}
+
+}  // namespace life_tracker
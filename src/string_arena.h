@@ -0,0 +1,50 @@
+#ifndef LIFE_TRACKER_STRING_ARENA_H_
+#define LIFE_TRACKER_STRING_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+
+namespace life_tracker {
+
+// Append-only storage for the strings entry views point at. Bytes are carved out of large
+// contiguous blocks, so storing a string costs a copy rather than a heap allocation, and stored
+// bytes never move: views stay valid until Clear() or destruction, even if the arena is moved.
+class StringArena {
+ public:
+  StringArena() = default;
+  StringArena(StringArena&&) = default;
+  StringArena& operator=(StringArena&&) = default;
+  StringArena(const StringArena&) = delete;
+  StringArena& operator=(const StringArena&) = delete;
+
+  // Copies `s` into the arena.
+  std::string_view Store(std::string_view s);
+  // Like Store(), but returns the existing copy when an equal string was interned before, so
+  // repeated values ("gym", "ok", a date) are kept once.
+  std::string_view Intern(std::string_view s);
+  // Uninitialized space for `size` bytes.
+  char* Allocate(size_t size);
+
+  // Takes over the blocks of `other`, keeping views into them valid. Interned strings of `other`
+  // are not interned here.
+  void Absorb(StringArena&& other);
+  void Clear();
+
+  // Bytes held in blocks, including unused space at the end of each.
+  size_t capacity() const { return capacity_; }
+
+ private:
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* cursor_ = nullptr;  // Free space at the end of the current block.
+  size_t remaining_ = 0;
+  size_t capacity_ = 0;
+  absl::flat_hash_set<std::string_view> interned_;
+};
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_STRING_ARENA_H_
@@ -0,0 +1,58 @@
+#include "src/string_arena.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace life_tracker {
+namespace {
+
+TEST(StringArenaTest, StoredStringsStayValidAcrossGrowthAndMoves) {
+  StringArena arena;
+  std::vector<std::string> expected;
+  std::vector<std::string_view> stored;
+  for (int i = 0; i < 20000; ++i) {
+    expected.push_back("note " + std::to_string(i));
+    stored.push_back(arena.Store(expected.back()));
+  }
+  expected.push_back(std::string(100000, 'x'));  // Bigger than a block.
+  stored.push_back(arena.Store(expected.back()));
+  stored.push_back(arena.Store("after"));
+  expected.push_back("after");
+
+  StringArena moved = std::move(arena);
+  for (size_t i = 0; i < expected.size(); ++i) ASSERT_EQ(stored[i], expected[i]) << i;
+  EXPECT_GE(moved.capacity(), 100000u);
+}
+
+TEST(StringArenaTest, InternReturnsTheFirstCopy) {
+  StringArena arena;
+  const std::string gym = "gym";
+  const std::string_view first = arena.Intern(gym);
+  EXPECT_NE(first.data(), gym.data());
+  EXPECT_EQ(arena.Intern(std::string("gym")).data(), first.data());
+  EXPECT_NE(arena.Intern("ok").data(), first.data());
+  // Store() never shares, and empty strings need no storage.
+  EXPECT_NE(arena.Store("gym").data(), first.data());
+  EXPECT_TRUE(arena.Intern("").empty());
+  EXPECT_TRUE(arena.Store("").empty());
+}
+
+TEST(StringArenaTest, AbsorbKeepsViewsAndFillsCurrentBlock) {
+  StringArena arena;
+  StringArena other;
+  const std::string_view a = arena.Store("alpha");
+  const std::string_view b = other.Store("beta");
+  arena.Absorb(std::move(other));
+  const std::string_view c = arena.Store("gamma");
+  EXPECT_EQ(a, "alpha");
+  EXPECT_EQ(b, "beta");
+  EXPECT_EQ(c, "gamma");
+  EXPECT_EQ(c.data(), a.data() + a.size());
+  EXPECT_EQ(other.capacity(), 0u);
+}
+
+}  // namespace
+}  // namespace life_tracker
@@ -0,0 +1,38 @@
+#ifndef LIFE_TRACKER_TEST_UTIL_H_
+#define LIFE_TRACKER_TEST_UTIL_H_
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace life_tracker {
+
+// Returns the contents of the file at `path`, or an empty string if it cannot be opened.
+inline std::string ReadFile(const std::filesystem::path& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+// Fixture giving each test an empty directory `dir_` of its own, named after the test and
+// removed when it ends. Suites that override SetUp() call TempDirTest::SetUp() first;
+// parameterized suites also derive from ::testing::WithParamInterface.
+class TempDirTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    dir_ = std::filesystem::path(::testing::TempDir()) /
+           ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir_); }
+
+  std::filesystem::path dir_;
+};
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_TEST_UTIL_H_
@@ -0,0 +1,147 @@
+#include "src/trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+#include "absl/strings/str_format.h"
+
+namespace life_tracker {
+namespace {
+
+struct TraceEvent {
+  std::string name;
+  int64_t start_ns = 0;
+  int64_t duration_ns = 0;
+  int tid = 0;
+  std::vector<std::pair<std::string, int64_t>> counters;
+};
+
+struct TraceLog {
+  std::atomic<bool> enabled{false};
+  std::chrono::steady_clock::time_point epoch;
+  std::mutex mu;
+  std::vector<TraceEvent> events;            // Guarded by mu.
+  std::map<std::thread::id, int> thread_ids;  // Guarded by mu; small ids read better than hashes.
+};
+
+TraceLog& Log() {
+  static TraceLog* log = new TraceLog();
+  return *log;
+}
+
+std::string JsonString(std::string_view s) {
+  std::string out = "\"";
+  for (const char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out += absl::StrFormat("\\u%04x", static_cast<int>(c));
+    } else {
+      out += c;
+    }
+  }
+  return out + "\"";
+}
+
+int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                              Log().epoch)
+      .count();
+}
+
+}  // namespace
+
+void StartTracing() {
+  TraceLog& log = Log();
+  std::lock_guard<std::mutex> lock(log.mu);
+  log.events.clear();
+  log.thread_ids.clear();
+  log.epoch = std::chrono::steady_clock::now();
+  log.enabled.store(true);
+}
+
+void StopTracing() {
+  TraceLog& log = Log();
+  log.enabled.store(false);
+  std::lock_guard<std::mutex> lock(log.mu);
+  log.events.clear();
+  log.thread_ids.clear();
+}
+
+bool TracingEnabled() { return Log().enabled.load(std::memory_order_relaxed); }
+
+void WriteTrace(const std::string& path) {
+  std::vector<TraceEvent> events;
+  {
+    TraceLog& log = Log();
+    std::lock_guard<std::mutex> lock(log.mu);
+    events = log.events;
+  }
+
+  const std::filesystem::path fs_path(path);
+  if (fs_path.has_parent_path()) std::filesystem::create_directories(fs_path.parent_path());
+  std::ofstream out(path, std::ios::out | std::ios::trunc);
+  if (!out.is_open()) throw std::runtime_error("Failed to open trace file for writing: " + path);
+
+  // Complete ("X") events in microseconds, as the trace-event format expects.
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (size_t i = 0; i < events.size(); ++i) {
+    const TraceEvent& event = events[i];
+    out << (i > 0 ? ",\n" : "\n")
+        << absl::StrFormat(
+               "{\"name\":%s,\"cat\":\"life\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+               "\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+               JsonString(event.name), event.tid, event.start_ns / 1000.0,
+               event.duration_ns / 1000.0);
+    for (size_t c = 0; c < event.counters.size(); ++c) {
+      out << (c > 0 ? "," : "") << JsonString(event.counters[c].first) << ":"
+          << event.counters[c].second;
+    }
+    out << "}}";
+  }
+  out << "\n]}\n";
+  out.close();
+  if (!out) throw std::runtime_error("Failed to write trace file: " + path);
+}
+
+TraceSpan::TraceSpan(const char* name) : name_(name) {
+  if (TracingEnabled()) start_ns_ = NowNs();
+}
+
+TraceSpan::~TraceSpan() {
+  if (start_ns_ < 0 || !TracingEnabled()) return;
+  TraceEvent event;
+  event.name = name_;
+  event.start_ns = start_ns_;
+  event.duration_ns = NowNs() - start_ns_;
+  event.counters.reserve(counters_.size());
+  for (const auto& [counter, value] : counters_) event.counters.emplace_back(counter, value);
+
+  TraceLog& log = Log();
+  std::lock_guard<std::mutex> lock(log.mu);
+  const int next_tid = static_cast<int>(log.thread_ids.size()) + 1;
+  event.tid = log.thread_ids.emplace(std::this_thread::get_id(), next_tid).first->second;
+  log.events.push_back(std::move(event));
+}
+
+void TraceSpan::Counter(const char* name, int64_t value) {
+  if (start_ns_ < 0) return;
+  for (auto& counter : counters_) {
+    if (std::strcmp(counter.first, name) == 0) {
+      counter.second = value;
+      return;
+    }
+  }
+  counters_.emplace_back(name, value);
+}
+
+}  // namespace life_tracker
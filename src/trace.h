@@ -0,0 +1,42 @@
+#ifndef LIFE_TRACKER_TRACE_H_
+#define LIFE_TRACKER_TRACE_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace life_tracker {
+
+// Phase timing for `--trace`. Spans are recorded only between StartTracing() and StopTracing();
+// otherwise constructing one costs a single atomic load, so they can sit in library code that
+// runs per command rather than per entry.
+void StartTracing();
+void StopTracing();
+bool TracingEnabled();
+
+// Writes the spans recorded so far as Chrome trace-event JSON, which chrome://tracing and
+// ui.perfetto.dev open directly. Throws std::runtime_error if the file cannot be written.
+void WriteTrace(const std::string& path);
+
+// Times its own lifetime as one complete event on the calling thread. Counters become the
+// event's arguments. `name` and counter names must outlive the span.
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char* name);
+  ~TraceSpan();
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+  // Sets `name` to `value`, replacing an earlier value of the same counter.
+  void Counter(const char* name, int64_t value);
+
+ private:
+  const char* name_;
+  int64_t start_ns_ = -1;  // Negative when tracing was off at construction.
+  std::vector<std::pair<const char*, int64_t>> counters_;
+};
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_TRACE_H_
@@ -0,0 +1,70 @@
+#include "src/trace.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace life_tracker {
+namespace {
+
+class TraceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = (std::filesystem::path(::testing::TempDir()) / "trace_test.json").string();
+  }
+
+  void TearDown() override {
+    StopTracing();
+    std::filesystem::remove(path_);
+  }
+
+  std::string WriteAndRead() {
+    WriteTrace(path_);
+    std::ifstream in(path_);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  std::string path_;
+};
+
+TEST_F(TraceTest, RecordsNothingWhileDisabled) {
+  EXPECT_FALSE(TracingEnabled());
+  {
+    TraceSpan span("ignored");
+    span.Counter("bytes", 1);
+  }
+  StartTracing();
+  EXPECT_EQ(WriteAndRead().find("ignored"), std::string::npos);
+}
+
+TEST_F(TraceTest, WritesCompleteEventsWithCounters) {
+  StartTracing();
+  {
+    TraceSpan outer("outer");
+    {
+      TraceSpan inner("parse");
+      inner.Counter("entries", 10);
+      inner.Counter("entries", 42);
+      inner.Counter("bytes", 4096);
+    }
+    std::thread([] { TraceSpan span("worker"); }).join();
+  }
+  { TraceSpan quoted("say \"hi\""); }
+
+  const std::string json = WriteAndRead();
+  EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+  EXPECT_NE(json.find("\"name\":\"outer\",\"cat\":\"life\",\"ph\":\"X\",\"pid\":1,\"tid\":1"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"entries\":42,\"bytes\":4096}"), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"worker\",\"cat\":\"life\",\"ph\":\"X\",\"pid\":1,\"tid\":2"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"say \\\"hi\\\"\""), std::string::npos);
+  EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
+
+}  // namespace
+}  // namespace life_tracker
@@ -1,55 +1,917 @@
 #include "src/tracker.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <utility>
 
+#include "src/columnar.h"
+#include "src/csv_scanner.h"
+#include "src/date.h"
+#include "src/parallel.h"
+#include "src/partitions.h"
+#include "src/trace.h"
+
 namespace life_tracker {
 namespace fs = std::filesystem;
+namespace {
+
+// Below this many bytes per thread, splitting costs more than it saves.
+constexpr size_t kMinBytesPerChunk = 1 << 20;
+// Read size of Scan() without mmap.
+constexpr size_t kScanChunkSize = 4 << 20;
+
+struct ParsedChunk {
+  std::vector<EntryView> views;
+  StringArena arena;
+};
+
+bool ViewDayLess(const EntryView& a, const EntryView& b) { return a.day < b.day; }
+bool ViewBeforeDay(const EntryView& view, int32_t day) { return view.day < day; }
+bool DayBefore(int32_t day, const EntryView& view) { return day < view.day; }
+
+bool IsTailLoad(const LoadOptions& options) {
+  return options.limit > 0 || options.since_day != kInvalidDay;
+}
+
+// True once a tail load has all it needs and should not take the entry dated `day`.
+bool TailIsComplete(const LoadOptions& options, size_t loaded, int32_t day) {
+  if (options.limit > 0 && loaded >= options.limit) return true;
+  return options.since_day != kInvalidDay && day != kInvalidDay && day < options.since_day;
+}
 
-Tracker::Tracker(std::string data_path) : data_path_(std::move(data_path)) {}
+// Drops or keeps the note of a freshly scanned `*view`; a note that was unescaped into
+// `unescaped_note` is copied into `*arena` so the view stays valid.
+void SettleNote(bool load_notes, EntryView* view, const std::string& unescaped_note,
+                StringArena* arena) {
+  if (!load_notes) {
+    view->note = std::string_view();
+  } else if (view->note.data() == unescaped_note.data()) {
+    view->note = arena->Store(unescaped_note);
+  }
+}
+
+// Length of the prefix of `data` that holds whole records: up to the last newline outside
+// quotes, assuming `data` starts at a record boundary. 0 if no record is complete.
+size_t CompleteRecordsEnd(std::string_view data) {
+  const size_t quotes = CountQuotes(data);
+  size_t quotes_after = 0;
+  size_t end = data.size();
+  while (end > 0 && !(data[end - 1] == '\n' && (quotes - quotes_after) % 2 == 0)) {
+    if (data[end - 1] == '"') ++quotes_after;
+    --end;
+  }
+  return end;
+}
+
+void ScanCsv(std::string_view data, bool load_notes,
+             absl::FunctionRef<void(const EntryView&)> visit) {
+  CsvScanner scanner(data);
+  EntryView view;
+  std::string unescaped_note;
+  while (scanner.Next(&view, &unescaped_note)) {
+    if (!load_notes) view.note = std::string_view();
+    visit(view);
+  }
+}
+
+void ScanColumnar(std::string_view data, bool load_notes,
+                  absl::FunctionRef<void(const EntryView&)> visit) {
+  char date[10];
+  for (const ColumnarBlock& block : ReadColumnarBlocks(data)) {
+    for (size_t i = 0; i < block.row_count; ++i) {
+      EntryView view;
+      view.day = block.Day(i);
+      FormatIsoDate(view.day, date);
+      view.date = std::string_view(date, sizeof(date));
+      view.mood = block.moods[i];
+      if (load_notes) view.note = block.Note(i);
+      visit(view);
+    }
+  }
+}
 
-void Tracker::Load() {
+// The records of date-ordered CSV `data` from the first one dated `since_day` or later, found by
+// reading backwards from the end so only those records are touched.
+std::string_view CsvSince(std::string_view data, int32_t since_day) {
+  if (since_day == kInvalidDay) return data;
+  ReverseCsvScanner scanner(data);
+  EntryView view;
+  std::string unescaped_note;
+  size_t start = data.size();
+  while (scanner.Prev(&view, &unescaped_note)) {
+    if (view.day != kInvalidDay && view.day < since_day) break;
+    start = scanner.offset();
+  }
+  return data.substr(start);
+}
+
+void ScanFile(const std::string& path, const LoadOptions& options,
+              absl::FunctionRef<void(const EntryView&)> visit) {
+  // Seeking to `since_day` needs random access, so a cutoff maps the file too.
+  if (options.use_mmap || IsColumnarPath(path) || options.since_day != kInvalidDay) {
+    MappedFile file;
+    if (!file.Open(path)) return;
+    if (IsColumnarData(file.data())) {
+      ScanColumnar(file.data(), options.load_notes, visit);
+    } else {
+      ScanCsv(CsvSince(file.data(), options.since_day), options.load_notes, visit);
+    }
+    return;
+  }
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) return;
+  // `pending` always starts at a record boundary; each round parses its whole records and keeps
+  // the partial one for the next chunk.
+  std::string pending;
+  for (bool first = true; in; first = false) {
+    const size_t kept = pending.size();
+    pending.resize(kept + kScanChunkSize);
+    in.read(pending.data() + kept, static_cast<std::streamsize>(kScanChunkSize));
+    pending.resize(kept + static_cast<size_t>(in.gcount()));
+    if (first && IsColumnarData(pending)) {
+      // Columnar files are not framed for chunked reads; map them instead.
+      LoadOptions mapped = options;
+      mapped.use_mmap = true;
+      ScanFile(path, mapped, visit);
+      return;
+    }
+    const size_t end = in ? CompleteRecordsEnd(pending) : pending.size();
+    ScanCsv(std::string_view(pending).substr(0, end), options.load_notes, visit);
+    pending.erase(0, end);
+  }
+}
+
+// Parses whole CSV records from `data`. Notes that needed unescaping are copied into `*arena`.
+void ParseCsvChunk(std::string_view data, bool load_notes, std::vector<EntryView>* views,
+                   StringArena* arena) {
+  CsvScanner scanner(data);
+  EntryView view;
+  std::string unescaped_note;
+  while (scanner.Next(&view, &unescaped_note)) {
+    SettleNote(load_notes, &view, unescaped_note, arena);
+    views->push_back(view);
+  }
+}
+
+}  // namespace
+
+Tracker::Tracker(std::string data_path, AppendOptions append_options)
+    : data_path_(std::move(data_path)), append_options_(append_options) {}
+
+void Tracker::Load(const LoadOptions& options) {
+  TraceSpan span("Tracker::Load");
+  mapping_.Close();
+  buffer_.clear();
+  arena_.Clear();
+  views_.clear();
   entries_.clear();
+  partition_files_.clear();
+  partition_buffers_.clear();
+  by_date_.clear();
+  by_date_built_ = false;
+  intern_notes_ = options.intern_notes;
+  load_options_ = options;
+  csv_appendable_ = false;
+  // Aggregates may only be rebuilt from a complete load.
+  loaded_ = !IsTailLoad(options);
+  loaded_stamp_ = StampDataFile(data_path_);
 
-  std::ifstream in(data_path_);
-  if (!in.is_open()) return;  // No file yet is fine.
+  LoadViews(options);
+  if (options.detach) Detach();
+  span.Counter("entries", static_cast<int64_t>(views_.size()));
+  span.Counter("arena_bytes", static_cast<int64_t>(arena_.capacity()));
+}
 
-  std::string line;
-  while (std::getline(in, line)) {
-    if (line.empty()) continue;
-    entries_.push_back(Entry::FromCsvLine(line));
+bool Tracker::Refresh() {
+  const DataFileStamp stamp = StampDataFile(data_path_);
+  if (stamp == loaded_stamp_) return false;
+
+  // Without its own copies of the loaded strings, or when the change is not a plain append of
+  // whole records, start over.
+  const uint64_t loaded_size = loaded_stamp_.size;
+  if (!loaded_ || !load_options_.detach || !csv_appendable_ || stamp.size <= loaded_size) {
+    Load(load_options_);
+    return true;
+  }
+  // Read from the last loaded byte, which must still end a record.
+  const uint64_t start = loaded_size > 0 ? loaded_size - 1 : 0;
+  std::string appended(stamp.size - start, '\0');
+  std::ifstream in(data_path_, std::ios::binary);
+  in.seekg(static_cast<std::streamoff>(start));
+  if (!in.read(appended.data(), static_cast<std::streamsize>(appended.size())) ||
+      (loaded_size > 0 && appended.front() != '\n')) {
+    Load(load_options_);
+    return true;
+  }
+  if (loaded_size > 0) appended.erase(0, 1);
+
+  // A writer may be midway through a record; take whole records only and pick up the rest next
+  // time.
+  const size_t end = CompleteRecordsEnd(appended);
+  if (end == 0) return false;
+  appended.resize(end);
+
+  std::vector<EntryView> views;
+  ParseCsvChunk(appended, load_options_.load_notes, &views, &arena_);
+
+  const bool aggregates_current = aggregates_ && aggregates_stamp_ == loaded_stamp_;
+  views_.reserve(views_.size() + views.size());
+  for (EntryView& view : views) {
+    view.date = arena_.Intern(view.date);
+    view.note = intern_notes_ ? arena_.Intern(view.note) : arena_.Store(view.note);
+    if (aggregates_current) {
+      if (view.day == kInvalidDay) {
+        throw std::runtime_error("Invalid date in data: " + std::string(view.date));
+      }
+      aggregates_->Add(view.day, view.mood);
+    }
+    AppendView(view);
+  }
+  DataFileStamp consumed = stamp;
+  consumed.size = loaded_size + end;
+  if (aggregates_current) aggregates_stamp_ = consumed;
+  loaded_stamp_ = consumed;
+  return true;
+}
+
+void Tracker::LoadViews(const LoadOptions& options) {
+  if (IsPartitionedDataPath(data_path_)) {
+    LoadPartitions(options);
+    return;
+  }
+
+  // No file yet is fine; if one appears as CSV, Refresh() can read it as an append.
+  csv_appendable_ = !IsColumnarPath(data_path_);
+  std::string_view data;
+  {
+    TraceSpan span("open");
+    span.Counter("mmap", options.use_mmap);
+    if (options.use_mmap) {
+      if (!mapping_.Open(data_path_)) return;
+      data = mapping_.data();
+    } else {
+      std::ifstream in(data_path_, std::ios::binary);
+      if (!in.is_open()) return;
+      buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      data = buffer_;
+    }
+    span.Counter("bytes", static_cast<int64_t>(data.size()));
+  }
+
+  // Dates are converted to day numbers as each record is parsed, so they are part of this span.
+  TraceSpan span("parse");
+  span.Counter("bytes", static_cast<int64_t>(data.size()));
+  if (IsColumnarData(data)) {
+    csv_appendable_ = false;
+    LoadColumnar(data, options);
+  } else if (IsTailLoad(options)) {
+    LoadCsvTail(data, options);
+  } else {
+    LoadCsv(data, options);
+    csv_appendable_ = data.empty() || data.back() == '\n';
+  }
+  span.Counter("entries", static_cast<int64_t>(views_.size()));
+}
+
+void Tracker::LoadCsvTail(std::string_view data, const LoadOptions& options) {
+  ReverseCsvScanner scanner(data);
+  EntryView view;
+  std::string unescaped_note;
+  while (scanner.Prev(&view, &unescaped_note)) {
+    if (TailIsComplete(options, views_.size(), view.day)) break;
+    SettleNote(options.load_notes, &view, unescaped_note, &arena_);
+    views_.push_back(view);
+  }
+  std::reverse(views_.begin(), views_.end());
+}
+
+void Tracker::Detach() {
+  TraceSpan span("detach");
+  for (EntryView& view : views_) {
+    view.date = arena_.Intern(view.date);
+    view.note = intern_notes_ ? arena_.Intern(view.note) : arena_.Store(view.note);
+  }
+  mapping_.Close();
+  buffer_ = std::string();
+  partition_files_.clear();
+  partition_buffers_.clear();
+  span.Counter("arena_bytes", static_cast<int64_t>(arena_.capacity()));
+}
+
+void Tracker::LoadCsv(std::string_view data, const LoadOptions& options) {
+  const size_t max_chunks = std::max<size_t>(1, data.size() / kMinBytesPerChunk);
+  const size_t chunks =
+      std::min(static_cast<size_t>(ResolveThreadCount(options.threads)), max_chunks);
+  if (chunks == 1) {
+    ParseCsvChunk(data, options.load_notes, &views_, &arena_);
+    return;
+  }
+
+  // Split into equal byte ranges, then move each split forward to the next record boundary. Quote
+  // parity at each split point comes from per-range quote counts gathered in parallel.
+  std::vector<size_t> splits(chunks + 1);
+  for (size_t k = 0; k <= chunks; ++k) splits[k] = data.size() / chunks * k;
+  splits[chunks] = data.size();
+  std::vector<size_t> quotes(chunks);
+  RunParallel(chunks, static_cast<int>(chunks), [&](size_t k) {
+    quotes[k] = CountQuotes(data.substr(splits[k], splits[k + 1] - splits[k]));
+  });
+  size_t quotes_before = 0;
+  for (size_t k = 1; k < chunks; ++k) {
+    quotes_before += quotes[k - 1];
+    splits[k] = std::max(splits[k - 1], FindRecordStart(data, splits[k], quotes_before % 2 == 1));
+  }
+
+  std::vector<ParsedChunk> parsed(chunks);
+  RunParallel(chunks, static_cast<int>(chunks), [&](size_t k) {
+    ParseCsvChunk(data.substr(splits[k], splits[k + 1] - splits[k]), options.load_notes,
+                  &parsed[k].views, &parsed[k].arena);
+  });
+
+  size_t total = 0;
+  for (const ParsedChunk& chunk : parsed) total += chunk.views.size();
+  views_.reserve(total);
+  for (ParsedChunk& chunk : parsed) {
+    views_.insert(views_.end(), chunk.views.begin(), chunk.views.end());
+    arena_.Absorb(std::move(chunk.arena));
   }
 }
 
-void Tracker::Add(const Entry& entry) {
-  // Basic validation.
-  if (entry.mood < 1 || entry.mood > 100) {
-    throw std::runtime_error("Mood must be between 1 and 100.");
+void Tracker::LoadPartitions(const LoadOptions& options) {
+  // Months that end before the cutoff cannot hold entries on or after it, whatever the order of
+  // entries inside each file.
+  TraceSpan span("load_partitions");
+  std::vector<Partition> partitions = ListPartitions(data_path_);
+  if (options.since_day != kInvalidDay) {
+    partitions.erase(std::remove_if(partitions.begin(), partitions.end(),
+                                    [&](const Partition& partition) {
+                                      return partition.last_day < options.since_day;
+                                    }),
+                     partitions.end());
+  }
+
+  partition_files_.resize(partitions.size());
+  if (!options.use_mmap) partition_buffers_.resize(partitions.size());
+  std::vector<ParsedChunk> parsed(partitions.size());
+  auto load_partition = [&](size_t i) {
+    std::string_view data;
+    if (options.use_mmap) {
+      if (!partition_files_[i].Open(partitions[i].path)) return;
+      data = partition_files_[i].data();
+    } else {
+      std::ifstream in(partitions[i].path, std::ios::binary);
+      if (!in.is_open()) return;
+      partition_buffers_[i].assign(std::istreambuf_iterator<char>(in),
+                                   std::istreambuf_iterator<char>());
+      data = partition_buffers_[i];
+    }
+    ParseCsvChunk(data, options.load_notes, &parsed[i].views, &parsed[i].arena);
+  };
+
+  // With a limit, read months newest first until enough entries are in; otherwise read all the
+  // months concurrently.
+  size_t first = 0;
+  if (options.limit > 0) {
+    size_t rows = 0;
+    first = partitions.size();
+    while (first > 0 && rows < options.limit) {
+      load_partition(--first);
+      rows += parsed[first].views.size();
+    }
+  } else {
+    RunParallel(partitions.size(), ResolveThreadCount(options.threads), load_partition);
+  }
+
+  size_t total = 0;
+  for (size_t i = first; i < parsed.size(); ++i) total += parsed[i].views.size();
+  const size_t skip = options.limit > 0 && total > options.limit ? total - options.limit : 0;
+  views_.reserve(total - skip);
+  for (size_t i = first; i < parsed.size(); ++i) {
+    views_.insert(views_.end(), parsed[i].views.begin(), parsed[i].views.end());
+    arena_.Absorb(std::move(parsed[i].arena));
   }
-  if (entry.date.size() != 10) {
-    throw std::runtime_error("Date must be YYYY-MM-DD.");
+  views_.erase(views_.begin(), views_.begin() + static_cast<std::ptrdiff_t>(skip));
+  span.Counter("partitions", static_cast<int64_t>(parsed.size() - first));
+  span.Counter("entries", static_cast<int64_t>(views_.size()));
+}
+
+void Tracker::LoadColumnar(std::string_view data, const LoadOptions& options) {
+  const std::vector<ColumnarBlock> blocks = ReadColumnarBlocks(data);
+
+  // Rows [first_block:first_row, end) are loaded. A tail load finds the start by walking back.
+  size_t first_block = 0;
+  size_t first_row = 0;
+  size_t rows = 0;
+  if (IsTailLoad(options)) {
+    first_block = blocks.size();
+    for (size_t b = blocks.size(); b-- > 0;) {
+      size_t i = blocks[b].row_count;
+      while (i > 0 && !TailIsComplete(options, rows, blocks[b].Day(i - 1))) {
+        --i;
+        ++rows;
+      }
+      first_block = b;
+      first_row = i;
+      if (i > 0) break;
+    }
+  } else {
+    for (const ColumnarBlock& block : blocks) rows += block.row_count;
   }
 
-  entries_.push_back(entry);
-  AppendToDisk(entry);
+  // Dates are stored as day numbers; format them all into one arena buffer.
+  constexpr size_t kDateLength = 10;
+  char* date = arena_.Allocate(rows * kDateLength);
+
+  views_.reserve(rows);
+  for (size_t b = first_block; b < blocks.size(); ++b) {
+    const ColumnarBlock& block = blocks[b];
+    for (size_t i = b == first_block ? first_row : 0; i < block.row_count; ++i) {
+      EntryView view;
+      view.day = block.Day(i);
+      FormatIsoDate(view.day, date);
+      view.date = std::string_view(date, kDateLength);
+      view.mood = block.moods[i];
+      if (options.load_notes) view.note = block.Note(i);
+      views_.push_back(view);
+      date += kDateLength;
+    }
+  }
 }
 
-const std::vector<Entry>& Tracker::Entries() const { return entries_; }
+void Tracker::Add(const Entry& entry) { AddBatch({entry}); }
 
-void Tracker::AppendToDisk(const Entry& entry) const {
-  fs::path path(data_path_);
-  if (path.has_parent_path()) {
-    fs::create_directories(path.parent_path());
+void Tracker::AddBatch(const std::vector<Entry>& entries) {
+  // Validate the whole batch first so a bad entry never leaves half a batch on disk.
+  std::vector<int32_t> days;
+  days.reserve(entries.size());
+  for (const Entry& entry : entries) {
+    if (entry.mood < 1 || entry.mood > 100) {
+      throw std::runtime_error("Mood must be between 1 and 100.");
+    }
+    const int32_t day = ParseIsoDate(entry.date);
+    if (day == kInvalidDay) {
+      throw std::runtime_error("Date must be a valid YYYY-MM-DD.");
+    }
+    days.push_back(day);
   }
+  if (entries.empty()) return;
 
-  std::ofstream out(data_path_, std::ios::app);
+  // Carry the sidecars across the append if they describe the file as it is now.
+  const DataFileStamp before = StampDataFile(data_path_);
+  std::optional<AggregateCache> aggregates;
+  if (aggregates_ && before == aggregates_stamp_) {
+    aggregates = std::move(aggregates_);
+  } else {
+    AggregateCache cache;
+    if (AggregateCache::ReadIfFresh(data_path_, &cache)) aggregates = std::move(cache);
+  }
+  aggregates_.reset();
+  // Appends to partitioned data land mid-file-order, which would shift the index's entry ids.
+  std::optional<NoteIndex> notes;
+  if (!IsPartitionedDataPath(data_path_)) {
+    if (notes_ && before == notes_stamp_) {
+      notes = std::move(notes_);
+    } else {
+      NoteIndex index;
+      if (NoteIndex::ReadIfFresh(data_path_, &index)) notes = std::move(index);
+    }
+  }
+  notes_.reset();
+  std::optional<DataOrder> order;
+  if (!IsPartitionedDataPath(data_path_)) {
+    if (order_ && before == order_stamp_) {
+      order = std::move(order_);
+    } else {
+      DataOrder sidecar;
+      if (DataOrder::ReadIfFresh(data_path_, &sidecar)) order = sidecar;
+    }
+  }
+  order_.reset();
+
+  const uint64_t appended = AppendToDisk(entries, days);
+
+  const DataFileStamp after = StampDataFile(data_path_);
+  // Appenders only share the file's lock, so another process may have appended between the two
+  // stamps. If so, the carried state lacks its entries (and the note index's offsets are off);
+  // drop it rather than stamp it as describing the file, and let the next reader rebuild.
+  const bool only_ours = after.size == before.size + appended;
+  if (!only_ours) {
+    aggregates.reset();
+    notes.reset();
+    order.reset();
+  }
+  if (loaded_ && loaded_stamp_ == before && only_ours) {
+    loaded_stamp_ = after;
+  } else if (loaded_) {
+    // Someone else appended since the last load; which bytes are ours is no longer known, so the
+    // next Refresh() reloads.
+    csv_appendable_ = false;
+  }
+  if (aggregates) {
+    for (size_t i = 0; i < entries.size(); ++i) aggregates->Add(days[i], entries[i].mood);
+    aggregates->Save(data_path_, after);
+    aggregates_stamp_ = after;
+    aggregates_ = std::move(aggregates);
+  }
+  if (notes) {
+    // CSV records are appended back to back at the old end of the file.
+    uint64_t offset = before.size;
+    for (size_t i = 0; i < entries.size(); ++i) {
+      notes->Add(days[i], entries[i].note, notes->has_offsets() ? offset : NoteIndex::kNoOffset);
+      if (notes->has_offsets()) offset += entries[i].ToCsv().size() + 1;
+    }
+    notes->Save(data_path_, after);
+    notes_stamp_ = after;
+    notes_ = std::move(notes);
+  }
+  if (order) {
+    for (const int32_t day : days) order->Add(day);
+    order->Save(data_path_, after);
+    order_stamp_ = after;
+    order_ = std::move(order);
+  }
+
+  views_.reserve(views_.size() + entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    EntryView view;
+    view.date = arena_.Intern(entries[i].date);
+    view.mood = entries[i].mood;
+    view.note = intern_notes_ ? arena_.Intern(entries[i].note) : arena_.Store(entries[i].note);
+    view.day = days[i];
+    AppendView(view);
+  }
+}
+
+void Tracker::SyncIfDue() {
+  log_.SyncIfDue();
+  for (auto& [path, log] : partition_logs_) log.SyncIfDue();
+}
+
+void Tracker::Close() {
+  log_.Close();
+  for (auto& [path, log] : partition_logs_) log.Close();
+}
+
+void Tracker::AppendView(const EntryView& view) {
+  views_.push_back(view);
+  if (by_date_built_) {
+    // After any entries of the same day, so equal days stay in file order.
+    by_date_.insert(std::upper_bound(by_date_.begin(), by_date_.end(), view.day, DayBefore),
+                    view);
+  }
+}
+
+const std::vector<Entry>& Tracker::Entries() const {
+  entries_.reserve(views_.size());
+  for (size_t i = entries_.size(); i < views_.size(); ++i) {
+    entries_.push_back(views_[i].ToEntry());
+  }
+  return entries_;
+}
+
+const std::vector<EntryView>& Tracker::Views() const { return views_; }
+
+absl::Span<const EntryView> Tracker::Query(int32_t from_day, int32_t to_day) const {
+  if (!by_date_built_) {
+    TraceSpan span("build_date_index");
+    span.Counter("entries", static_cast<int64_t>(views_.size()));
+    by_date_ = views_;
+    for (const EntryView& view : by_date_) {
+      if (view.day == kInvalidDay) {
+        throw std::runtime_error("Invalid date in data: " + std::string(view.date));
+      }
+    }
+    // Files are usually appended in date order, so skip the sort when they already are.
+    if (!std::is_sorted(by_date_.begin(), by_date_.end(), ViewDayLess)) {
+      std::stable_sort(by_date_.begin(), by_date_.end(), ViewDayLess);
+    }
+    by_date_built_ = true;
+  }
+  if (from_day > to_day) return {};
+  const auto begin = std::lower_bound(by_date_.begin(), by_date_.end(), from_day, ViewBeforeDay);
+  const auto end = std::upper_bound(begin, by_date_.end(), to_day, DayBefore);
+  return absl::Span<const EntryView>(by_date_.data() + (begin - by_date_.begin()),
+                                     static_cast<size_t>(end - begin));
+}
+
+void Tracker::Scan(const LoadOptions& options,
+                   absl::FunctionRef<void(const EntryView&)> visit) const {
+  TraceSpan span("scan");
+  int64_t entries = 0;
+  const auto counted_visit = [&](const EntryView& view) {
+    ++entries;
+    visit(view);
+  };
+  if (IsPartitionedDataPath(data_path_)) {
+    for (const Partition& partition : ListPartitions(data_path_)) {
+      if (options.since_day != kInvalidDay && partition.last_day < options.since_day) continue;
+      ScanFile(partition.path, options, counted_visit);
+    }
+  } else {
+    ScanFile(data_path_, options, counted_visit);
+  }
+  span.Counter("entries", entries);
+}
+
+const AggregateCache& Tracker::Aggregates(const LoadOptions& options) {
+  const DataFileStamp stamp = StampDataFile(data_path_);
+  if (aggregates_ && stamp == aggregates_stamp_) return *aggregates_;
+
+  TraceSpan span("aggregates");
+  AggregateCache cache;
+  const bool fresh = AggregateCache::ReadIfFresh(data_path_, &cache);
+  span.Counter("sidecar_hit", fresh);
+  if (!fresh && loaded_) {
+    if (loaded_stamp_ != stamp) Load(options);
+    cache = AggregateCache::Build(views_);
+    cache.Save(data_path_, loaded_stamp_);
+  } else if (!fresh) {
+    LoadOptions scan_options = options;
+    scan_options.load_notes = false;
+    scan_options.since_day = kInvalidDay;
+    Scan(scan_options, [&](const EntryView& view) {
+      if (view.day == kInvalidDay) {
+        throw std::runtime_error("Invalid date in data: " + std::string(view.date));
+      }
+      cache.Add(view.day, view.mood);
+    });
+    cache.Save(data_path_, stamp);
+  }
+  aggregates_ = std::move(cache);
+  aggregates_stamp_ = stamp;
+  return *aggregates_;
+}
+
+const DataOrder& Tracker::Order(const LoadOptions& options) {
+  if (IsPartitionedDataPath(data_path_)) {
+    throw std::runtime_error("Partitioned data has no single file order: " + data_path_);
+  }
+  const DataFileStamp stamp = StampDataFile(data_path_);
+  if (order_ && stamp == order_stamp_) return *order_;
+
+  TraceSpan span("order");
+  DataOrder order;
+  const bool fresh = DataOrder::ReadIfFresh(data_path_, &order);
+  span.Counter("sidecar_hit", fresh);
+  if (!fresh && loaded_ && loaded_stamp_ == stamp) {
+    order = DataOrder::Build(views_);
+    order.Save(data_path_, stamp);
+  } else if (!fresh) {
+    LoadOptions scan_options = options;
+    scan_options.load_notes = false;
+    scan_options.since_day = kInvalidDay;
+    Scan(scan_options, [&](const EntryView& view) { order.Add(view.day); });
+    order.Save(data_path_, stamp);
+  }
+  order_ = order;
+  order_stamp_ = stamp;
+  return *order_;
+}
+
+CompactionStats Tracker::Compact(MergePolicy policy, const LoadOptions& options) {
+  if (IsPartitionedDataPath(data_path_)) {
+    throw std::runtime_error("Partitioned data cannot be compacted: " + data_path_);
+  }
+  TraceSpan span("compact");
+  if (!loaded_ || !load_options_.load_notes || loaded_stamp_ != StampDataFile(data_path_)) {
+    LoadOptions full = options;
+    full.load_notes = true;
+    full.limit = 0;
+    full.since_day = kInvalidDay;
+    Load(full);
+  }
+  const DataFileStamp before = loaded_stamp_;
+  CompactionStats stats;
+  stats.entries_before = views_.size();
+  stats.out_of_order = DataOrder::Build(views_).out_of_order();
+  const std::vector<EntryView> compacted =
+      CompactEntries(Query(std::numeric_limits<int32_t>::min(),
+                           std::numeric_limits<int32_t>::max()),
+                     policy, &arena_);
+  stats.entries_after = compacted.size();
+
+  // The temporary file keeps the extension, which picks the format WriteDataFile() writes.
+  const fs::path path(data_path_);
+  const std::string tmp_path =
+      (path.parent_path() / (path.stem().string() + ".compact" + path.extension().string()))
+          .string();
+  WriteDataFile(tmp_path, compacted);
+  std::error_code ec;
+  if (!SyncFile(tmp_path)) {
+    fs::remove(tmp_path, ec);
+    throw std::runtime_error("Failed to sync compacted data file: " + tmp_path);
+  }
+  // Our own log must not wait on the locks below. Later appends reopen the data path.
+  log_.Close();
+  {
+    // Appenders wait from the stamp check until the sidecars describe the new file: the old
+    // file's lock keeps appends out of it, and the new file's lock holds those that reopen the
+    // data path after the rename.
+    const DataFileLock old_lock(data_path_, /*exclusive=*/true);
+    const DataFileLock new_lock(tmp_path, /*exclusive=*/true);
+    if (StampDataFile(data_path_) != before) {
+      fs::remove(tmp_path, ec);
+      throw std::runtime_error("Data file changed during compaction; try again: " + data_path_);
+    }
+    fs::rename(tmp_path, data_path_, ec);
+    if (ec) {
+      fs::remove(tmp_path, ec);
+      throw std::runtime_error("Failed to replace data file: " + data_path_);
+    }
+    if (!SyncDirectory(path.parent_path().string())) {
+      throw std::runtime_error("Failed to sync the directory of " + data_path_);
+    }
+
+    // Entry ids of the note index no longer match; Notes() rebuilds it on demand.
+    fs::remove(NoteIndex::SidecarPath(data_path_), ec);
+    notes_.reset();
+    const DataFileStamp after = StampDataFile(data_path_);
+    AggregateCache aggregates = AggregateCache::Build(compacted);
+    aggregates.Save(data_path_, after);
+    aggregates_ = std::move(aggregates);
+    aggregates_stamp_ = after;
+    order_ = DataOrder::Build(compacted);
+    order_->Save(data_path_, after);
+    order_stamp_ = after;
+  }
+
+  Load(load_options_);
+  span.Counter("entries_before", static_cast<int64_t>(stats.entries_before));
+  span.Counter("entries_after", static_cast<int64_t>(stats.entries_after));
+  return stats;
+}
+
+std::optional<CompactionStats> Tracker::CompactIfOutOfOrder(uint64_t threshold,
+                                                            MergePolicy policy,
+                                                            const LoadOptions& options) {
+  if (threshold == 0 || IsPartitionedDataPath(data_path_)) return std::nullopt;
+  if (Order(options).out_of_order() < threshold) return std::nullopt;
+  return Compact(policy, options);
+}
+
+const NoteIndex& Tracker::Notes() {
+  const DataFileStamp stamp = StampDataFile(data_path_);
+  if (notes_ && stamp == notes_stamp_) return *notes_;
+
+  TraceSpan span("notes");
+  NoteIndex index;
+  const bool fresh = NoteIndex::ReadIfFresh(data_path_, &index);
+  span.Counter("sidecar_hit", fresh);
+  if (!fresh) {
+    MappedFile file;
+    if (IsPartitionedDataPath(data_path_)) {
+      LoadOptions options;
+      options.use_mmap = true;
+      Scan(options, [&](const EntryView& view) { index.Add(view.day, view.note); });
+    } else if (file.Open(data_path_) && IsColumnarData(file.data())) {
+      ScanColumnar(file.data(), /*load_notes=*/true,
+                   [&](const EntryView& view) { index.Add(view.day, view.note); });
+    } else {
+      // A record's offset is where the scanner stood before it; any blank lines in between are
+      // skipped again when the record is read back.
+      CsvScanner scanner(file.data());
+      EntryView view;
+      std::string unescaped_note;
+      for (size_t start = 0; scanner.Next(&view, &unescaped_note); start = scanner.position()) {
+        index.Add(view.day, view.note, start);
+      }
+    }
+    index.Save(data_path_, stamp);
+  }
+  span.Counter("entries", static_cast<int64_t>(index.size()));
+  notes_ = std::move(index);
+  notes_stamp_ = stamp;
+  return *notes_;
+}
+
+std::vector<Entry> Tracker::Search(std::string_view query, int32_t from_day, int32_t to_day,
+                                   size_t limit, const LoadOptions& options) {
+  const NoteIndex& index = Notes();
+  const std::vector<uint32_t> ids = index.Search(query, from_day, to_day, limit);
+
+  TraceSpan span("read_matches");
+  span.Counter("matches", static_cast<int64_t>(ids.size()));
+  std::vector<Entry> matches;
+  matches.reserve(ids.size());
+  const bool views_current =
+      loaded_ && load_options_.load_notes && loaded_stamp_ == notes_stamp_;
+  if (!views_current && index.has_offsets()) {
+    MappedFile file;
+    if (!file.Open(data_path_)) throw std::runtime_error("Data file disappeared: " + data_path_);
+    EntryView view;
+    std::string unescaped_note;
+    for (const uint32_t id : ids) {
+      size_t pos = static_cast<size_t>(index.offset(id));
+      if (pos >= file.data().size() || !ParseCsvRecord(file.data(), &pos, &view, &unescaped_note)) {
+        throw std::runtime_error("Note index does not match the data file: " + data_path_);
+      }
+      matches.push_back(view.ToEntry());
+    }
+    return matches;
+  }
+  if (!views_current) Load(options);
+  for (const uint32_t id : ids) {
+    if (id < views_.size()) matches.push_back(views_[id].ToEntry());
+  }
+  return matches;
+}
+
+uint64_t Tracker::AppendToDisk(const std::vector<Entry>& entries,
+                               const std::vector<int32_t>& days) {
+  // Includes the sync the policy asks for.
+  TraceSpan span("append");
+  span.Counter("entries", static_cast<int64_t>(entries.size()));
+  if (IsPartitionedDataPath(data_path_)) {
+    // One write and one commit per month touched by the batch.
+    std::map<std::string, std::string> batches;
+    uint64_t appended = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+      std::string& batch = batches[PartitionPathForDay(data_path_, days[i])];
+      batch += entries[i].ToCsv();
+      batch += '\n';
+    }
+    for (const auto& [path, batch] : batches) {
+      AppendLog& log = partition_logs_[path];
+      if (!log.is_open()) log.Open(path, append_options_);
+      log.Append(batch);
+      log.Commit();
+      appended += batch.size();
+    }
+    return appended;
+  }
+
+  if (IsColumnarPath(data_path_)) {
+    // A batch becomes one block. The block and header are written through the columnar writer;
+    // the log's descriptor only applies the sync policy to the same file.
+    std::vector<EntryView> views;
+    views.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      views.push_back(EntryView{entries[i].date, entries[i].mood, entries[i].note, days[i]});
+    }
+    uint64_t appended = 0;
+    {
+      // Exclusive, as a block append rewrites the header; this also keeps it clear of compaction.
+      std::optional<DataFileLock> lock;
+      if (fs::exists(data_path_)) lock.emplace(data_path_, /*exclusive=*/true);
+      appended = AppendColumnarBlock(data_path_, views, append_options_);
+    }
+    if (!log_.is_open()) log_.Open(data_path_, append_options_);
+    log_.Commit();
+    return appended;
+  }
+
+  std::string batch;
+  for (const Entry& entry : entries) {
+    batch += entry.ToCsv();
+    batch += '\n';
+  }
+  if (!log_.is_open()) log_.Open(data_path_, append_options_);
+  log_.Append(batch);
+  log_.Commit();
+  return batch.size();
+}
+
+void WritePartitionedData(const std::string& dir, const std::vector<EntryView>& entries) {
+  if (IsPartitionedDataPath(dir) && !ListPartitions(dir).empty()) {
+    throw std::runtime_error("Partitioned data directory is not empty: " + dir);
+  }
+  std::map<std::string, std::vector<EntryView>> months;
+  for (const EntryView& entry : entries) {
+    if (entry.day == kInvalidDay) {
+      throw std::runtime_error("Invalid date in data: " + std::string(entry.date));
+    }
+    months[PartitionPathForDay(dir, entry.day)].push_back(entry);
+  }
+  fs::create_directories(dir);
+  for (const auto& [path, month] : months) WriteDataFile(path, month);
+}
+
+void WriteDataFile(const std::string& path, const std::vector<EntryView>& entries) {
+  if (fs::path(path).extension() == kColumnarExtension) {
+    WriteColumnarFile(path, entries);
+    return;
+  }
+
+  fs::path p(path);
+  if (p.has_parent_path()) {
+    fs::create_directories(p.parent_path());
+  }
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
   if (!out.is_open()) {
-    throw std::runtime_error("Failed to open data file for writing: " + data_path_);
+    throw std::runtime_error("Failed to open data file for writing: " + path);
+  }
+  for (const EntryView& entry : entries) {
+    out << entry.ToCsv() << "\n";
   }
-  out << entry.ToCsv() << "\n";
+  if (!out) throw std::runtime_error("Failed to write data file: " + path);
 }
 
 }  // namespace life_tracker
@@ -1,26 +1,187 @@
 #ifndef LIFE_TRACKER_TRACKER_H_
 #define LIFE_TRACKER_TRACKER_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "absl/functional/function_ref.h"
+#include "absl/types/span.h"
+#include "src/aggregate_cache.h"
+#include "src/append_log.h"
+#include "src/compaction.h"
 #include "src/entry.h"
+#include "src/mapped_file.h"
+#include "src/note_index.h"
+#include "src/string_arena.h"
 
 namespace life_tracker {
 
+struct LoadOptions {
+  // Map the data file instead of reading it into a heap buffer. Either way entries are parsed in
+  // place; only notes with escaped quotes are copied.
+  bool use_mmap = false;
+  // Commands that only need dates and moods can skip notes; views then carry empty notes and
+  // columnar files never touch their note bytes.
+  bool load_notes = true;
+  // Threads used to parse CSV data; 0 uses every hardware thread. Large files are split into
+  // record-aligned byte ranges that are parsed concurrently and stitched back in file order.
+  int threads = 1;
+  // Tail loading reads the data file backwards from its end and keeps only the newest entries:
+  // at most `limit` of them (0 = no limit), stopping at the first one dated before `since_day`
+  // (kInvalidDay = no cutoff). The cutoff assumes the file is in date order; partitioned data
+  // instead drops whole months before it and loads the rest in full. Only the records
+  // read are touched, so with use_mmap the cost follows the size of the tail, not of the file.
+  size_t limit = 0;
+  int32_t since_day = kInvalidDay;
+  // Copy dates and notes into the tracker's string arena after parsing and release the file
+  // buffer or mapping. Resident memory then follows the distinct strings rather than the file
+  // size: dates are interned, and so are notes with `intern_notes`.
+  bool detach = false;
+  // Intern notes ("gym", "ok", ...) so each distinct note is stored once. Applies to notes copied
+  // by `detach` and to notes added later with Add().
+  bool intern_notes = false;
+};
+
+// Writes `entries` to `path`, replacing any existing file. Paths with the columnar extension get
+// columnar data, anything else CSV.
+void WriteDataFile(const std::string& path, const std::vector<EntryView>& entries);
+
+// Writes `entries` into a new partitioned data directory at `dir`, one CSV file per month (see
+// partitions.h). Throws if `dir` already holds partitions.
+void WritePartitionedData(const std::string& dir, const std::vector<EntryView>& entries);
+
+// Loads and appends to a data file, or to a partitioned data directory when the data path names a
+// directory. Partitioned loads skip months before LoadOptions::since_day without reading them.
 class Tracker {
  public:
-  explicit Tracker(std::string data_path);
+  // `append_options` set the durability of Add() and AddBatch().
+  explicit Tracker(std::string data_path, AppendOptions append_options = AppendOptions());
 
-  void Load();
+  // Views point into the tracker's own buffers, so it is neither copyable nor movable.
+  Tracker(const Tracker&) = delete;
+  Tracker& operator=(const Tracker&) = delete;
+
+  void Load(const LoadOptions& options = LoadOptions());
+  // Brings the loaded entries up to date with the data path, for long-lived trackers. Records
+  // appended to a CSV file since the last Load() or Refresh() are parsed on their own when that
+  // load was detached; any other change reloads with the same options. Returns true if the data
+  // had changed.
+  bool Refresh();
   void Add(const Entry& entry);
+  // Validates every entry, then appends them all with one write and one commit, so a sync
+  // policy costs one fsync per batch rather than per entry.
+  void AddBatch(const std::vector<Entry>& entries);
+
+  // Syncs appends that an interval sync policy is holding back once the interval has passed (see
+  // AppendLog::SyncIfDue()). Long-lived trackers call this periodically.
+  void SyncIfDue();
+  // Closes the append logs, syncing whatever the policy still owes. Throws std::runtime_error if
+  // that fails, which the destructor would only swallow. Later appends reopen the logs.
+  void Close();
+
+  // Entries in file order. Owned copies are materialized from Views() on first use, so prefer
+  // Views() on hot paths.
   const std::vector<Entry>& Entries() const;
 
+  // Zero-copy entries in file order (for a tail load, the kept tail). Valid until the next
+  // Load().
+  const std::vector<EntryView>& Views() const;
+
+  // Loaded entries dated from `from_day` to `to_day` inclusive (day numbers, see date.h), in date
+  // order and in file order within a day. A date-sorted index of Views() is built on first use
+  // and kept sorted by Add(), so each query is a binary search plus the size of the range. The
+  // span is valid until the next Load() or Add().
+  absl::Span<const EntryView> Query(int32_t from_day, int32_t to_day) const;
+
+  // Calls `visit` with every entry of the data path in file order without keeping any of them,
+  // so memory stays flat however large the data is. Honors `use_mmap` and `load_notes`; without
+  // mmap, CSV data is read in fixed-size chunks. With `since_day`, partitioned data skips months
+  // before it, and a CSV file (which, as for tail loads, is assumed to be in date order) is
+  // mapped and read backwards to its first record dated `since_day` or later, so only the tail is
+  // parsed. The other options are ignored. Each view is valid only during its call. What the
+  // tracker has loaded is unaffected.
+  void Scan(const LoadOptions& options, absl::FunctionRef<void(const EntryView&)> visit) const;
+
+  // Mood aggregates for the data file. Served from the sidecar cache when its stamp matches the
+  // data file; otherwise the sidecar is rebuilt, from the loaded entries if a full Load() has
+  // been done (reloading with `options` if it is out of date) and by a Scan() if not. Add()
+  // keeps a fresh sidecar up to date incrementally.
+  const AggregateCache& Aggregates(const LoadOptions& options = LoadOptions());
+
+  // Date order of the data file. Served from the sidecar when its stamp matches the data file;
+  // otherwise rebuilt like Aggregates() and saved. Add() keeps a fresh sidecar up to date
+  // incrementally. Throws std::runtime_error for partitioned data, which has no single order.
+  const DataOrder& Order(const LoadOptions& options = LoadOptions());
+
+  // Rewrites the data file in date order with `policy` applied to each day (see
+  // CompactEntries()), then reloads it with the options of the last Load(). The new file is
+  // written and synced next to the old one and renamed over it, so readers see one or the other,
+  // never a mix; the sidecars are rebuilt to match. Entries are loaded with `options` (notes
+  // included) unless a full Load() is current. Throws std::runtime_error for partitioned data,
+  // or if another process changed the data file meanwhile, leaving it untouched.
+  CompactionStats Compact(MergePolicy policy, const LoadOptions& options = LoadOptions());
+  // Compact()s if at least `threshold` entries are out of order (see DataOrder), so back-dated
+  // appends do not pile up. A threshold of 0, or partitioned data, never compacts.
+  std::optional<CompactionStats> CompactIfOutOfOrder(uint64_t threshold, MergePolicy policy,
+                                                     const LoadOptions& options = LoadOptions());
+
+  // Inverted index over the notes of the data path. Served from the sidecar when its stamp
+  // matches the data; otherwise rebuilt by a Scan() and saved, with record offsets when the data
+  // is a CSV file. Add() keeps a fresh sidecar of a data file up to date incrementally;
+  // partitioned data routes appends to their months, so its index is rebuilt instead.
+  const NoteIndex& Notes();
+
+  // Entries whose notes contain every term of `query`, dated from `from_day` to `to_day`, newest
+  // first and at most `limit` of them (0 = all); see NoteIndex::Search(). Only the matching
+  // records of a CSV file are read; other data is loaded with `options` unless a full Load() is
+  // current.
+  std::vector<Entry> Search(std::string_view query, int32_t from_day, int32_t to_day,
+                            size_t limit, const LoadOptions& options = LoadOptions());
+
  private:
-  void AppendToDisk(const Entry& entry) const;
+  void LoadViews(const LoadOptions& options);
+  void AppendView(const EntryView& view);
+  void Detach();
+  void LoadCsv(std::string_view data, const LoadOptions& options);
+  void LoadCsvTail(std::string_view data, const LoadOptions& options);
+  void LoadColumnar(std::string_view data, const LoadOptions& options);
+  void LoadPartitions(const LoadOptions& options);
+  // Returns the number of bytes the data grew by.
+  uint64_t AppendToDisk(const std::vector<Entry>& entries, const std::vector<int32_t>& days);
 
   std::string data_path_;
-  std::vector<Entry> entries_;
+  AppendOptions append_options_;
+  AppendLog log_;  // Opened by the first append and kept open for later ones.
+  std::map<std::string, AppendLog> partition_logs_;  // Likewise, per partition file.
+  LoadOptions load_options_;
+  bool loaded_ = false;
+  // The loaded data is a CSV file whose last loaded record ends with a newline, so appended bytes
+  // start a new record.
+  bool csv_appendable_ = false;
+  DataFileStamp loaded_stamp_;
+  std::optional<AggregateCache> aggregates_;
+  DataFileStamp aggregates_stamp_;
+  std::optional<NoteIndex> notes_;
+  DataFileStamp notes_stamp_;
+  std::optional<DataOrder> order_;
+  DataFileStamp order_stamp_;
+  MappedFile mapping_;
+  std::string buffer_;  // File contents when not using mmap.
+  std::vector<MappedFile> partition_files_;
+  std::vector<std::string> partition_buffers_;  // Partition contents when not using mmap.
+  // Strings that views reference but the file does not contain: unescaped and added notes, added
+  // and columnar dates, and everything once detached.
+  StringArena arena_;
+  bool intern_notes_ = false;
+  std::vector<EntryView> views_;
+  mutable std::vector<Entry> entries_;  // Lazily materialized prefix of views_.
+  mutable std::vector<EntryView> by_date_;  // views_ stably sorted by day, built by Query().
+  mutable bool by_date_built_ = false;
 };
 
 }  // namespace life_tracker
@@ -0,0 +1,395 @@
+#include "src/tracker.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/dataset.h"
+#include "src/date.h"
+#include "src/test_util.h"
+
+namespace life_tracker {
+namespace {
+
+class TrackerTest : public TempDirTest, public ::testing::WithParamInterface<bool> {
+ protected:
+  void SetUp() override {
+    TempDirTest::SetUp();
+    data_path_ = (dir_ / "entries.csv").string();
+  }
+
+  void WriteFile(const std::string& contents) {
+    std::ofstream out(data_path_, std::ios::binary | std::ios::trunc);
+    out << contents;
+  }
+
+  LoadOptions Options() const {
+    LoadOptions options;
+    options.use_mmap = GetParam();
+    return options;
+  }
+
+  std::string data_path_;
+};
+
+TEST_P(TrackerTest, LoadMissingFileIsEmpty) {
+  Tracker tracker(data_path_);
+  tracker.Load(Options());
+  EXPECT_TRUE(tracker.Views().empty());
+  EXPECT_TRUE(tracker.Entries().empty());
+}
+
+TEST_P(TrackerTest, LoadEmptyFileIsEmpty) {
+  WriteFile("");
+  Tracker tracker(data_path_);
+  tracker.Load(Options());
+  EXPECT_TRUE(tracker.Views().empty());
+}
+
+TEST_P(TrackerTest, LoadParsesQuotedMultilineNotes) {
+  WriteFile("2026-01-01,40,plain\n2026-01-02,50,\"two\nlines, \"\"quoted\"\"\"\n");
+  Tracker tracker(data_path_);
+  tracker.Load(Options());
+
+  const auto& views = tracker.Views();
+  ASSERT_EQ(views.size(), 2u);
+  EXPECT_EQ(views[0].note, "plain");
+  EXPECT_EQ(views[1].date, "2026-01-02");
+  EXPECT_EQ(views[1].note, "two\nlines, \"quoted\"");
+
+  const auto& entries = tracker.Entries();
+  ASSERT_EQ(entries.size(), 2u);
+  EXPECT_EQ(entries[1].note, "two\nlines, \"quoted\"");
+}
+
+TEST_P(TrackerTest, AddAppendsAndRoundTrips) {
+  Entry e;
+  e.date = "2026-01-03";
+  e.mood = 42;
+  e.note = "hello, \"world\"";
+  {
+    Tracker tracker(data_path_);
+    tracker.Load(Options());
+    tracker.Add(e);
+    ASSERT_EQ(tracker.Views().size(), 1u);
+    EXPECT_EQ(tracker.Views()[0].note, e.note);
+  }
+
+  Tracker reloaded(data_path_);
+  reloaded.Load(Options());
+  ASSERT_EQ(reloaded.Entries().size(), 1u);
+  EXPECT_EQ(reloaded.Entries()[0].date, e.date);
+  EXPECT_EQ(reloaded.Entries()[0].mood, e.mood);
+  EXPECT_EQ(reloaded.Entries()[0].note, e.note);
+}
+
+TEST_P(TrackerTest, AddRejectsInvalidMood) {
+  Tracker tracker(data_path_);
+  Entry e;
+  e.date = "2026-01-03";
+  e.mood = 0;
+  EXPECT_THROW(tracker.Add(e), std::runtime_error);
+  EXPECT_FALSE(std::filesystem::exists(data_path_));
+}
+
+TEST_P(TrackerTest, AddRejectsInvalidDate) {
+  Tracker tracker(data_path_);
+  Entry e;
+  e.date = "2026-02-30";
+  e.mood = 50;
+  EXPECT_THROW(tracker.Add(e), std::runtime_error);
+}
+
+TEST_P(TrackerTest, LoadCachesDayNumbers) {
+  WriteFile("2026-01-02,40,a\nnot-a-date,50,b\n");
+  Tracker tracker(data_path_);
+  tracker.Load(Options());
+  ASSERT_EQ(tracker.Views().size(), 2u);
+  EXPECT_EQ(tracker.Views()[0].day, ParseIsoDate("2026-01-02"));
+  EXPECT_EQ(tracker.Views()[1].day, kInvalidDay);
+}
+
+TEST_P(TrackerTest, ParallelLoadMatchesSerialLoad) {
+  // Multi-line quoted notes make naive newline splitting land mid-record.
+  std::string contents;
+  for (int i = 0; contents.size() < (5u << 20); ++i) {
+    Entry e;
+    e.date = "2026-01-01";
+    e.mood = 1 + i % 100;
+    e.note = i % 3 == 0 ? "multi\nline, \"quoted\"\n" + std::to_string(i) : std::to_string(i);
+    contents += e.ToCsv() + "\n";
+  }
+  WriteFile(contents);
+
+  Tracker serial(data_path_);
+  serial.Load(Options());
+  LoadOptions parallel_options = Options();
+  parallel_options.threads = 4;
+  Tracker parallel(data_path_);
+  parallel.Load(parallel_options);
+
+  const auto& expected = serial.Views();
+  const auto& actual = parallel.Views();
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(actual[i].mood, expected[i].mood) << i;
+    ASSERT_EQ(actual[i].note, expected[i].note) << i;
+  }
+}
+
+TEST_P(TrackerTest, TailLoadKeepsNewestEntriesInFileOrder) {
+  WriteFile(
+      "2026-01-01,10,a\n2026-01-02,20,\"multi\nline\"\n2026-01-03,30,c\n2026-01-04,40,d\n");
+  LoadOptions options = Options();
+  options.limit = 2;
+  Tracker tracker(data_path_);
+  tracker.Load(options);
+  ASSERT_EQ(tracker.Views().size(), 2u);
+  EXPECT_EQ(tracker.Views()[0].date, "2026-01-03");
+  EXPECT_EQ(tracker.Views()[1].date, "2026-01-04");
+
+  options.limit = 0;
+  options.since_day = ParseIsoDate("2026-01-02");
+  tracker.Load(options);
+  ASSERT_EQ(tracker.Views().size(), 3u);
+  EXPECT_EQ(tracker.Views()[0].note, "multi\nline");
+}
+
+TEST_P(TrackerTest, AddBatchAppendsAllOrNothing) {
+  Tracker tracker(data_path_, AppendOptions{SyncPolicy::kBatch, 0});
+  std::vector<Entry> batch = {{"2026-01-01", 10, "a"}, {"2026-01-02", 20, "b,\"c\""}};
+  tracker.AddBatch(batch);
+  tracker.AddBatch({{"2026-01-03", 30, ""}});
+  EXPECT_THROW(tracker.AddBatch({{"2026-01-04", 40, ""}, {"2026-01-05", 0, ""}}),
+               std::runtime_error);
+  ASSERT_EQ(tracker.Views().size(), 3u);
+
+  Tracker reloaded(data_path_);
+  reloaded.Load(Options());
+  ASSERT_EQ(reloaded.Views().size(), 3u);
+  EXPECT_EQ(reloaded.Views()[1].note, "b,\"c\"");
+  EXPECT_EQ(reloaded.Views()[2].mood, 30);
+}
+
+TEST_P(TrackerTest, CloseSyncsAndLaterAddsReopen) {
+  Tracker tracker(data_path_, AppendOptions{SyncPolicy::kInterval, 60000});
+  tracker.Add({"2026-01-01", 10, "a"});
+  tracker.SyncIfDue();
+  tracker.Close();
+  tracker.Add({"2026-01-02", 20, "b"});
+  tracker.Close();
+
+  Tracker reloaded(data_path_);
+  reloaded.Load(Options());
+  ASSERT_EQ(reloaded.Views().size(), 2u);
+  EXPECT_EQ(reloaded.Views()[1].note, "b");
+}
+
+TEST_P(TrackerTest, QueryReturnsDateRangeInDateOrder) {
+  WriteFile("2026-01-05,50,e\n2026-01-01,10,a\n2026-01-03,30,c1\n2026-01-09,90,i\n");
+  Tracker tracker(data_path_);
+  tracker.Load(Options());
+
+  auto notes = [](absl::Span<const EntryView> views) {
+    std::vector<std::string> out;
+    for (const EntryView& view : views) out.emplace_back(view.note);
+    return out;
+  };
+  const int32_t jan1 = ParseIsoDate("2026-01-01");
+  EXPECT_EQ(notes(tracker.Query(jan1 + 2, jan1 + 4)), (std::vector<std::string>{"c1", "e"}));
+  EXPECT_EQ(notes(tracker.Query(jan1 - 10, jan1 + 100)),
+            (std::vector<std::string>{"a", "c1", "e", "i"}));
+  EXPECT_TRUE(tracker.Query(jan1 + 5, jan1 + 7).empty());
+  EXPECT_TRUE(tracker.Query(jan1 + 4, jan1 + 2).empty());
+
+  // Out-of-order adds land in place, after existing entries of the same day.
+  tracker.Add({"2026-01-03", 35, "c2"});
+  tracker.Add({"2025-12-31", 5, "z"});
+  EXPECT_EQ(notes(tracker.Query(jan1 - 1, jan1 + 2)),
+            (std::vector<std::string>{"z", "a", "c1", "c2"}));
+  EXPECT_EQ(tracker.Views().back().note, "z");  // Views() stays in file order.
+}
+
+TEST_P(TrackerTest, PartitionedDirectoryRoutesAddsAndPrunesMonths) {
+  const std::string dir = (dir_ / "parts").string();
+  WritePartitionedData(dir, {{"2026-01-20", 10, "jan", ParseIsoDate("2026-01-20")},
+                             {"2025-12-31", 20, "dec", ParseIsoDate("2025-12-31")}});
+  EXPECT_THROW(WritePartitionedData(dir, {}), std::runtime_error);
+
+  Tracker tracker(dir);
+  tracker.AddBatch({{"2026-02-02", 30, "feb"}, {"2026-01-05", 40, "jan2"}});
+  EXPECT_TRUE(std::filesystem::exists(dir_ / "parts" / "2026" / "02.csv"));
+
+  LoadOptions options = Options();
+  options.threads = 4;
+  tracker.Load(options);
+  ASSERT_EQ(tracker.Views().size(), 4u);
+  EXPECT_EQ(tracker.Views()[0].note, "dec");
+  EXPECT_EQ(tracker.Views()[1].note, "jan");
+  EXPECT_EQ(tracker.Views()[2].note, "jan2");
+  EXPECT_EQ(tracker.Views()[3].note, "feb");
+
+  // Only January and February are read; December is pruned unopened.
+  options.since_day = ParseIsoDate("2026-01-25");
+  tracker.Load(options);
+  EXPECT_EQ(tracker.Views().size(), 3u);
+
+  options.since_day = kInvalidDay;
+  options.limit = 2;
+  tracker.Load(options);
+  ASSERT_EQ(tracker.Views().size(), 2u);
+  EXPECT_EQ(tracker.Views()[0].note, "jan2");
+
+  EXPECT_EQ(tracker.Aggregates().Summarize(1000, absl::CivilDay(2026, 2, 2)).count, 4);
+}
+
+TEST_P(TrackerTest, DetachedLoadOutlivesTheFileAndInternsNotes) {
+  WriteFile("2026-01-01,10,gym\n2026-01-01,20,\"say \"\"hi\"\"\"\n2026-01-02,30,gym\n");
+  LoadOptions options = Options();
+  options.detach = true;
+  options.intern_notes = true;
+  Tracker tracker(data_path_);
+  tracker.Load(options);
+  WriteFile("");  // The views no longer depend on the file contents.
+
+  const auto& views = tracker.Views();
+  ASSERT_EQ(views.size(), 3u);
+  EXPECT_EQ(views[0].note, "gym");
+  EXPECT_EQ(views[1].note, "say \"hi\"");
+  EXPECT_EQ(views[0].note.data(), views[2].note.data());
+  EXPECT_EQ(views[0].date.data(), views[1].date.data());
+
+  tracker.Add({"2026-01-03", 40, "gym"});
+  EXPECT_EQ(tracker.Views().back().note.data(), views[0].note.data());
+}
+
+TEST_P(TrackerTest, RefreshParsesOnlyWholeAppendedRecords) {
+  WriteFile("2026-01-01,10,gym\n");
+  LoadOptions options = Options();
+  options.detach = true;
+  Tracker tracker(data_path_);
+  tracker.Load(options);
+  EXPECT_EQ(tracker.Aggregates().Summarize(7, absl::CivilDay(2026, 1, 7)).count, 1);
+  EXPECT_FALSE(tracker.Refresh());
+
+  {
+    std::ofstream out(data_path_, std::ios::binary | std::ios::app);
+    out << "2026-01-02,20,\"two\nlines\"\n2026-01-03,30,\"half";
+  }
+  EXPECT_TRUE(tracker.Refresh());
+  ASSERT_EQ(tracker.Views().size(), 2u);
+  EXPECT_EQ(tracker.Views()[1].note, "two\nlines");
+
+  {
+    std::ofstream out(data_path_, std::ios::binary | std::ios::app);
+    out << " done\"\n";
+  }
+  EXPECT_TRUE(tracker.Refresh());
+  ASSERT_EQ(tracker.Views().size(), 3u);
+  EXPECT_EQ(tracker.Views()[2].note, "half done");
+  EXPECT_EQ(tracker.Aggregates().Summarize(7, absl::CivilDay(2026, 1, 7)).count, 3);
+
+  // Anything but an append starts over.
+  WriteFile("2026-02-01,50,new\n");
+  EXPECT_TRUE(tracker.Refresh());
+  ASSERT_EQ(tracker.Views().size(), 1u);
+  EXPECT_EQ(tracker.Views()[0].note, "new");
+}
+
+TEST_P(TrackerTest, ScanVisitsWhatLoadLoads) {
+  // Large enough that buffered scans read several chunks and split records between them.
+  DatasetOptions dataset;
+  dataset.rows = 150000;
+  WriteSyntheticCsvFile(data_path_, dataset);
+  ASSERT_GT(std::filesystem::file_size(data_path_), 5u << 20);
+
+  Tracker loaded(data_path_);
+  loaded.Load(Options());
+  const std::vector<EntryView>& expected = loaded.Views();
+  size_t i = 0;
+  Tracker(data_path_).Scan(Options(), [&](const EntryView& view) {
+    ASSERT_LT(i, expected.size());
+    ASSERT_EQ(view.date, expected[i].date) << i;
+    ASSERT_EQ(view.day, expected[i].day) << i;
+    ASSERT_EQ(view.mood, expected[i].mood) << i;
+    ASSERT_EQ(view.note, expected[i].note) << i;
+    ++i;
+  });
+  EXPECT_EQ(i, expected.size());
+}
+
+TEST_P(TrackerTest, ScanSinceDaySkipsToTheFirstRecordInRangeOfSortedData) {
+  WriteFile("2026-01-01,10,a\n2026-01-02,20,\"two\nlines\"\n2026-01-03,30,c\n2026-01-03,35,d\n");
+  LoadOptions options = Options();
+  options.since_day = ParseIsoDate("2026-01-02");
+  std::vector<std::string> notes;
+  Tracker(data_path_).Scan(options, [&](const EntryView& view) {
+    notes.push_back(std::string(view.note));
+  });
+  EXPECT_EQ(notes, (std::vector<std::string>{"two\nlines", "c", "d"}));
+
+  options.since_day = ParseIsoDate("2026-02-01");
+  notes.clear();
+  Tracker(data_path_).Scan(options, [&](const EntryView& view) {
+    notes.push_back(std::string(view.note));
+  });
+  EXPECT_TRUE(notes.empty());
+}
+
+TEST_P(TrackerTest, AddBatchDropsSidecarsWhenAnotherAppenderInterleaves) {
+  WriteFile("2026-01-01,10,gym\n2026-01-02,20,run\n");
+  Tracker tracker(data_path_);
+  tracker.Aggregates(Options());
+  tracker.Notes();
+  tracker.Order();
+  {
+    // Holding the file's lock parks the tracker's append after it has stamped the file, while
+    // another appender adds a record behind its back.
+    std::optional<DataFileLock> lock(std::in_place, data_path_, /*exclusive=*/true);
+    std::thread adder([&] { tracker.Add({"2026-01-04", 40, "swim"}); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::ofstream(data_path_, std::ios::binary | std::ios::app) << "2026-01-05,50,gym\n";
+    lock.reset();
+    adder.join();
+  }
+
+  const absl::CivilDay today(2026, 2, 1);
+  EXPECT_EQ(tracker.Aggregates(Options()).Summarize(1000, today).count, 4);
+  Tracker reader(data_path_);
+  EXPECT_EQ(reader.Aggregates(Options()).Summarize(1000, today).count, 4);
+  EXPECT_EQ(reader.Order().out_of_order(), 1u);
+  constexpr int32_t kFirst = std::numeric_limits<int32_t>::min();
+  constexpr int32_t kLast = std::numeric_limits<int32_t>::max();
+  EXPECT_EQ(reader.Search("gym", kFirst, kLast, 0).size(), 2u);
+  const std::vector<Entry> swim = reader.Search("swim", kFirst, kLast, 0);
+  ASSERT_EQ(swim.size(), 1u);
+  EXPECT_EQ(swim[0].date, "2026-01-04");
+}
+
+TEST_P(TrackerTest, AggregatesWithoutLoadScanTheFile) {
+  WriteFile("2026-01-01,10,gym\n2026-01-02,20,\"two\nlines\"\n2026-01-04,30,\n");
+  Tracker tracker(data_path_);
+  const AggregateCache& aggregates = tracker.Aggregates(Options());
+  EXPECT_TRUE(tracker.Views().empty());
+  EXPECT_EQ(aggregates.Summarize(7, absl::CivilDay(2026, 1, 7)).count, 3);
+  EXPECT_EQ(aggregates.Streaks(absl::CivilDay(2026, 1, 4)).longest_streak, 2);
+
+  WriteFile("2026-01-01,10,gym\nnot-a-date,20,x\n");
+  EXPECT_THROW(Tracker(data_path_).Aggregates(Options()), std::runtime_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(LoadModes, TrackerTest, ::testing::Bool(),
+                         [](const ::testing::TestParamInfo<bool>& info) {
+                           return info.param ? "Mapped" : "Buffered";
+                         });
+
+}  // namespace
+}  // namespace life_tracker
@@ -0,0 +1,118 @@
+#include "src/trend.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "src/date.h"
+#include "src/trace.h"
+
+namespace life_tracker {
+namespace {
+
+// Mean and population standard deviation of `count` moods with the given sums.
+void Moments(int64_t count, int64_t sum, int64_t sum_squares, double* mean, double* stddev) {
+  const double n = static_cast<double>(count);
+  *mean = static_cast<double>(sum) / n;
+  // The sums are exact integers, so only this last step rounds.
+  const double variance = (static_cast<double>(sum_squares) - static_cast<double>(sum) * *mean) / n;
+  *stddev = std::sqrt(std::max(variance, 0.0));
+}
+
+}  // namespace
+
+Trend TrendDays(const std::vector<AggregateBucket>& days, int32_t from_day, int32_t to_day) {
+  TraceSpan span("trend");
+  Trend trend;
+  if (from_day > to_day) return trend;
+  constexpr int32_t kLookback = kLongTrendDays - 1;
+  const int32_t first_day = from_day >= std::numeric_limits<int32_t>::min() + kLookback
+                                ? from_day - kLookback
+                                : std::numeric_limits<int32_t>::min();
+  const auto key_less = [](const AggregateBucket& bucket, int32_t day) { return bucket.key < day; };
+  const auto begin = std::lower_bound(days.begin(), days.end(), first_day, key_less);
+  const auto end = std::upper_bound(begin, days.end(), to_day,
+                                    [](int32_t day, const AggregateBucket& bucket) {
+                                      return day < bucket.key;
+                                    });
+  const size_t n = static_cast<size_t>(end - begin);
+
+  // Prefix sums over the days: element i covers the first i of them.
+  std::vector<int64_t> counts(n + 1, 0);
+  std::vector<int64_t> sums(n + 1, 0);
+  std::vector<int64_t> squares(n + 1, 0);
+  for (size_t i = 0; i < n; ++i) {
+    const MoodAggregate& mood = begin[i].mood;
+    counts[i + 1] = counts[i] + mood.count;
+    sums[i + 1] = sums[i] + mood.sum;
+    squares[i + 1] = squares[i] + mood.sum_squares;
+  }
+
+  // Both windows slide forward with the days, so their first days only ever advance.
+  size_t short_first = 0;
+  size_t long_first = 0;
+  // Sums for the slope, with x counted in days from the first point to keep them small.
+  double x_sum = 0;
+  double y_sum = 0;
+  double xx_sum = 0;
+  double xy_sum = 0;
+  int64_t samples = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const int32_t day = begin[i].key;
+    while (begin[short_first].key <= day - kShortTrendDays) ++short_first;
+    while (begin[long_first].key <= day - kLongTrendDays) ++long_first;
+    if (day < from_day) continue;
+
+    TrendPoint point;
+    point.day = day;
+    point.count = begin[i].mood.count;
+    point.average = static_cast<double>(begin[i].mood.sum) / static_cast<double>(point.count);
+    Moments(counts[i + 1] - counts[short_first], sums[i + 1] - sums[short_first],
+            squares[i + 1] - squares[short_first], &point.average7, &point.stddev7);
+    Moments(counts[i + 1] - counts[long_first], sums[i + 1] - sums[long_first],
+            squares[i + 1] - squares[long_first], &point.average30, &point.stddev30);
+    trend.points.push_back(point);
+
+    const double x = static_cast<double>(day - trend.points.front().day);
+    const double count = static_cast<double>(point.count);
+    const double sum = static_cast<double>(begin[i].mood.sum);
+    x_sum += x * count;
+    y_sum += sum;
+    xx_sum += x * x * count;
+    xy_sum += x * sum;
+    samples += point.count;
+  }
+
+  if (trend.points.size() >= 2) {
+    const double count = static_cast<double>(samples);
+    const double denominator = count * xx_sum - x_sum * x_sum;
+    if (denominator > 0) {
+      trend.has_slope = true;
+      trend.slope = (count * xy_sum - x_sum * y_sum) / denominator;
+    }
+  }
+  span.Counter("days", static_cast<int64_t>(n));
+  span.Counter("points", static_cast<int64_t>(trend.points.size()));
+  return trend;
+}
+
+Trend TrendEntries(absl::Span<const EntryView> entries, int32_t from_day, int32_t to_day) {
+  std::vector<AggregateBucket> days;
+  for (const EntryView& entry : entries) {
+    if (entry.day == kInvalidDay) {
+      throw std::runtime_error("Invalid date in data: " + std::string(entry.date));
+    }
+    if (days.empty() || entry.day != days.back().key) {
+      if (!days.empty() && entry.day < days.back().key) {
+        throw std::runtime_error("Trend input is not in date order.");
+      }
+      days.push_back({entry.day, MoodAggregate()});
+    }
+    days.back().mood.Add(entry.mood);
+  }
+  return TrendDays(days, from_day, to_day);
+}
+
+}  // namespace life_tracker
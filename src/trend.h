@@ -0,0 +1,50 @@
+#ifndef LIFE_TRACKER_TREND_H_
+#define LIFE_TRACKER_TREND_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "src/aggregate_cache.h"
+#include "src/entry.h"
+
+namespace life_tracker {
+
+// Lengths in days of the short and long rolling windows.
+inline constexpr int kShortTrendDays = 7;
+inline constexpr int kLongTrendDays = 30;
+
+// Rolling statistics for one day with entries. Each window is the trailing kShortTrendDays or
+// kLongTrendDays calendar days ending on `day`; days without entries just contribute nothing.
+// Standard deviations are population ones, as in SummaryStats.
+struct TrendPoint {
+  int32_t day = 0;
+  int64_t count = 0;    // Entries on the day.
+  double average = 0;   // Mean mood of the day.
+  double average7 = 0;  // Mean and standard deviation of every mood in the short window.
+  double stddev7 = 0;
+  double average30 = 0;  // The same for the long window.
+  double stddev30 = 0;
+};
+
+struct Trend {
+  std::vector<TrendPoint> points;  // Oldest first.
+  // Least-squares slope of mood against date over every entry in the range, in mood points per
+  // day. Needs entries on at least two days.
+  bool has_slope = false;
+  double slope = 0;
+};
+
+// Trend of the days from `from_day` to `to_day` inclusive, from the per-day aggregates of an
+// AggregateCache (AggregateCache::days()). The windows of the first points reach back before
+// `from_day`, so they are full wherever the data is. Every window is a difference of prefix sums
+// over the days, so this costs O(days with entries) however long the windows are.
+Trend TrendDays(const std::vector<AggregateBucket>& days, int32_t from_day, int32_t to_day);
+
+// The same over `entries`, which must be in date order (as Tracker::Query() returns them). Throws
+// std::runtime_error if an entry has a malformed date or the entries are out of order.
+Trend TrendEntries(absl::Span<const EntryView> entries, int32_t from_day, int32_t to_day);
+
+}  // namespace life_tracker
+
+#endif  // LIFE_TRACKER_TREND_H_
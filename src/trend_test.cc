@@ -0,0 +1,141 @@
+#include "src/trend.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/date.h"
+
+namespace life_tracker {
+namespace {
+
+constexpr int32_t kAllDays = std::numeric_limits<int32_t>::max();
+constexpr int32_t kNoDays = std::numeric_limits<int32_t>::min();
+
+// Date-ordered views of (date, mood) pairs; the dates outlive the views.
+class Series {
+ public:
+  void Add(int32_t day, int mood) {
+    dates_.push_back(std::string(10, ' '));
+    FormatIsoDate(day, dates_.back().data());
+    moods_.push_back(mood);
+  }
+
+  std::vector<EntryView> Views() const {
+    std::vector<EntryView> views;
+    for (size_t i = 0; i < dates_.size(); ++i) {
+      views.push_back({dates_[i], moods_[i], "", ParseIsoDate(dates_[i])});
+    }
+    return views;
+  }
+
+ private:
+  std::vector<std::string> dates_;
+  std::vector<int> moods_;
+};
+
+// Mean and population standard deviation of the moods from `first` to `last` inclusive.
+void BruteForce(const std::vector<EntryView>& views, int32_t first, int32_t last, double* mean,
+                double* stddev) {
+  double sum = 0;
+  int count = 0;
+  for (const EntryView& view : views) {
+    if (view.day < first || view.day > last) continue;
+    sum += view.mood;
+    ++count;
+  }
+  *mean = sum / count;
+  double squares = 0;
+  for (const EntryView& view : views) {
+    if (view.day < first || view.day > last) continue;
+    squares += (view.mood - *mean) * (view.mood - *mean);
+  }
+  *stddev = std::sqrt(squares / count);
+}
+
+TEST(TrendTest, MatchesRecomputedWindows) {
+  std::mt19937 rng(7);
+  Series series;
+  const int32_t start = ParseIsoDate("2026-01-01");
+  for (int32_t day = start; day < start + 120; ++day) {
+    if (rng() % 3 == 0) continue;  // Gaps, so windows hold varying numbers of days.
+    for (int k = static_cast<int>(rng() % 3); k >= 0; --k) {
+      series.Add(day, 1 + static_cast<int>(rng() % 100));
+    }
+  }
+  const std::vector<EntryView> views = series.Views();
+  const int32_t from = start + 40;
+  const int32_t to = start + 100;
+
+  const Trend trend = TrendEntries(views, from, to);
+  ASSERT_FALSE(trend.points.empty());
+  EXPECT_GE(trend.points.front().day, from);
+  EXPECT_LE(trend.points.back().day, to);
+  for (const TrendPoint& point : trend.points) {
+    double mean = 0;
+    double stddev = 0;
+    BruteForce(views, point.day, point.day, &mean, &stddev);
+    EXPECT_NEAR(point.average, mean, 1e-9);
+    BruteForce(views, point.day - (kShortTrendDays - 1), point.day, &mean, &stddev);
+    EXPECT_NEAR(point.average7, mean, 1e-9) << point.day;
+    EXPECT_NEAR(point.stddev7, stddev, 1e-9) << point.day;
+    BruteForce(views, point.day - (kLongTrendDays - 1), point.day, &mean, &stddev);
+    EXPECT_NEAR(point.average30, mean, 1e-9) << point.day;
+    EXPECT_NEAR(point.stddev30, stddev, 1e-9) << point.day;
+  }
+}
+
+TEST(TrendTest, SlopeFitsEveryEntry) {
+  Series series;
+  const int32_t start = ParseIsoDate("2026-03-01");
+  // mood = 10 + 2 * day, with a symmetric spread that leaves the fit unchanged.
+  for (int i = 0; i < 20; ++i) {
+    series.Add(start + i, 10 + 2 * i - 3);
+    series.Add(start + i, 10 + 2 * i + 3);
+  }
+  const Trend trend = TrendEntries(series.Views(), kNoDays, kAllDays);
+  ASSERT_TRUE(trend.has_slope);
+  EXPECT_NEAR(trend.slope, 2.0, 1e-9);
+  EXPECT_EQ(trend.points.size(), 20u);
+  EXPECT_EQ(trend.points[0].count, 2);
+  EXPECT_NEAR(trend.points[0].stddev7, 3.0, 1e-9);
+
+  Series one_day;
+  one_day.Add(start, 50);
+  one_day.Add(start, 60);
+  EXPECT_FALSE(TrendEntries(one_day.Views(), kNoDays, kAllDays).has_slope);
+  EXPECT_TRUE(TrendEntries({}, kNoDays, kAllDays).points.empty());
+}
+
+TEST(TrendTest, AggregatesGiveTheSameTrend) {
+  std::mt19937 rng(9);
+  Series series;
+  const int32_t start = ParseIsoDate("2025-12-01");
+  for (int i = 0; i < 400; ++i) series.Add(start + i / 4, 1 + static_cast<int>(rng() % 100));
+  const std::vector<EntryView> views = series.Views();
+  const AggregateCache cache = AggregateCache::Build(views);
+
+  const Trend expected = TrendEntries(views, start + 45, start + 80);
+  const Trend actual = TrendDays(cache.days(), start + 45, start + 80);
+  ASSERT_EQ(actual.points.size(), expected.points.size());
+  for (size_t i = 0; i < actual.points.size(); ++i) {
+    EXPECT_EQ(actual.points[i].day, expected.points[i].day);
+    EXPECT_EQ(actual.points[i].average30, expected.points[i].average30);
+    EXPECT_EQ(actual.points[i].stddev7, expected.points[i].stddev7);
+  }
+  EXPECT_EQ(actual.slope, expected.slope);
+}
+
+TEST(TrendTest, RejectsUnsortedEntries) {
+  Series series;
+  series.Add(ParseIsoDate("2026-01-02"), 10);
+  series.Add(ParseIsoDate("2026-01-01"), 20);
+  EXPECT_THROW(TrendEntries(series.Views(), kNoDays, kAllDays), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace life_tracker
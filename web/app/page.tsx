@@ -1,7 +1,10 @@
 "use client";
 
-import { useMemo, useState } from "react";
-import exportedData from "../data/entries.json";
+import { useEffect, useMemo, useState } from "react";
+
+// Written by `life dashboard` into public/data: a small manifest plus one shard per month, so the
+// page only downloads and parses the months the selected range needs.
+const DATA_URL = "/data";
 
 type Entry = {
   date: string; // YYYY-MM-DD
@@ -9,11 +12,33 @@ type Entry = {
   note: string;
 };
 
+// Rolling statistics for one day with entries, computed by the CLI; ma7/sd7 and ma30/sd30 cover
+// the trailing 7 and 30 days.
+type TrendPoint = {
+  date: string; // YYYY-MM-DD
+  count: number;
+  average: number;
+  ma7: number;
+  sd7: number;
+  ma30: number;
+  sd30: number;
+};
+
 type Summary = {
   has_data: boolean;
   count: number;
   average_mood: number;
   stddev: number;
+  // Absent from manifests written before distributions were added.
+  distribution?: {
+    median: number;
+    p10: number;
+    p25: number;
+    p75: number;
+    p90: number;
+    iqr: number;
+    mode: number;
+  } | null;
   best: { date: string; mood: number } | null;
   worst: { date: string; mood: number } | null;
 };
@@ -23,11 +48,21 @@ type Streak = {
   longest: number;
 };
 
-type ExportedData = {
+type Shard = {
+  month: string; // YYYY-MM
+  path: string; // Relative to DATA_URL; changes whenever the shard's contents do.
+  count: number;
+  first: string;
+  last: string;
+  bytes: number;
+  checksum: string;
+};
+
+type Manifest = {
   meta: { generated_at: string; days: number };
   summary: Summary;
   streak: Streak;
-  entries: Entry[];
+  shards: Shard[];
 };
 
 type RangeOption = {
@@ -46,14 +81,56 @@ function parseDate(dateStr: string): Date {
   return new Date(year, month - 1, day);
 }
 
-function filterEntries(entries: Entry[], selected: RangeOption): Entry[] {
+function rangeCutoff(selected: RangeOption): Date | null {
   if (selected.days === "all") {
-    return [...entries];
+    return null;
   }
   const now = new Date();
-  const cutoff = new Date(now);
-  cutoff.setDate(now.getDate() - (selected.days - 1));
-  return entries.filter((entry) => parseDate(entry.date) >= cutoff);
+  const cutoff = new Date(now.getFullYear(), now.getMonth(), now.getDate());
+  cutoff.setDate(cutoff.getDate() - (selected.days - 1));
+  return cutoff;
+}
+
+function shardsForRange(shards: Shard[], selected: RangeOption): Shard[] {
+  const cutoff = rangeCutoff(selected);
+  if (cutoff === null) {
+    return shards;
+  }
+  return shards.filter((shard) => parseDate(shard.last) >= cutoff);
+}
+
+function filterByDate<T extends { date: string }>(items: T[], selected: RangeOption): T[] {
+  const cutoff = rangeCutoff(selected);
+  if (cutoff === null) {
+    return items;
+  }
+  return items.filter((item) => parseDate(item.date) >= cutoff);
+}
+
+type ShardData = {
+  entries: Entry[];
+  trend: TrendPoint[];
+};
+
+// Shard paths name their contents, so a fetched shard never needs refetching.
+const shardCache = new Map<string, Promise<ShardData>>();
+
+function fetchShard(shard: Shard): Promise<ShardData> {
+  let pending = shardCache.get(shard.path);
+  if (!pending) {
+    pending = fetch(`${DATA_URL}/${shard.path}`)
+      .then((res) => {
+        if (!res.ok) {
+          throw new Error(`Failed to load ${shard.path}: ${res.status}`);
+        }
+        return res.json() as Promise<{ month: string; entries: Entry[]; trend?: TrendPoint[] }>;
+      })
+      // Shards written before moving averages were added have no trend.
+      .then((data) => ({ entries: data.entries, trend: data.trend ?? [] }));
+    pending.catch(() => shardCache.delete(shard.path));
+    shardCache.set(shard.path, pending);
+  }
+  return pending;
 }
 
 function formatDate(dateStr: string): string {
@@ -69,6 +146,12 @@ function SummaryCards({ summary, streak, days }: { summary: Summary; streak: Str
     { label: "Entries", value: summary.count.toString() },
     { label: "Avg mood", value: summary.has_data ? summary.average_mood.toFixed(1) : "—" },
     { label: "Volatility", value: summary.has_data ? summary.stddev.toFixed(1) : "—" },
+    {
+      label: "Median (IQR)",
+      value: summary.distribution
+        ? `${summary.distribution.median.toFixed(1)} (${summary.distribution.p25}–${summary.distribution.p75})`
+        : "—",
+    },
     { label: "Current streak", value: `${streak.current}d` },
     { label: "Longest streak", value: `${streak.longest}d` },
     {
@@ -94,7 +177,7 @@ function SummaryCards({ summary, streak, days }: { summary: Summary; streak: Str
   );
 }
 
-function Chart({ entries }: { entries: Entry[] }) {
+function Chart({ entries, trend }: { entries: Entry[]; trend: TrendPoint[] }) {
   if (entries.length === 0) {
     return <div className="panel muted">No data for this range yet.</div>;
   }
@@ -127,6 +210,14 @@ function Chart({ entries }: { entries: Entry[] }) {
     })
     .join(" ");
 
+  // The CLI computes the moving average; each day's point sits on that day's last entry.
+  const lastIndexByDate = new Map<string, number>();
+  sorted.forEach((entry, idx) => lastIndexByDate.set(entry.date, idx));
+  const trendPoints = trend
+    .filter((point) => lastIndexByDate.has(point.date))
+    .map((point) => `${pad + xStep * lastIndexByDate.get(point.date)!},${moodToY(point.ma7)}`)
+    .join(" ");
+
   return (
     <div className="panel">
       <div className="panel-head">
@@ -134,7 +225,7 @@ function Chart({ entries }: { entries: Entry[] }) {
           <p className="eyebrow">Mood trend</p>
           <h2 className="panel-title">Line chart</h2>
         </div>
-        <p className="hint">Scale: 1–100</p>
+        <p className="hint">Scale: 1–100 · orange: 7-day average</p>
       </div>
       <svg
         viewBox={`0 0 ${width} ${height}`}
@@ -157,6 +248,9 @@ function Chart({ entries }: { entries: Entry[] }) {
           strokeLinejoin="round"
           strokeLinecap="round"
         />
+        {trendPoints && (
+          <polyline points={trendPoints} fill="none" stroke="#f97316" strokeWidth="2" />
+        )}
         {sorted.map((entry, idx) => {
           const x = pad + xStep * idx;
           const y = moodToY(entry.mood);
@@ -225,12 +319,53 @@ function EntriesTable({ entries }: { entries: Entry[] }) {
 
 export default function Page() {
   const [selectedRange, setSelectedRange] = useState<RangeOption>(RANGE_OPTIONS[0]);
-  const data = useMemo(() => exportedData as ExportedData, []);
-  const entries = data.entries || [];
+  const [manifest, setManifest] = useState<Manifest | null>(null);
+  const [entries, setEntries] = useState<Entry[]>([]);
+  const [trend, setTrend] = useState<TrendPoint[]>([]);
+  const [error, setError] = useState<string | null>(null);
+
+  useEffect(() => {
+    fetch(`${DATA_URL}/manifest.json`, { cache: "no-store" })
+      .then((res) => {
+        if (!res.ok) {
+          throw new Error(`Failed to load manifest.json: ${res.status}`);
+        }
+        return res.json() as Promise<Manifest>;
+      })
+      .then(setManifest)
+      .catch((err: Error) => setError(err.message));
+  }, []);
+
+  useEffect(() => {
+    if (!manifest) {
+      return;
+    }
+    let cancelled = false;
+    Promise.all(shardsForRange(manifest.shards, selectedRange).map(fetchShard))
+      .then((months) => {
+        if (!cancelled) {
+          setEntries(([] as Entry[]).concat(...months.map((month) => month.entries)));
+          setTrend(([] as TrendPoint[]).concat(...months.map((month) => month.trend)));
+        }
+      })
+      .catch((err: Error) => {
+        if (!cancelled) {
+          setError(err.message);
+        }
+      });
+    return () => {
+      cancelled = true;
+    };
+  }, [manifest, selectedRange]);
+
   const filtered = useMemo(
-    () => filterEntries(entries, selectedRange),
+    () => filterByDate(entries, selectedRange),
     [entries, selectedRange],
   );
+  const filteredTrend = useMemo(
+    () => filterByDate(trend, selectedRange),
+    [trend, selectedRange],
+  );
 
   return (
     <main className="page">
@@ -257,10 +392,17 @@ export default function Page() {
         </div>
       </header>
 
-      <SummaryCards summary={data.summary} streak={data.streak} days={data.meta.days} />
+      {error && <div className="panel muted">{error}. Run `life dashboard` to export data.</div>}
+      {manifest && (
+        <SummaryCards
+          summary={manifest.summary}
+          streak={manifest.streak}
+          days={manifest.meta.days}
+        />
+      )}
 
       <div className="grid">
-        <Chart entries={filtered} />
+        <Chart entries={filtered} trend={filteredTrend} />
         <EntriesTable entries={filtered} />
       </div>
     </main>